@@ -0,0 +1,570 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libraCore.h>
+
+// ===================================================================================================================
+// Timing
+// ===================================================================================================================
+
+static double Benchmark_Seconds(const uint64 start, const uint64 end) {
+    return (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+static void Benchmark_Report(const char *name, const double seconds, const size_t bytes, const uint64 operations) {
+    printf("%-48s %10.3f ms %10.2f GB/s %12.3f Mops/s\n", name, seconds * 1000.0,
+           (double)bytes / seconds / 1e9, (double)operations / seconds / 1e6);
+}
+
+// ===================================================================================================================
+// Strings and String Operations
+// ===================================================================================================================
+
+static void Benchmark_Strings(void) {
+    constexpr size_t totalBytes = 256 * 1024 * 1024;
+    const size_t stringLengths[] = {8, 24, 64, 256, 4 * 1024, 1024 * 1024};
+
+    char *text = malloc(1024 * 1024 + 64);
+    char *copy = malloc(1024 * 1024 + 64);
+    if (text == NULL || copy == NULL) return;
+
+    for (size_t s = 0; s < sizeof(stringLengths) / sizeof(stringLengths[0]); s++) {
+        const size_t length = stringLengths[s];
+        const uint64 count = totalBytes / length;
+        // a tail that occurs nowhere else, so the substring search has to scan the whole string
+        const size_t tailStart = length - 7;
+        for (size_t i = 0; i < length; i++) text[i] = i < tailStart ? (char)('a' + i % 26) : "#UNIQUE"[i - tailStart];
+        text[length] = '\0';
+        memcpy(copy, text, length + 1);
+        LC_String string = {(uint32)length, text};
+        LC_String other = {(uint32)length, copy};
+        char name[64];
+
+        printf("\n-- %zu byte strings --\n", length);
+
+        volatile size_t sink = 0;
+        uint64 start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) sink += strlen(text + (i & 1));
+        uint64 end = SDL_GetPerformanceCounter();
+        Benchmark_Report("strlen", Benchmark_Seconds(start, end), count * length, count);
+
+        start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) sink += LC_CString_GetLength(text + (i & 1));
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_CString_GetLength", Benchmark_Seconds(start, end), count * length, count);
+
+        start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) sink += LC_String_IsEqual(&string, &other);
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_String_IsEqual", Benchmark_Seconds(start, end), count * length, count);
+
+        start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) sink += LC_String_IsEqualCString(&string, copy);
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_String_IsEqualCString", Benchmark_Seconds(start, end), count * length, count);
+
+        start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) sink += LC_String_FindByte(&string, '@');
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_String_FindByte (missing)", Benchmark_Seconds(start, end), count * length, count);
+
+        start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) sink += LC_String_CountByte(&string, 'e');
+        end = SDL_GetPerformanceCounter();
+        snprintf(name, sizeof(name), "LC_String_CountByte (%u)", LC_String_CountByte(&string, 'e'));
+        Benchmark_Report(name, Benchmark_Seconds(start, end), count * length, count);
+
+        const LC_String needle = {7, text + length - 7};
+        start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) sink += LC_String_Find(&string, &needle);
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_String_Find (match at end)", Benchmark_Seconds(start, end), count * length, count);
+
+        start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) sink += strstr(text, needle.data) - text;
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("strstr (match at end)", Benchmark_Seconds(start, end), count * length, count);
+        (void)sink;
+    }
+
+    free(text);
+    free(copy);
+}
+
+// ===================================================================================================================
+// Memory Allocations
+// ===================================================================================================================
+
+static void Benchmark_ArenaZeroing(void) {
+    constexpr size_t arenaSize = 256 * 1024 * 1024;
+    constexpr int32 rounds = 8;
+    const size_t allocationSizes[] = {16, 256, 4 * 1024, 512 * 512, 4 * 1024 * 1024};
+
+    uchar *backingBuffer = malloc(arenaSize);
+    if (backingBuffer == NULL) return;
+    // fault in every page once so the first measured run does not pay for it
+    memset(backingBuffer, 1, arenaSize);
+
+    LC_Arena arena;
+    LC_Arena_Initialize(&arena, backingBuffer, arenaSize);
+
+    printf("\n-- Arena allocation, zeroing vs non-zeroing --\n");
+    for (size_t s = 0; s < sizeof(allocationSizes) / sizeof(allocationSizes[0]); s++) {
+        const size_t size = allocationSizes[s];
+        const uint64 allocationsPerRound = arenaSize / size;
+        char name[64];
+
+        for (int32 zero = 1; zero >= 0; zero--) {
+            const uint64 start = SDL_GetPerformanceCounter();
+            for (int32 round = 0; round < rounds; round++) {
+                for (uint64 i = 0; i < allocationsPerRound; i++) {
+                    void *memory = zero ? LC_Arena_Allocate(&arena, size) : LC_Arena_AllocateNoZero(&arena, size);
+                    // keep the allocation observable so the loop is not optimized away
+                    ((volatile uchar *)memory)[0] = 1;
+                }
+                LC_Arena_FreeAll(&arena);
+            }
+            const uint64 end = SDL_GetPerformanceCounter();
+
+            snprintf(name, sizeof(name), "%s %zu bytes", zero ? "Allocate" : "AllocateNoZero", size);
+            Benchmark_Report(name, Benchmark_Seconds(start, end), arenaSize * rounds, allocationsPerRound * rounds);
+        }
+    }
+
+    free(backingBuffer);
+}
+
+// ===================================================================================================================
+// Hashing
+// ===================================================================================================================
+
+static void Benchmark_Hashing(void) {
+    constexpr size_t totalBytes = 512 * 1024 * 1024;
+    const size_t inputSizes[] = {8, 16, 64, 256, 4 * 1024, 1024 * 1024, 64 * 1024 * 1024};
+    constexpr size_t bufferSize = 64 * 1024 * 1024;
+
+    uchar *buffer = malloc(bufferSize);
+    if (buffer == NULL) return;
+    for (size_t i = 0; i < bufferSize; i++) buffer[i] = (uchar)(i * 2654435761u >> 13);
+
+    printf("\n-- Hashing byte ranges --\n");
+    for (size_t s = 0; s < sizeof(inputSizes) / sizeof(inputSizes[0]); s++) {
+        const size_t size = inputSizes[s];
+        const uint64 count = totalBytes / size;
+        const size_t stride = bufferSize / size;
+        char name[64];
+
+        uint64 sink = 0;
+        uint64 start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) {
+            sink ^= LC_Hash_Bytes64(buffer + (i % stride) * size, size, i);
+        }
+        uint64 end = SDL_GetPerformanceCounter();
+        snprintf(name, sizeof(name), "LC_Hash_Bytes64 %zu bytes (%04x)", size, (uint32)sink & 0xFFFF);
+        Benchmark_Report(name, Benchmark_Seconds(start, end), count * size, count);
+
+        start = SDL_GetPerformanceCounter();
+        for (uint64 i = 0; i < count; i++) {
+            const LC_Hash128 hash = LC_Hash_Bytes128(buffer + (i % stride) * size, size, i);
+            sink ^= hash.low ^ hash.high;
+        }
+        end = SDL_GetPerformanceCounter();
+        snprintf(name, sizeof(name), "LC_Hash_Bytes128 %zu bytes (%04x)", size, (uint32)sink & 0xFFFF);
+        Benchmark_Report(name, Benchmark_Seconds(start, end), count * size, count);
+    }
+
+    printf("\n-- Streaming 64 MB in 4 KB pieces --\n");
+    LC_HashStream stream;
+    uint64 start = SDL_GetPerformanceCounter();
+    LC_HashStream_Initialize(&stream, 0, false);
+    for (size_t offset = 0; offset < bufferSize; offset += 4096) {
+        LC_HashStream_Update(&stream, buffer + offset, 4096);
+    }
+    uint64 end = SDL_GetPerformanceCounter();
+    const bool matches = LC_HashStream_Finish64(&stream) == LC_Hash_Bytes64(buffer, bufferSize, 0);
+    Benchmark_Report(matches ? "LC_HashStream_Update (matches one shot)" : "LC_HashStream_Update (MISMATCH)",
+                     Benchmark_Seconds(start, end), bufferSize, bufferSize / 4096);
+
+    printf("\n-- Hashing integer keys --\n");
+    const size_t keyCount = bufferSize / sizeof(uint64);
+    const uint64 *keys = (const uint64 *)buffer;
+    uint64 *hashes = malloc(keyCount * sizeof(uint64));
+    if (hashes != NULL) {
+        start = SDL_GetPerformanceCounter();
+        for (size_t i = 0; i < keyCount; i++) {
+            hashes[i] = LC_Hash_U64(keys[i], 7);
+        }
+        end = SDL_GetPerformanceCounter();
+        const uint64 scalarLast = hashes[keyCount - 1];
+        Benchmark_Report("LC_Hash_U64 loop", Benchmark_Seconds(start, end), bufferSize, keyCount);
+
+        start = SDL_GetPerformanceCounter();
+        LC_Hash_BatchU64(keys, hashes, keyCount, 7);
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report(hashes[keyCount - 1] == scalarLast ? "LC_Hash_BatchU64" : "LC_Hash_BatchU64 (MISMATCH)",
+                         Benchmark_Seconds(start, end), bufferSize, keyCount);
+        free(hashes);
+    }
+
+    free(buffer);
+}
+
+// ===================================================================================================================
+// Data Structures
+// ===================================================================================================================
+LC_DEFINE_LIST(int32)
+
+static void Benchmark_ListAppend(void) {
+    constexpr uint32 count = 10 * 1000 * 1000;
+    char name[64];
+
+    printf("\n-- Appending %u int32 --\n", count);
+
+    uint64 start = SDL_GetPerformanceCounter();
+    LC_List genericList;
+    LC_List_Initialize(&genericList, sizeof(int32));
+    for (int32 i = 0; i < (int32)count; i++) {
+        LC_List_AddElement(&genericList, &i);
+    }
+    uint64 end = SDL_GetPerformanceCounter();
+    snprintf(name, sizeof(name), "LC_List_AddElement (last %d)", *(int32 *)LC_List_GetElement(&genericList, count - 1));
+    Benchmark_Report(name, Benchmark_Seconds(start, end), count * sizeof(int32), count);
+    LC_List_Destroy(&genericList);
+
+    start = SDL_GetPerformanceCounter();
+    LC_List_int32 typedList;
+    LC_List_int32_Initialize(&typedList, LC_Allocator_Malloc());
+    for (int32 i = 0; i < (int32)count; i++) {
+        LC_List_int32_Append(&typedList, i);
+    }
+    end = SDL_GetPerformanceCounter();
+    snprintf(name, sizeof(name), "LC_List_int32_Append (last %d)", typedList.data[count - 1]);
+    Benchmark_Report(name, Benchmark_Seconds(start, end), count * sizeof(int32), count);
+    LC_List_int32_Destroy(&typedList);
+
+    start = SDL_GetPerformanceCounter();
+    LC_List_int32_Initialize(&typedList, LC_Allocator_Malloc());
+    LC_List_int32_Reserve(&typedList, count);
+    for (int32 i = 0; i < (int32)count; i++) {
+        LC_List_int32_Append(&typedList, i);
+    }
+    end = SDL_GetPerformanceCounter();
+    snprintf(name, sizeof(name), "LC_List_int32_Append reserved (last %d)", typedList.data[count - 1]);
+    Benchmark_Report(name, Benchmark_Seconds(start, end), count * sizeof(int32), count);
+    LC_List_int32_Destroy(&typedList);
+
+    int32 chunk[1024];
+    for (int32 i = 0; i < 1024; i++) chunk[i] = i;
+    start = SDL_GetPerformanceCounter();
+    LC_List_int32_Initialize(&typedList, LC_Allocator_Malloc());
+    for (uint32 appended = 0; appended < count; appended += 1024) {
+        LC_List_int32_AppendN(&typedList, chunk, count - appended < 1024 ? count - appended : 1024);
+    }
+    end = SDL_GetPerformanceCounter();
+    snprintf(name, sizeof(name), "LC_List_int32_AppendN x1024 (length %u)", typedList.length);
+    Benchmark_Report(name, Benchmark_Seconds(start, end), count * sizeof(int32), count);
+    LC_List_int32_Destroy(&typedList);
+}
+
+// Producers push the numbers [0, count), consumers pop 'count' elements each and sum them up so the work can't be
+// optimized away. Both sides move 'batchSize' elements per call.
+typedef struct {
+    void *queue;
+    bool isMpmc;
+    uint64 count;
+    uint32 batchSize;
+    uint64 sum;
+} Benchmark_QueueWork;
+
+static int Benchmark_QueueProducer(void *data) {
+    Benchmark_QueueWork *work = data;
+    uint64 batch[64];
+    for (uint64 next = 0; next < work->count;) {
+        uint32 batchCount = 0;
+        while (batchCount < work->batchSize && next + batchCount < work->count) {
+            batch[batchCount] = next + batchCount;
+            batchCount++;
+        }
+        const uint32 count = work->isMpmc ? LC_MpmcQueue_PushBatch(work->queue, batch, batchCount)
+                                          : LC_SpscRing_PushBatch(work->queue, batch, batchCount);
+        // A full queue gives the time slice to the consumers, which matters when there are fewer cores than threads
+        if (count == 0) SDL_Delay(0);
+        next += count;
+    }
+    return 0;
+}
+
+static int Benchmark_QueueConsumer(void *data) {
+    Benchmark_QueueWork *work = data;
+    uint64 batch[64];
+    for (uint64 popped = 0; popped < work->count;) {
+        const uint64 left = work->count - popped;
+        const uint32 wanted = left < work->batchSize ? (uint32)left : work->batchSize;
+        const uint32 count = work->isMpmc ? LC_MpmcQueue_PopBatch(work->queue, batch, wanted)
+                                          : LC_SpscRing_PopBatch(work->queue, batch, wanted);
+        if (count == 0) SDL_Delay(0);
+        for (uint32 i = 0; i < count; i++) work->sum += batch[i];
+        popped += count;
+    }
+    return 0;
+}
+
+static void Benchmark_RunQueue(const char *name, void *queue, const bool isMpmc, const uint32 threadPairs,
+                               const uint64 countPerThread, const uint32 batchSize) {
+    Benchmark_QueueWork work[2 * 8];
+    SDL_Thread *threads[2 * 8];
+    const uint64 start = SDL_GetPerformanceCounter();
+    for (uint32 i = 0; i < 2 * threadPairs; i++) {
+        work[i] = (Benchmark_QueueWork){queue, isMpmc, countPerThread, batchSize, 0};
+        threads[i] = SDL_CreateThread(i % 2 == 0 ? Benchmark_QueueProducer : Benchmark_QueueConsumer, name, &work[i]);
+    }
+    uint64 sum = 0;
+    for (uint32 i = 0; i < 2 * threadPairs; i++) {
+        SDL_WaitThread(threads[i], NULL);
+        sum += work[i].sum;
+    }
+    const uint64 end = SDL_GetPerformanceCounter();
+
+    const uint64 total = countPerThread * threadPairs;
+    char label[64];
+    snprintf(label, sizeof(label), "%s (sum %s)", name,
+             sum == threadPairs * (countPerThread * (countPerThread - 1) / 2) ? "ok" : "WRONG");
+    Benchmark_Report(label, Benchmark_Seconds(start, end), total * sizeof(uint64), total);
+}
+
+static void Benchmark_Queues(void) {
+    constexpr uint64 count = 10 * 1000 * 1000;
+    LC_Arena arena;
+    LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024);
+
+    printf("\n-- Passing %llu uint64 between threads --\n", (unsigned long long)count);
+
+    LC_SpscRing ring;
+    LC_SpscRing_Initialize(&ring, &arena, 4096, sizeof(uint64));
+    Benchmark_RunQueue("LC_SpscRing 1P/1C", &ring, false, 1, count, 1);
+    Benchmark_RunQueue("LC_SpscRing 1P/1C batch 64", &ring, false, 1, count, 64);
+
+    LC_MpmcQueue queue;
+    LC_MpmcQueue_Initialize(&queue, &arena, 4096, sizeof(uint64));
+    Benchmark_RunQueue("LC_MpmcQueue 1P/1C", &queue, true, 1, count, 1);
+    Benchmark_RunQueue("LC_MpmcQueue 1P/1C batch 64", &queue, true, 1, count, 64);
+    Benchmark_RunQueue("LC_MpmcQueue 4P/4C", &queue, true, 4, count / 4, 1);
+    Benchmark_RunQueue("LC_MpmcQueue 4P/4C batch 64", &queue, true, 4, count / 4, 64);
+
+    LC_Arena_Destroy(&arena);
+}
+
+// ===================================================================================================================
+// Sorting Algorithms
+// ===================================================================================================================
+
+static void Benchmark_FillIntegers(int32 *array, const int32 length, const int pattern) {
+    uint32 state = 2463534242u;
+    for (int32 i = 0; i < length; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        switch (pattern) {
+            case 0: array[i] = (int32)state; break;
+            case 1: array[i] = i; break;
+            case 2: array[i] = length - i; break;
+            default: array[i] = (int32)(state % 16); break;
+        }
+    }
+}
+
+static void Benchmark_SortIntegers(void) {
+    constexpr int32 length = 200 * 1000;
+    const char *patterns[] = {"random", "sorted", "reversed", "16 unique"};
+
+    int32 *array = malloc(length * sizeof(int32));
+    if (array == NULL) return;
+
+    printf("\n-- Sorting %d int32 --\n", length);
+
+    char name[64];
+    for (int p = 0; p < 4; p++) {
+        Benchmark_FillIntegers(array, length, p);
+        uint64 start = SDL_GetPerformanceCounter();
+        LC_QuickSortIntegers(array, length);
+        uint64 end = SDL_GetPerformanceCounter();
+        snprintf(name, sizeof(name), "LC_QuickSortIntegers %s", patterns[p]);
+        Benchmark_Report(name, Benchmark_Seconds(start, end), length * sizeof(int32), length);
+
+        Benchmark_FillIntegers(array, length, p);
+        start = SDL_GetPerformanceCounter();
+        LC_QuickSortIntegersRecursive(array, 0, length - 1);
+        end = SDL_GetPerformanceCounter();
+        snprintf(name, sizeof(name), "LC_QuickSortIntegersRecursive %s", patterns[p]);
+        Benchmark_Report(name, Benchmark_Seconds(start, end), length * sizeof(int32), length);
+
+        Benchmark_FillIntegers(array, length, p);
+        start = SDL_GetPerformanceCounter();
+        LC_MergeSortIntegers(array, length);
+        end = SDL_GetPerformanceCounter();
+        snprintf(name, sizeof(name), "LC_MergeSortIntegers %s", patterns[p]);
+        Benchmark_Report(name, Benchmark_Seconds(start, end), length * sizeof(int32), length);
+    }
+
+    free(array);
+}
+
+// Random keys from 1M to 100M elements, the comparison sorts against the radix sorts
+static void Benchmark_RadixSort(void) {
+    const uint32 lengths[] = {1000 * 1000, 10 * 1000 * 1000, 100 * 1000 * 1000};
+    constexpr uint32 maximumLength = 100 * 1000 * 1000;
+
+    int32 *keys = malloc(maximumLength * sizeof(int32));
+    uint64 *wideKeys = malloc(maximumLength * sizeof(uint64));
+    uint32 *values = malloc(maximumLength * sizeof(uint32));
+    LC_Arena arena;
+    LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024);
+    LC_JobSystem system;
+    if (keys == NULL || wideKeys == NULL || values == NULL || !LC_JobSystem_Initialize(&system, &arena, 0, false)) {
+        free(keys);
+        free(wideKeys);
+        free(values);
+        LC_Arena_Destroy(&arena);
+        return;
+    }
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        const uint32 length = lengths[l];
+        printf("\n-- Sorting %u random keys, %u threads for the parallel sorts --\n", length,
+               LC_JobSystem_GetThreadCount(&system));
+
+        Benchmark_FillIntegers(keys, (int32)length, 0);
+        uint64 start = SDL_GetPerformanceCounter();
+        LC_QuickSortIntegers(keys, (int32)length);
+        uint64 end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_QuickSortIntegers int32", Benchmark_Seconds(start, end), length * sizeof(int32), length);
+
+        Benchmark_FillIntegers(keys, (int32)length, 0);
+        start = SDL_GetPerformanceCounter();
+        LC_MergeSortIntegers(keys, length);
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_MergeSortIntegers int32", Benchmark_Seconds(start, end), length * sizeof(int32), length);
+
+        Benchmark_FillIntegers(keys, (int32)length, 0);
+        start = SDL_GetPerformanceCounter();
+        LC_RadixSortI32(keys, NULL, length);
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_RadixSortI32", Benchmark_Seconds(start, end), length * sizeof(int32), length);
+
+        Benchmark_FillIntegers(keys, (int32)length, 0);
+        start = SDL_GetPerformanceCounter();
+        LC_RadixSortI32Parallel(&system, keys, NULL, length);
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_RadixSortI32Parallel", Benchmark_Seconds(start, end), length * sizeof(int32), length);
+
+        // 64 bit keys with an index payload, the shape of sorting records by timestamp
+        Benchmark_FillIntegers(keys, (int32)length, 0);
+        for (uint32 i = 0; i < length; i++) {
+            wideKeys[i] = (uint64)(uint32)keys[i] << 20 ^ i;
+            values[i] = i;
+        }
+        start = SDL_GetPerformanceCounter();
+        LC_RadixSortU64(wideKeys, values, length);
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_RadixSortU64 with payload", Benchmark_Seconds(start, end),
+                         length * (sizeof(uint64) + sizeof(uint32)), length);
+
+        Benchmark_FillIntegers(keys, (int32)length, 0);
+        for (uint32 i = 0; i < length; i++) {
+            wideKeys[i] = (uint64)(uint32)keys[i] << 20 ^ i;
+            values[i] = i;
+        }
+        start = SDL_GetPerformanceCounter();
+        LC_RadixSortU64Parallel(&system, wideKeys, values, length);
+        end = SDL_GetPerformanceCounter();
+        Benchmark_Report("LC_RadixSortU64Parallel with payload", Benchmark_Seconds(start, end),
+                         length * (sizeof(uint64) + sizeof(uint32)), length);
+    }
+
+    LC_JobSystem_Destroy(&system);
+    LC_Arena_Destroy(&arena);
+    LC_Scratch_ReleaseThreadArenas();
+    free(keys);
+    free(wideKeys);
+    free(values);
+}
+
+typedef struct {
+    float depth;
+    uint32 id;
+    uint64 payload;
+} Benchmark_DrawRecord;
+
+LC_DEFINE_SORT(Benchmark_DrawRecord, Benchmark_DrawRecords, a->depth < b->depth)
+
+static int Benchmark_CompareDrawRecords(const void *a, const void *b) {
+    const float depthA = ((const Benchmark_DrawRecord *)a)->depth;
+    const float depthB = ((const Benchmark_DrawRecord *)b)->depth;
+    return (depthA > depthB) - (depthA < depthB);
+}
+
+static void Benchmark_SortStructs(void) {
+    constexpr size_t length = 1000 * 1000;
+    const char *patterns[] = {"random", "sorted", "reversed", "16 unique"};
+
+    Benchmark_DrawRecord *records = malloc(length * sizeof(Benchmark_DrawRecord));
+    int32 *depths = malloc(length * sizeof(int32));
+    if (records == NULL || depths == NULL) {
+        free(records);
+        free(depths);
+        return;
+    }
+
+    printf("\n-- Sorting %zu 16 byte records by depth --\n", length);
+
+    char name[64];
+    for (int p = 0; p < 4; p++) {
+        Benchmark_FillIntegers(depths, (int32)length, p);
+        for (size_t i = 0; i < length; i++) records[i] = (Benchmark_DrawRecord){(float)depths[i], (uint32)i, i};
+        uint64 start = SDL_GetPerformanceCounter();
+        qsort(records, length, sizeof(Benchmark_DrawRecord), Benchmark_CompareDrawRecords);
+        uint64 end = SDL_GetPerformanceCounter();
+        snprintf(name, sizeof(name), "qsort %s", patterns[p]);
+        Benchmark_Report(name, Benchmark_Seconds(start, end), length * sizeof(Benchmark_DrawRecord), length);
+
+        for (size_t i = 0; i < length; i++) records[i] = (Benchmark_DrawRecord){(float)depths[i], (uint32)i, i};
+        start = SDL_GetPerformanceCounter();
+        Benchmark_DrawRecords_Sort(records, length);
+        end = SDL_GetPerformanceCounter();
+        snprintf(name, sizeof(name), "LC_DEFINE_SORT %s", patterns[p]);
+        Benchmark_Report(name, Benchmark_Seconds(start, end), length * sizeof(Benchmark_DrawRecord), length);
+    }
+
+    // Selecting the 1000 nearest records and the median instead of sorting everything
+    Benchmark_FillIntegers(depths, (int32)length, 0);
+    for (size_t i = 0; i < length; i++) records[i] = (Benchmark_DrawRecord){(float)depths[i], (uint32)i, i};
+    uint64 start = SDL_GetPerformanceCounter();
+    Benchmark_DrawRecords_PartialSort(records, length, 1000);
+    uint64 end = SDL_GetPerformanceCounter();
+    Benchmark_Report("LC_DEFINE_SORT PartialSort 1000", Benchmark_Seconds(start, end),
+                     length * sizeof(Benchmark_DrawRecord), length);
+
+    for (size_t i = 0; i < length; i++) records[i] = (Benchmark_DrawRecord){(float)depths[i], (uint32)i, i};
+    start = SDL_GetPerformanceCounter();
+    Benchmark_DrawRecords_NthElement(records, length, length / 2);
+    end = SDL_GetPerformanceCounter();
+    Benchmark_Report("LC_DEFINE_SORT NthElement median", Benchmark_Seconds(start, end),
+                     length * sizeof(Benchmark_DrawRecord), length);
+
+    free(records);
+    free(depths);
+}
+
+int main(void) {
+    Benchmark_Strings();
+    Benchmark_ArenaZeroing();
+    Benchmark_Hashing();
+    Benchmark_ListAppend();
+    Benchmark_Queues();
+    Benchmark_SortIntegers();
+    Benchmark_RadixSort();
+    Benchmark_SortStructs();
+
+    return 0;
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec4 vColor;
+in vec2 vTexCoords;
+
+out vec4 FragColor;
+
+uniform sampler2D spriteTexture;
+
+void main()
+{
+    FragColor = texture(spriteTexture, vTexCoords) * vColor;
+}
@@ -0,0 +1,26 @@
+#version 330 core
+
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec4 aRect;
+layout (location = 2) in float aRotation;
+layout (location = 3) in vec4 aColor;
+layout (location = 4) in vec4 aTextureRect;
+
+out vec4 vColor;
+out vec2 vTexCoords;
+
+uniform mat4 viewProjectionMatrix;
+
+void main()
+{
+    // Scale the unit quad to the rectangle, rotate it around its center and move it into place
+    vec2 halfSize = 0.5 * aRect.zw;
+    vec2 local = (aPos * 2.0 - 1.0) * halfSize;
+    float s = sin(aRotation);
+    float c = cos(aRotation);
+    vec2 rotated = vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+    gl_Position = viewProjectionMatrix * vec4(aRect.xy + halfSize + rotated, 0.0, 1.0f);
+    // The color arrives normalized already, unlike the one of default.vert
+    vColor = aColor;
+    vTexCoords = mix(aTextureRect.xy, aTextureRect.zw, aPos);
+}
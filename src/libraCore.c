@@ -1,10 +1,18 @@
 ﻿#include <libraCore.h>
 
+#include <errno.h>
+#include <stdarg.h>
+#include <stdatomic.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+
+#if (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))) && defined(__GNUC__)
+#define LC_X86_SIMD 1
+#include <immintrin.h>
+#endif
 
 #ifdef _WIN32
 #include "windows/libraC-windows.h"
@@ -12,306 +20,3902 @@
 #include "linux//libraC-linux.h"
 #endif
 
-// ===================================================================================================================
-// Strings and String Operations
-// ===================================================================================================================
+// ===================================================================================================================
+// Strings and String Operations
+// ===================================================================================================================
+
+// The kernels work on 32 bytes at a time with AVX2 when the CPU has it and on 16 bytes with SSE2 otherwise. Ranges of
+// at least one vector finish with a load that overlaps the previous one instead of a scalar tail, only shorter ones
+// and non-x86 targets take the scalar loops. The C string length scan is the one kernel that reads past the end of
+// its input, with aligned loads that can't cross into the next page.
+#ifdef LC_X86_SIMD
+#define LC_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+
+static bool LC_HasAVX2(void) {
+    return __builtin_cpu_supports("avx2");
+}
+
+static size_t LC_CString_ClampLength(const size_t length, const size_t maximum) {
+    return length < maximum ? length : maximum;
+}
+
+LC_NO_SANITIZE_ADDRESS
+static size_t LC_CString_GetLengthSSE2(const char *cString, const size_t maximum) {
+    const __m128i zero = _mm_setzero_si128();
+    const size_t misalignment = (uintptr_t) cString & 15;
+    const char *block = cString - misalignment;
+    uint32 mask = (uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *) block), zero));
+    mask >>= misalignment;
+    if (mask != 0) return LC_CString_ClampLength((size_t) __builtin_ctz(mask), maximum);
+
+    // One vector at a time up to a 64 byte boundary, then four per iteration
+    for (block += 16; ((uintptr_t) block & 63) != 0; block += 16) {
+        if ((size_t) (block - cString) >= maximum) return maximum;
+        mask = (uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *) block), zero));
+        if (mask != 0) return LC_CString_ClampLength((size_t) (block - cString) + __builtin_ctz(mask), maximum);
+    }
+    for (;; block += 64) {
+        if ((size_t) (block - cString) >= maximum) return maximum;
+        const __m128i *vectors = (const __m128i *) block;
+        const __m128i minimum = _mm_min_epu8(_mm_min_epu8(_mm_load_si128(vectors), _mm_load_si128(vectors + 1)),
+                                             _mm_min_epu8(_mm_load_si128(vectors + 2), _mm_load_si128(vectors + 3)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(minimum, zero)) == 0) continue;
+
+        for (uint32 i = 0; i < 4; i++) {
+            mask = (uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(vectors + i), zero));
+            if (mask != 0) {
+                return LC_CString_ClampLength((size_t) (block - cString) + i * 16 + __builtin_ctz(mask), maximum);
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2"))) LC_NO_SANITIZE_ADDRESS
+static size_t LC_CString_GetLengthAVX2(const char *cString, const size_t maximum) {
+    const __m256i zero = _mm256_setzero_si256();
+    const size_t misalignment = (uintptr_t) cString & 31;
+    const char *block = cString - misalignment;
+    uint32 mask = (uint32) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *) block), zero));
+    mask >>= misalignment;
+    if (mask != 0) return LC_CString_ClampLength((size_t) __builtin_ctz(mask), maximum);
+
+    for (block += 32; ((uintptr_t) block & 127) != 0; block += 32) {
+        if ((size_t) (block - cString) >= maximum) return maximum;
+        mask = (uint32) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *) block), zero));
+        if (mask != 0) return LC_CString_ClampLength((size_t) (block - cString) + __builtin_ctz(mask), maximum);
+    }
+    for (;; block += 128) {
+        if ((size_t) (block - cString) >= maximum) return maximum;
+        const __m256i *vectors = (const __m256i *) block;
+        const __m256i minimum = _mm256_min_epu8(
+            _mm256_min_epu8(_mm256_load_si256(vectors), _mm256_load_si256(vectors + 1)),
+            _mm256_min_epu8(_mm256_load_si256(vectors + 2), _mm256_load_si256(vectors + 3)));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(minimum, zero)) == 0) continue;
+
+        for (uint32 i = 0; i < 4; i++) {
+            mask = (uint32) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(vectors + i), zero));
+            if (mask != 0) {
+                return LC_CString_ClampLength((size_t) (block - cString) + i * 32 + __builtin_ctz(mask), maximum);
+            }
+        }
+    }
+}
+
+// Needs length >= 16
+static bool LC_Bytes_IsEqualSSE2(const uchar *a, const uchar *b, const size_t length) {
+    for (size_t i = 0; i + 16 <= length; i += 16) {
+        const __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (a + i)),
+                                             _mm_loadu_si128((const __m128i *) (b + i)));
+        if (_mm_movemask_epi8(equal) != 0xFFFF) return false;
+    }
+    const __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (a + length - 16)),
+                                         _mm_loadu_si128((const __m128i *) (b + length - 16)));
+    return _mm_movemask_epi8(equal) == 0xFFFF;
+}
+
+// Needs length >= 32
+__attribute__((target("avx2")))
+static bool LC_Bytes_IsEqualAVX2(const uchar *a, const uchar *b, const size_t length) {
+    for (size_t i = 0; i + 32 <= length; i += 32) {
+        const __m256i equal = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (a + i)),
+                                                _mm256_loadu_si256((const __m256i *) (b + i)));
+        if ((uint32) _mm256_movemask_epi8(equal) != 0xFFFFFFFFu) return false;
+    }
+    const __m256i equal = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (a + length - 32)),
+                                            _mm256_loadu_si256((const __m256i *) (b + length - 32)));
+    return (uint32) _mm256_movemask_epi8(equal) == 0xFFFFFFFFu;
+}
+
+// Needs length >= 16. The overlapping last load has the bits of the already searched bytes masked off.
+static size_t LC_Bytes_FindByteSSE2(const uchar *data, const size_t length, const uchar byte) {
+    const __m128i needle = _mm_set1_epi8((char) byte);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const uint32 mask = (uint32) _mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (data + i)), needle));
+        if (mask != 0) return i + (size_t) __builtin_ctz(mask);
+    }
+    if (i == length) return LC_NOT_FOUND;
+
+    const size_t last = length - 16;
+    const uint32 mask = (uint32) _mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (data + last)), needle)) >> (i - last);
+    return mask != 0 ? i + (size_t) __builtin_ctz(mask) : LC_NOT_FOUND;
+}
+
+// Needs length >= 32
+__attribute__((target("avx2")))
+static size_t LC_Bytes_FindByteAVX2(const uchar *data, const size_t length, const uchar byte) {
+    const __m256i needle = _mm256_set1_epi8((char) byte);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const uint32 mask = (uint32) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (data + i)), needle));
+        if (mask != 0) return i + (size_t) __builtin_ctz(mask);
+    }
+    if (i == length) return LC_NOT_FOUND;
+
+    const size_t last = length - 32;
+    const uint32 mask = (uint32) _mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (data + last)), needle)) >> (i - last);
+    return mask != 0 ? i + (size_t) __builtin_ctz(mask) : LC_NOT_FOUND;
+}
+
+// Needs length >= 16. Matches are counted by subtracting the all-ones compare result from byte counters, which are
+// summed into 64 bit lanes with a SAD before they can overflow.
+static size_t LC_Bytes_CountByteSSE2(const uchar *data, const size_t length, const uchar byte) {
+    const __m128i needle = _mm_set1_epi8((char) byte);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i total = zero;
+    size_t i = 0;
+    while (i + 16 <= length) {
+        __m128i counters = zero;
+        for (uint32 round = 0; round < 255 && i + 16 <= length; round++, i += 16) {
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (data + i)), needle));
+        }
+        total = _mm_add_epi64(total, _mm_sad_epu8(counters, zero));
+    }
+
+    uint64 lanes[2];
+    _mm_storeu_si128((__m128i *) lanes, total);
+    size_t count = (size_t) (lanes[0] + lanes[1]);
+    if (i < length) {
+        const size_t last = length - 16;
+        const uint32 mask = (uint32) _mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (data + last)), needle)) >> (i - last);
+        count += (size_t) __builtin_popcount(mask);
+    }
+    return count;
+}
+
+// Needs length >= 32
+__attribute__((target("avx2")))
+static size_t LC_Bytes_CountByteAVX2(const uchar *data, const size_t length, const uchar byte) {
+    const __m256i needle = _mm256_set1_epi8((char) byte);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i total = zero;
+    size_t i = 0;
+    while (i + 32 <= length) {
+        __m256i counters = zero;
+        for (uint32 round = 0; round < 255 && i + 32 <= length; round++, i += 32) {
+            counters = _mm256_sub_epi8(counters,
+                                       _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (data + i)), needle));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(counters, zero));
+    }
+
+    uint64 lanes[4];
+    _mm256_storeu_si256((__m256i *) lanes, total);
+    size_t count = (size_t) (lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    if (i < length) {
+        const size_t last = length - 32;
+        const uint32 mask = (uint32) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (data + last)), needle)) >> (i - last);
+        count += (size_t) __builtin_popcount(mask);
+    }
+    return count;
+}
+
+// Candidates are positions where both the first and the last byte of the needle match, only those are compared in
+// full. Needs 2 <= needleLength and haystackLength >= needleLength + 15.
+static size_t LC_Bytes_FindSSE2(const uchar *haystack, const size_t haystackLength, const uchar *needle,
+                                const size_t needleLength) {
+    const __m128i first = _mm_set1_epi8((char) needle[0]);
+    const __m128i last = _mm_set1_epi8((char) needle[needleLength - 1]);
+    const size_t positionCount = haystackLength - needleLength + 1;
+    for (size_t i = 0; i < positionCount; i += 16) {
+        // The last block is moved back to end at the last position, positions it repeats are masked off
+        const size_t start = i + 16 <= positionCount ? i : positionCount - 16;
+        const __m128i blockFirst = _mm_loadu_si128((const __m128i *) (haystack + start));
+        const __m128i blockLast = _mm_loadu_si128((const __m128i *) (haystack + start + needleLength - 1));
+        uint32 mask = (uint32) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first),
+                                                                _mm_cmpeq_epi8(blockLast, last))) >> (i - start);
+        while (mask != 0) {
+            const size_t candidate = i + (size_t) __builtin_ctz(mask);
+            if (memcmp(haystack + candidate + 1, needle + 1, needleLength - 2) == 0) return candidate;
+            mask &= mask - 1;
+        }
+    }
+    return LC_NOT_FOUND;
+}
+
+// Needs 2 <= needleLength and haystackLength >= needleLength + 31
+__attribute__((target("avx2")))
+static size_t LC_Bytes_FindAVX2(const uchar *haystack, const size_t haystackLength, const uchar *needle,
+                                const size_t needleLength) {
+    const __m256i first = _mm256_set1_epi8((char) needle[0]);
+    const __m256i last = _mm256_set1_epi8((char) needle[needleLength - 1]);
+    const size_t positionCount = haystackLength - needleLength + 1;
+    for (size_t i = 0; i < positionCount; i += 32) {
+        const size_t start = i + 32 <= positionCount ? i : positionCount - 32;
+        const __m256i blockFirst = _mm256_loadu_si256((const __m256i *) (haystack + start));
+        const __m256i blockLast = _mm256_loadu_si256((const __m256i *) (haystack + start + needleLength - 1));
+        uint32 mask = (uint32) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first),
+                                                                     _mm256_cmpeq_epi8(blockLast, last)));
+        mask >>= i - start;
+        while (mask != 0) {
+            const size_t candidate = i + (size_t) __builtin_ctz(mask);
+            if (memcmp(haystack + candidate + 1, needle + 1, needleLength - 2) == 0) return candidate;
+            mask &= mask - 1;
+        }
+    }
+    return LC_NOT_FOUND;
+}
+#endif
+
+size_t LC_CString_GetLengthBounded(const char *cString, const size_t maximum) {
+#ifdef LC_X86_SIMD
+    return LC_HasAVX2() ? LC_CString_GetLengthAVX2(cString, maximum) : LC_CString_GetLengthSSE2(cString, maximum);
+#else
+    size_t length = 0;
+    while (length < maximum && cString[length] != '\0') {
+        length++;
+    }
+    return length;
+#endif
+}
+
+size_t LC_CString_GetLength(const char *cString) {
+    return LC_CString_GetLengthBounded(cString, SIZE_MAX);
+}
+
+bool LC_Bytes_IsEqual(const void *a, const void *b, const size_t length) {
+    const uchar *aBytes = a;
+    const uchar *bBytes = b;
+#ifdef LC_X86_SIMD
+    if (length >= 32 && LC_HasAVX2()) return LC_Bytes_IsEqualAVX2(aBytes, bBytes, length);
+    if (length >= 16) return LC_Bytes_IsEqualSSE2(aBytes, bBytes, length);
+#endif
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64 aWord, bWord;
+        memcpy(&aWord, aBytes + i, sizeof(aWord));
+        memcpy(&bWord, bBytes + i, sizeof(bWord));
+        if (aWord != bWord) return false;
+    }
+    for (; i < length; i++) {
+        if (aBytes[i] != bBytes[i]) return false;
+    }
+    return true;
+}
+
+size_t LC_Bytes_FindByte(const void *data, const size_t length, const uchar byte) {
+    const uchar *bytes = data;
+#ifdef LC_X86_SIMD
+    if (length >= 32 && LC_HasAVX2()) return LC_Bytes_FindByteAVX2(bytes, length, byte);
+    if (length >= 16) return LC_Bytes_FindByteSSE2(bytes, length, byte);
+#endif
+    for (size_t i = 0; i < length; i++) {
+        if (bytes[i] == byte) return i;
+    }
+    return LC_NOT_FOUND;
+}
+
+size_t LC_Bytes_CountByte(const void *data, const size_t length, const uchar byte) {
+    const uchar *bytes = data;
+#ifdef LC_X86_SIMD
+    if (length >= 32 && LC_HasAVX2()) return LC_Bytes_CountByteAVX2(bytes, length, byte);
+    if (length >= 16) return LC_Bytes_CountByteSSE2(bytes, length, byte);
+#endif
+    size_t count = 0;
+    for (size_t i = 0; i < length; i++) {
+        count += bytes[i] == byte;
+    }
+    return count;
+}
+
+size_t LC_Bytes_Find(const void *haystack, const size_t haystackLength, const void *needle,
+                     const size_t needleLength) {
+    if (needleLength == 0) return 0;
+    if (needleLength > haystackLength) return LC_NOT_FOUND;
+    if (needleLength == 1) return LC_Bytes_FindByte(haystack, haystackLength, *(const uchar *) needle);
+
+    const uchar *haystackBytes = haystack;
+#ifdef LC_X86_SIMD
+    if (haystackLength >= needleLength + 31 && LC_HasAVX2()) {
+        return LC_Bytes_FindAVX2(haystackBytes, haystackLength, needle, needleLength);
+    }
+    if (haystackLength >= needleLength + 15) {
+        return LC_Bytes_FindSSE2(haystackBytes, haystackLength, needle, needleLength);
+    }
+#endif
+    for (size_t i = 0; i + needleLength <= haystackLength; i++) {
+        if (memcmp(haystackBytes + i, needle, needleLength) == 0) return i;
+    }
+    return LC_NOT_FOUND;
+}
+
+void LC_String_Initialize(LC_String *string, char *cString) {
+    string->length = (uint32) LC_CString_GetLength(cString);
+    string->data = cString;
+}
+
+void LC_String_InitializeByCopy(LC_Arena *arena, LC_String *string, const char *cString) {
+    const uint32 count = (uint32) LC_CString_GetLength(cString);
+
+    string->length = count;
+    string->data = LC_Arena_AllocateNoZero(arena, count + 1);
+    memcpy(string->data, cString, count + 1);
+}
+
+bool LC_String_IsEqualCString(const LC_String *string, const char *cString) {
+    // Scanning one byte past the string's length is enough to tell whether the lengths differ
+    const size_t cStringLength = LC_CString_GetLengthBounded(cString, (size_t) string->length + 1);
+    if (string->length != cStringLength) return false;
+
+    return LC_Bytes_IsEqual(string->data, cString, string->length);
+}
+
+bool LC_String_IsEqual(const LC_String *str1, const LC_String *str2) {
+    if (str1->length != str2->length) return false;
+
+    return LC_Bytes_IsEqual(str1->data, str2->data, str1->length);
+}
+
+uint32 LC_String_FindByte(const LC_String *string, const char byte) {
+    const size_t index = LC_Bytes_FindByte(string->data, string->length, (uchar) byte);
+    return index == LC_NOT_FOUND ? LC_STRING_NOT_FOUND : (uint32) index;
+}
+
+uint32 LC_String_Find(const LC_String *string, const LC_String *needle) {
+    const size_t index = LC_Bytes_Find(string->data, string->length, needle->data, needle->length);
+    return index == LC_NOT_FOUND ? LC_STRING_NOT_FOUND : (uint32) index;
+}
+
+uint32 LC_String_CountByte(const LC_String *string, const char byte) {
+    return (uint32) LC_Bytes_CountByte(string->data, string->length, (uchar) byte);
+}
+
+uint32 LC_GetStringLengthSkipSpaces(const char *string, const uint32 length) {
+    if (string == NULL) return 0;
+
+    return length - (uint32) LC_Bytes_CountByte(string, length, ' ');
+}
+
+// STRING VIEWS
+// An LC_String never owns its characters, so slicing, trimming and splitting only produce new {length, data} pairs
+// pointing into the original text. A view is not null terminated unless it happens to end where the source does.
+
+LC_String LC_String_Slice(const LC_String *string, uint32 start, uint32 end) {
+    if (end > string->length) end = string->length;
+    if (start > end) start = end;
+
+    LC_String slice;
+    slice.length = end - start;
+    slice.data = string->data + start;
+    return slice;
+}
+
+static bool LC_String_IsSpace(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+LC_String LC_String_TrimLeft(const LC_String *string) {
+    uint32 start = 0;
+    while (start < string->length && LC_String_IsSpace(string->data[start])) {
+        start++;
+    }
+    return LC_String_Slice(string, start, string->length);
+}
+
+LC_String LC_String_TrimRight(const LC_String *string) {
+    uint32 end = string->length;
+    while (end > 0 && LC_String_IsSpace(string->data[end - 1])) {
+        end--;
+    }
+    return LC_String_Slice(string, 0, end);
+}
+
+LC_String LC_String_Trim(const LC_String *string) {
+    const LC_String trimmed = LC_String_TrimLeft(string);
+    return LC_String_TrimRight(&trimmed);
+}
+
+bool LC_String_StartsWith(const LC_String *string, const LC_String *prefix) {
+    return prefix->length <= string->length && LC_Bytes_IsEqual(string->data, prefix->data, prefix->length);
+}
+
+bool LC_String_EndsWith(const LC_String *string, const LC_String *suffix) {
+    return suffix->length <= string->length &&
+           LC_Bytes_IsEqual(string->data + string->length - suffix->length, suffix->data, suffix->length);
+}
+
+bool LC_String_SplitOnce(const LC_String *string, const char delimiter, LC_String *before, LC_String *after) {
+    const uint32 index = LC_String_FindByte(string, delimiter);
+    if (index == LC_STRING_NOT_FOUND) return false;
+
+    *before = LC_String_Slice(string, 0, index);
+    *after = LC_String_Slice(string, index + 1, string->length);
+    return true;
+}
+
+void LC_StringSplitter_Initialize(LC_StringSplitter *splitter, const LC_String *string, const char delimiter) {
+    splitter->remaining = *string;
+    splitter->delimiter = delimiter;
+    splitter->isDone = false;
+}
+
+bool LC_StringSplitter_Next(LC_StringSplitter *splitter, LC_String *token) {
+    if (splitter->isDone) return false;
+
+    // Adjacent delimiters produce empty tokens, a string without delimiters is a single token
+    if (!LC_String_SplitOnce(&splitter->remaining, splitter->delimiter, token, &splitter->remaining)) {
+        *token = splitter->remaining;
+        splitter->isDone = true;
+    }
+    return true;
+}
+
+static int32 LC_String_GetDigitValue(const char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return 99;
+}
+
+bool LC_String_ParseInt64(const LC_String *string, int64 *value) {
+    const char *c = string->data;
+    const char *end = string->data + string->length;
+
+    const bool isNegative = c < end && *c == '-';
+    if (c < end && (*c == '-' || *c == '+')) c++;
+
+    uint64 base = 10;
+    if (end - c > 2 && c[0] == '0' && (c[1] == 'x' || c[1] == 'X')) {
+        base = 16;
+        c += 2;
+    }
+    if (c == end) return false;
+
+    const uint64 limit = isNegative ? (uint64) INT64_MAX + 1 : (uint64) INT64_MAX;
+    uint64 magnitude = 0;
+    for (; c < end; c++) {
+        const uint64 digit = (uint64) LC_String_GetDigitValue(*c);
+        if (digit >= base) return false;
+        if (magnitude > (limit - digit) / base) return false;
+        magnitude = magnitude * base + digit;
+    }
+
+    *value = isNegative ? (int64) (0 - magnitude) : (int64) magnitude;
+    return true;
+}
+
+bool LC_String_ParseInt32(const LC_String *string, int32 *value) {
+    int64 wide;
+    if (!LC_String_ParseInt64(string, &wide) || wide < INT32_MIN || wide > INT32_MAX) return false;
+
+    *value = (int32) wide;
+    return true;
+}
+
+static constexpr double STRING_POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static constexpr uint32 STRING_MAX_FLOAT_LENGTH = 128;
+
+bool LC_String_ParseDouble(const LC_String *string, double *value) {
+    const char *c = string->data;
+    const char *end = string->data + string->length;
+
+    const bool isNegative = c < end && *c == '-';
+    if (c < end && (*c == '-' || *c == '+')) c++;
+
+    uint64 mantissa = 0;
+    int32 digitCount = 0;
+    int32 exponent = 0;
+    bool hasDigits = false;
+    for (; c < end && *c >= '0' && *c <= '9'; c++) {
+        hasDigits = true;
+        if (mantissa == 0 && *c == '0') continue;
+        mantissa = mantissa * 10 + (uint64) (*c - '0');
+        if (++digitCount > 19) break;
+    }
+    if (c < end && *c == '.' && digitCount <= 19) {
+        for (c++; c < end && *c >= '0' && *c <= '9'; c++) {
+            hasDigits = true;
+            exponent--;
+            if (mantissa == 0 && *c == '0') continue;
+            mantissa = mantissa * 10 + (uint64) (*c - '0');
+            if (++digitCount > 19) break;
+        }
+    }
+    if (c < end && (*c == 'e' || *c == 'E') && hasDigits && digitCount <= 19) {
+        c++;
+        const bool isExponentNegative = c < end && *c == '-';
+        if (c < end && (*c == '-' || *c == '+')) c++;
+        if (c == end) return false;
+
+        int32 explicitExponent = 0;
+        for (; c < end && *c >= '0' && *c <= '9'; c++) {
+            if (explicitExponent < 100000) explicitExponent = explicitExponent * 10 + (*c - '0');
+        }
+        exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+    }
+
+    // Exact when the digits fit a double's mantissa and the power of ten is exactly representable as well, which
+    // covers the numbers found in configs. Everything else goes to strtod through a null terminated copy.
+    if (c == end && hasDigits && digitCount <= 15 && exponent >= -22 && exponent <= 22) {
+        double result = (double) mantissa;
+        result = exponent < 0 ? result / STRING_POWERS_OF_TEN[-exponent] : result * STRING_POWERS_OF_TEN[exponent];
+        *value = isNegative ? -result : result;
+        return true;
+    }
+
+    if (string->length == 0 || string->length >= STRING_MAX_FLOAT_LENGTH) return false;
+    char terminated[STRING_MAX_FLOAT_LENGTH];
+    memcpy(terminated, string->data, string->length);
+    terminated[string->length] = '\0';
+    char *parseEnd;
+    const double result = strtod(terminated, &parseEnd);
+    if (parseEnd != terminated + string->length || LC_String_IsSpace(terminated[0])) return false;
+
+    *value = result;
+    return true;
+}
+
+bool LC_String_ParseFloat(const LC_String *string, float *value) {
+    double wide;
+    if (!LC_String_ParseDouble(string, &wide)) return false;
+
+    *value = (float) wide;
+    return true;
+}
+
+// STRING BUILDER
+static constexpr uint32 STRING_BUILDER_MINIMUM_CAPACITY = 64;
+
+void LC_StringBuilder_Initialize(LC_StringBuilder *builder, LC_Arena *arena, const uint32 initialCapacity) {
+    builder->arena = arena;
+    builder->data = NULL;
+    builder->length = 0;
+    builder->capacity = 0;
+    LC_StringBuilder_Reserve(builder, initialCapacity);
+}
+
+bool LC_StringBuilder_Reserve(LC_StringBuilder *builder, const uint32 capacity) {
+    if (capacity <= builder->capacity && builder->data != NULL) return true;
+
+    // Doubling keeps appends amortized O(1). While the builder's buffer is the arena's latest allocation the resize
+    // happens in place and nothing is copied.
+    uint32 newCapacity = builder->capacity < STRING_BUILDER_MINIMUM_CAPACITY ?
+                         STRING_BUILDER_MINIMUM_CAPACITY : builder->capacity;
+    while (newCapacity < capacity) {
+        if (newCapacity > UINT32_MAX / 2) {
+            newCapacity = capacity;
+            break;
+        }
+        newCapacity *= 2;
+    }
+
+    // One extra byte for the terminator that keeps the contents usable as a C string
+    const size_t oldSize = builder->data == NULL ? 0 : (size_t) builder->capacity + 1;
+    char *data = LC_Arena_ResizeAndAlignNoZero(builder->arena, builder->data, oldSize, (size_t) newCapacity + 1, 1);
+    if (data == NULL) return false;
+
+    builder->data = data;
+    builder->capacity = newCapacity;
+    builder->data[builder->length] = '\0';
+    return true;
+}
+
+bool LC_StringBuilder_AppendBytes(LC_StringBuilder *builder, const char *bytes, const uint32 length) {
+    if (length > UINT32_MAX - 1 - builder->length) return false;
+    if (!LC_StringBuilder_Reserve(builder, builder->length + length)) return false;
+
+    memcpy(builder->data + builder->length, bytes, length);
+    builder->length += length;
+    builder->data[builder->length] = '\0';
+    return true;
+}
+
+bool LC_StringBuilder_Append(LC_StringBuilder *builder, const LC_String *string) {
+    return LC_StringBuilder_AppendBytes(builder, string->data, string->length);
+}
+
+bool LC_StringBuilder_AppendCString(LC_StringBuilder *builder, const char *cString) {
+    return LC_StringBuilder_AppendBytes(builder, cString, (uint32) LC_CString_GetLength(cString));
+}
+
+bool LC_StringBuilder_AppendChar(LC_StringBuilder *builder, const char c) {
+    return LC_StringBuilder_AppendBytes(builder, &c, 1);
+}
+
+bool LC_StringBuilder_AppendFormat(LC_StringBuilder *builder, const char *format, ...) {
+    if (!LC_StringBuilder_Reserve(builder, builder->length)) return false;
+
+    // Format straight into the spare capacity, only when it was too small grow to the reported length and repeat
+    va_list arguments;
+    va_start(arguments, format);
+    const int32 written = vsnprintf(builder->data + builder->length, (size_t) builder->capacity - builder->length + 1,
+                                    format, arguments);
+    va_end(arguments);
+    if (written < 0) {
+        builder->data[builder->length] = '\0';
+        return false;
+    }
+
+    if ((uint32) written > builder->capacity - builder->length) {
+        if ((uint32) written > UINT32_MAX - 1 - builder->length ||
+            !LC_StringBuilder_Reserve(builder, builder->length + (uint32) written)) {
+            builder->data[builder->length] = '\0';
+            return false;
+        }
+        va_start(arguments, format);
+        vsnprintf(builder->data + builder->length, (size_t) written + 1, format, arguments);
+        va_end(arguments);
+    }
+
+    builder->length += (uint32) written;
+    return true;
+}
+
+LC_String LC_StringBuilder_ToString(const LC_StringBuilder *builder) {
+    LC_String string;
+    string.length = builder->length;
+    string.data = builder->data;
+    return string;
+}
+
+void LC_StringBuilder_Clear(LC_StringBuilder *builder) {
+    builder->length = 0;
+    if (builder->data != NULL) builder->data[0] = '\0';
+}
+
+// ===================================================================================================================
+// Utility Operations
+// ===================================================================================================================
+void LC_SwapValues(void *x, void *y, const size_t sizeOfElement, bool *success) {
+    // Swaps through a small stack buffer, elements larger than it are swapped one piece at a time
+    uchar *xBytes = x;
+    uchar *yBytes = y;
+    uchar temp[64];
+    for (size_t offset = 0; offset < sizeOfElement; offset += sizeof(temp)) {
+        const size_t pieceSize = sizeOfElement - offset < sizeof(temp) ? sizeOfElement - offset : sizeof(temp);
+        memcpy(temp, xBytes + offset, pieceSize);
+        memcpy(xBytes + offset, yBytes + offset, pieceSize);
+        memcpy(yBytes + offset, temp, pieceSize);
+    }
+
+    *success = true;
+}
+
+// ===================================================================================================================
+// Memory Allocations
+// ===================================================================================================================
+bool LC_IsPowerOfTwo(const uintptr_t x) {
+    return (x & (x - 1)) == 0;
+}
+
+uintptr_t LC_AlignForward(const uintptr_t ptr, const size_t align) {
+    assert(LC_IsPowerOfTwo(align));
+
+    uintptr_t p = ptr;
+    const uintptr_t a = align;
+    // Same as (p % a) but faster as 'a' is a power of two
+    const uintptr_t modulo = p & (a - 1);
+
+    if (modulo != 0) {
+        // if 'p' address is not aligned, push the address to the next value which is aligned
+        p += a - modulo;
+    }
+
+    return p;
+}
+
+static constexpr size_t ARENA_COMMIT_GRANULARITY = 64 * 1024;
+
+static bool LC_Arena_CommitVirtual(LC_Arena *arena, const size_t requiredLength) {
+    if (requiredLength > arena->virtualReservedLength) return false;
+
+    // Commit in whole granules so that a run of small allocations does not make a system call each
+    size_t committedLength = LC_AlignForward(requiredLength, ARENA_COMMIT_GRANULARITY);
+    if (committedLength > arena->virtualReservedLength) committedLength = arena->virtualReservedLength;
+
+    uchar *start = arena->buffer + arena->bufferLength;
+    const size_t length = committedLength - arena->bufferLength;
+#ifdef _WIN32
+    if (!LC_Win32_CommitMemory(start, length)) return false;
+#elif __linux__
+    if (!LC_Linux_CommitMemory(start, length)) return false;
+#else
+    return false;
+#endif
+    arena->bufferLength = committedLength;
+    if (committedLength > arena->peakReservedBytes) arena->peakReservedBytes = committedLength;
+
+    return true;
+}
+
+static void LC_Arena_DecommitVirtual(LC_Arena *arena, const size_t retainedLength) {
+    if (arena->bufferLength <= retainedLength) return;
+
+    uchar *start = arena->buffer + retainedLength;
+    const size_t length = arena->bufferLength - retainedLength;
+#ifdef _WIN32
+    LC_Win32_DecommitMemory(start, length);
+#elif __linux__
+    LC_Linux_DecommitMemory(start, length);
+#endif
+    arena->bufferLength = retainedLength;
+}
+
+static bool LC_Arena_PushBlock(LC_Arena *arena, const size_t minimumCapacity) {
+    const size_t capacity = minimumCapacity > arena->minimumBlockSize ? minimumCapacity : arena->minimumBlockSize;
+    const size_t allocationSize = sizeof(LC_ArenaBlock) + capacity;
+    LC_ArenaBlock *block = arena->backingAllocator.allocate(arena->backingAllocator.userData, allocationSize);
+    if (block == NULL) return false;
+
+    // Remember where the outgoing block stopped so it can be restored once the new block is released again
+    if (arena->currentBlock != NULL) {
+        arena->currentBlock->previousOffset = arena->previousOffset;
+        arena->currentBlock->currentOffset = arena->currentOffset;
+    }
+
+    block->previous = arena->currentBlock;
+    block->buffer = (uchar *) (block + 1);
+    block->bufferLength = capacity;
+    block->previousOffset = 0;
+    block->currentOffset = 0;
+    block->allocationSize = allocationSize;
+    if (arena->zeroPolicy == LC_ARENA_ZERO_ON_RESET) memset(block->buffer, 0, capacity);
+
+    arena->currentBlock = block;
+    arena->buffer = block->buffer;
+    arena->bufferLength = block->bufferLength;
+    arena->previousOffset = 0;
+    arena->currentOffset = 0;
+
+    arena->blockCount++;
+    arena->totalBlocksAllocated++;
+    arena->reservedBytes += capacity;
+    if (arena->reservedBytes > arena->peakReservedBytes) arena->peakReservedBytes = arena->reservedBytes;
+
+    return true;
+}
+
+static void LC_Arena_PopBlock(LC_Arena *arena) {
+    LC_ArenaBlock *block = arena->currentBlock;
+    LC_ArenaBlock *previous = block->previous;
+
+    arena->blockCount--;
+    arena->reservedBytes -= block->bufferLength;
+    arena->backingAllocator.free(arena->backingAllocator.userData, block, block->allocationSize);
+
+    arena->currentBlock = previous;
+    if (previous != NULL) {
+        arena->buffer = previous->buffer;
+        arena->bufferLength = previous->bufferLength;
+        arena->previousOffset = previous->previousOffset;
+        arena->currentOffset = previous->currentOffset;
+    } else {
+        arena->buffer = NULL;
+        arena->bufferLength = 0;
+        arena->previousOffset = 0;
+        arena->currentOffset = 0;
+    }
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static void *LC_Arena_AllocateInternal(LC_Arena *arena, const size_t size, const size_t align, const bool zero) {
+    // Align 'currentOffset' forward to the specified alignment
+    const uintptr_t currentPointer = (uintptr_t) arena->buffer + arena->currentOffset;
+    uintptr_t offset = LC_AlignForward(currentPointer, align);
+    offset -= (uintptr_t) arena->buffer;
+
+    // check to see if the backing memory has space left
+    if (offset + size <= arena->bufferLength) {
+        void *pointer = &arena->buffer[offset];
+        arena->previousOffset = offset;
+        arena->currentOffset = offset + size;
+
+        if (zero) memset(pointer, 0, size);
+        return pointer;
+    }
+    // a virtual arena commits more of its reserved address range, the buffer never moves
+    if (arena->virtualReservedLength != 0 && LC_Arena_CommitVirtual(arena, offset + size)) {
+        return LC_Arena_AllocateInternal(arena, size, align, zero);
+    }
+    // a growable arena chains a new block big enough for this allocation instead of running out of memory
+    if (arena->backingAllocator.allocate != NULL && LC_Arena_PushBlock(arena, size + align)) {
+        return LC_Arena_AllocateInternal(arena, size, align, zero);
+    }
+    // return NULL if the arena is out of memory (or handle differently)
+    return NULL;
+}
+
+void *LC_AllocateAndAlignArena(LC_Arena *arena, const size_t size, const size_t align) {
+    // zero new memory by default, arenas that zero in bulk or not at all skip it here
+    return LC_Arena_AllocateInternal(arena, size, align, arena->zeroPolicy == LC_ARENA_ZERO_ALWAYS);
+}
+
+void *LC_AllocateAndAlignArenaNoZero(LC_Arena *arena, const size_t size, const size_t align) {
+    return LC_Arena_AllocateInternal(arena, size, align, false);
+}
+
+void *LC_Arena_Allocate(LC_Arena *arena, const size_t size) {
+    return LC_AllocateAndAlignArena(arena, size, DEFAULT_ALIGNMENT);
+}
+
+void *LC_Arena_AllocateNoZero(LC_Arena *arena, const size_t size) {
+    return LC_Arena_AllocateInternal(arena, size, DEFAULT_ALIGNMENT, false);
+}
+
+void LC_Arena_Initialize(LC_Arena *arena, void *backingBuffer, const size_t backingBufferLength) {
+    arena->buffer = (uchar *) backingBuffer;
+    arena->bufferLength = backingBufferLength;
+    arena->currentOffset = 0;
+    arena->previousOffset = 0;
+    arena->currentBlock = NULL;
+    arena->backingAllocator.allocate = NULL;
+    arena->backingAllocator.free = NULL;
+    arena->backingAllocator.userData = NULL;
+    arena->minimumBlockSize = 0;
+    arena->blockCount = 0;
+    arena->totalBlocksAllocated = 0;
+    arena->reservedBytes = 0;
+    arena->peakReservedBytes = 0;
+    arena->virtualReservedLength = 0;
+    arena->virtualRetainedLength = 0;
+    arena->zeroPolicy = LC_ARENA_ZERO_ALWAYS;
+}
+
+void LC_Arena_SetZeroPolicy(LC_Arena *arena, const LC_ArenaZeroPolicy zeroPolicy) {
+    // Memory past the current offset may hold anything, so it has to be cleared once before it can be handed out as
+    // zeroed memory without touching it on every allocation
+    if (zeroPolicy == LC_ARENA_ZERO_ON_RESET && arena->zeroPolicy != LC_ARENA_ZERO_ON_RESET && arena->buffer != NULL) {
+        memset(arena->buffer + arena->currentOffset, 0, arena->bufferLength - arena->currentOffset);
+        // FreeAll and EndTemporary go back to older blocks of a growable arena at the offsets they stopped at
+        if (arena->currentBlock != NULL) {
+            for (LC_ArenaBlock *block = arena->currentBlock->previous; block != NULL; block = block->previous) {
+                memset(block->buffer + block->currentOffset, 0, block->bufferLength - block->currentOffset);
+            }
+        }
+    }
+    arena->zeroPolicy = zeroPolicy;
+}
+
+void LC_Arena_Free(LC_Arena *arena, void *pointer) {
+    // Only the most recent allocation can be handed back, anything else is released by FreeAll or EndTemporary
+    if (pointer != NULL && arena->buffer != NULL && arena->buffer + arena->previousOffset == (uchar *) pointer) {
+        // The allocation is past the current offset again and must be clean when it is handed out again
+        if (arena->zeroPolicy == LC_ARENA_ZERO_ON_RESET) {
+            memset(&arena->buffer[arena->previousOffset], 0, arena->currentOffset - arena->previousOffset);
+        }
+        arena->currentOffset = arena->previousOffset;
+    }
+}
+
+static void *LC_Arena_ResizeInternal(LC_Arena *arena, void *oldMemory, const size_t oldSize, const size_t newSize,
+                                     const size_t align, const bool zero) {
+    assert(LC_IsPowerOfTwo(align));
+
+    if (oldMemory == NULL || oldSize == 0) return LC_Arena_AllocateInternal(arena, newSize, align, zero);
+    const size_t copySize = oldSize < newSize ? oldSize : newSize;
+    if (arena->buffer <= (uchar *) oldMemory && (uchar *) oldMemory < arena->buffer + arena->bufferLength) {
+        if (arena->buffer + arena->previousOffset == oldMemory && arena->previousOffset + newSize > arena->bufferLength &&
+            arena->virtualReservedLength != 0) {
+            LC_Arena_CommitVirtual(arena, arena->previousOffset + newSize);
+        }
+        if (arena->buffer + arena->previousOffset == oldMemory && arena->previousOffset + newSize <= arena->bufferLength) {
+            arena->currentOffset = arena->previousOffset + newSize;
+            if (newSize > oldSize && zero) {
+                memset(&arena->buffer[arena->previousOffset + oldSize], 0, newSize - oldSize);
+            } else if (newSize < oldSize && arena->zeroPolicy == LC_ARENA_ZERO_ON_RESET) {
+                // the released tail is past the current offset now and must be clean when it is handed out again
+                memset(&arena->buffer[arena->currentOffset], 0, oldSize - newSize);
+            }
+            return oldMemory;
+        }
+        void *newMemory = LC_Arena_AllocateInternal(arena, newSize, align, false);
+        if (newMemory == NULL) return NULL;
+        // copy across old memory ot the new memory
+        memmove(newMemory, oldMemory, copySize);
+        if (newSize > oldSize && zero) memset((uchar *) newMemory + oldSize, 0, newSize - oldSize);
+        return newMemory;
+    }
+    if (arena->currentBlock != NULL) {
+        // The memory lives in an older block of a growable arena. Blocks never move, so copy it forward.
+        void *newMemory = LC_Arena_AllocateInternal(arena, newSize, align, false);
+        if (newMemory == NULL) return NULL;
+        memcpy(newMemory, oldMemory, copySize);
+        if (newSize > oldSize && zero) memset((uchar *) newMemory + oldSize, 0, newSize - oldSize);
+        return newMemory;
+    }
+    assert(0 && "Memory is out of bounds of the buffer in this arena");
+    return NULL;
+}
+
+void *LC_Arena_ResizeAndAlign(LC_Arena *arena, void *oldMemory, const size_t oldSize, const size_t newSize,
+                             const size_t align) {
+    return LC_Arena_ResizeInternal(arena, oldMemory, oldSize, newSize, align,
+                                   arena->zeroPolicy == LC_ARENA_ZERO_ALWAYS);
+}
+
+void *LC_Arena_ResizeAndAlignNoZero(LC_Arena *arena, void *oldMemory, const size_t oldSize, const size_t newSize,
+                                    const size_t align) {
+    return LC_Arena_ResizeInternal(arena, oldMemory, oldSize, newSize, align, false);
+}
+
+void *LC_Arena_Resize(LC_Arena *arena, void *oldMemory, const size_t oldSize, const size_t newSize) {
+    return LC_Arena_ResizeAndAlign(arena, oldMemory, oldSize, newSize, DEFAULT_ALIGNMENT);
+}
+
+void *LC_Arena_ResizeNoZero(LC_Arena *arena, void *oldMemory, const size_t oldSize, const size_t newSize) {
+    return LC_Arena_ResizeInternal(arena, oldMemory, oldSize, newSize, DEFAULT_ALIGNMENT, false);
+}
+
+void LC_Arena_FreeAll(LC_Arena *arena) {
+    // A growable arena keeps its oldest block so the next frame does not have to go back to the backing allocator
+    while (arena->currentBlock != NULL && arena->currentBlock->previous != NULL) {
+        LC_Arena_PopBlock(arena);
+    }
+    // A virtual arena may hand pages above its retained size back to the system
+    if (arena->virtualReservedLength != 0 && arena->virtualRetainedLength != 0) {
+        LC_Arena_DecommitVirtual(arena, arena->virtualRetainedLength);
+    }
+    if (arena->zeroPolicy == LC_ARENA_ZERO_ON_RESET && arena->buffer != NULL) {
+        const size_t usedLength = arena->currentOffset < arena->bufferLength ? arena->currentOffset : arena->bufferLength;
+        memset(arena->buffer, 0, usedLength);
+    }
+    arena->currentOffset = 0;
+    arena->previousOffset = 0;
+}
+
+bool LC_Arena_InitializeGrowable(LC_Arena *arena, const LC_ArenaBackingAllocator backingAllocator,
+                                 const size_t minimumBlockSize) {
+    LC_Arena_Initialize(arena, NULL, 0);
+    arena->backingAllocator = backingAllocator;
+    arena->minimumBlockSize = minimumBlockSize;
+
+    return LC_Arena_PushBlock(arena, minimumBlockSize);
+}
+
+bool LC_Arena_InitializeVirtual(LC_Arena *arena, const size_t reserveSize, const size_t retainedCommitSize) {
+    LC_Arena_Initialize(arena, NULL, 0);
+
+    const size_t reservedLength = LC_AlignForward(reserveSize, ARENA_COMMIT_GRANULARITY);
+#ifdef _WIN32
+    void *memory = LC_Win32_ReserveMemory(reservedLength);
+#elif __linux__
+    void *memory = LC_Linux_ReserveMemory(reservedLength);
+#else
+    void *memory = NULL;
+#endif
+    if (memory == NULL) return false;
+
+    // 'bufferLength' is the committed part of the reservation, so the bump pointer fast path is unchanged
+    arena->buffer = memory;
+    arena->bufferLength = 0;
+    arena->virtualReservedLength = reservedLength;
+    arena->virtualRetainedLength = LC_AlignForward(retainedCommitSize, ARENA_COMMIT_GRANULARITY);
+
+    return true;
+}
+
+void LC_Arena_Destroy(LC_Arena *arena) {
+    while (arena->currentBlock != NULL) {
+        LC_Arena_PopBlock(arena);
+    }
+    if (arena->virtualReservedLength != 0) {
+#ifdef _WIN32
+        LC_Win32_UnmapMemory(arena->buffer, arena->virtualReservedLength);
+#elif __linux__
+        LC_Linux_UnmapMemory(arena->buffer, arena->virtualReservedLength);
+#endif
+        arena->buffer = NULL;
+        arena->bufferLength = 0;
+        arena->virtualReservedLength = 0;
+    }
+    arena->currentOffset = 0;
+    arena->previousOffset = 0;
+}
+
+static void* LC_ArenaBacking_MallocAllocate(void *userData, const size_t size) {
+    (void)userData;
+    return malloc(size);
+}
+
+static void LC_ArenaBacking_MallocFree(void *userData, void *memory, const size_t size) {
+    (void)userData;
+    (void)size;
+    free(memory);
+}
+
+LC_ArenaBackingAllocator LC_ArenaBacking_Malloc(void) {
+    LC_ArenaBackingAllocator backingAllocator;
+    backingAllocator.allocate = LC_ArenaBacking_MallocAllocate;
+    backingAllocator.free = LC_ArenaBacking_MallocFree;
+    backingAllocator.userData = NULL;
+
+    return backingAllocator;
+}
+
+static void* LC_ArenaBacking_PagesAllocate(void *userData, const size_t size) {
+    (void)userData;
+#ifdef _WIN32
+    return LC_Win32_MapMemory(size);
+#elif __linux__
+    return LC_Linux_MapMemory(size);
+#else
+    return malloc(size);
+#endif
+}
+
+static void LC_ArenaBacking_PagesFree(void *userData, void *memory, const size_t size) {
+    (void)userData;
+#ifdef _WIN32
+    LC_Win32_UnmapMemory(memory, size);
+#elif __linux__
+    LC_Linux_UnmapMemory(memory, size);
+#else
+    (void)size;
+    free(memory);
+#endif
+}
+
+LC_ArenaBackingAllocator LC_ArenaBacking_Pages(void) {
+    LC_ArenaBackingAllocator backingAllocator;
+    backingAllocator.allocate = LC_ArenaBacking_PagesAllocate;
+    backingAllocator.free = LC_ArenaBacking_PagesFree;
+    backingAllocator.userData = NULL;
+
+    return backingAllocator;
+}
+
+void LC_Arena_GetStats(const LC_Arena *arena, LC_ArenaStats *stats) {
+    if (arena->currentBlock == NULL) {
+        // fixed and virtual arenas always consist of the single buffer they were initialized with
+        stats->blockCount = arena->buffer != NULL ? 1 : 0;
+        stats->totalBlocksAllocated = stats->blockCount;
+        stats->reservedBytes = arena->virtualReservedLength != 0 ? arena->virtualReservedLength : arena->bufferLength;
+        stats->committedBytes = arena->bufferLength;
+        stats->usedBytes = arena->currentOffset;
+        stats->peakReservedBytes = arena->virtualReservedLength != 0 ? arena->peakReservedBytes : arena->bufferLength;
+        return;
+    }
+
+    stats->blockCount = arena->blockCount;
+    stats->totalBlocksAllocated = arena->totalBlocksAllocated;
+    stats->reservedBytes = arena->reservedBytes;
+    stats->committedBytes = arena->reservedBytes;
+    stats->peakReservedBytes = arena->peakReservedBytes;
+    stats->usedBytes = arena->currentOffset;
+    for (const LC_ArenaBlock *block = arena->currentBlock->previous; block != NULL; block = block->previous) {
+        stats->usedBytes += block->currentOffset;
+    }
+}
+
+uint32 LC_Arena_GetBlockStats(const LC_Arena *arena, LC_ArenaBlockStats *blockStats, const uint32 maxBlocks) {
+    if (arena->currentBlock == NULL) {
+        if (maxBlocks == 0 || arena->buffer == NULL) return 0;
+        blockStats[0].capacity = arena->bufferLength;
+        blockStats[0].used = arena->currentOffset;
+        return 1;
+    }
+
+    // Blocks are reported newest first. The unused tail of an older block is memory lost to chaining.
+    uint32 count = 0;
+    for (const LC_ArenaBlock *block = arena->currentBlock; block != NULL && count < maxBlocks; block = block->previous) {
+        blockStats[count].capacity = block->bufferLength;
+        blockStats[count].used = block == arena->currentBlock ? arena->currentOffset : block->currentOffset;
+        count++;
+    }
+
+    return count;
+}
+
+TemporaryArenaMemory LC_Arena_BeginTemporaryMemory(LC_Arena *arena) {
+    TemporaryArenaMemory temporaryArena;
+    temporaryArena.arena = arena;
+    temporaryArena.block = arena->currentBlock;
+    temporaryArena.previousOffset = arena->previousOffset;
+    temporaryArena.currentOffset = arena->currentOffset;
+
+    return temporaryArena;
+}
+
+void LC_Arena_EndTemporary(const TemporaryArenaMemory temporaryArena) {
+    // release every block that was chained after the temporary memory began
+    while (temporaryArena.arena->currentBlock != temporaryArena.block &&
+           temporaryArena.arena->currentBlock != NULL) {
+        LC_Arena_PopBlock(temporaryArena.arena);
+    }
+    assert(temporaryArena.arena->currentBlock == temporaryArena.block);
+
+    if (temporaryArena.arena->zeroPolicy == LC_ARENA_ZERO_ON_RESET &&
+        temporaryArena.arena->currentOffset > temporaryArena.currentOffset) {
+        memset(temporaryArena.arena->buffer + temporaryArena.currentOffset, 0,
+               temporaryArena.arena->currentOffset - temporaryArena.currentOffset);
+    }
+
+    temporaryArena.arena->previousOffset = temporaryArena.previousOffset;
+    temporaryArena.arena->currentOffset = temporaryArena.currentOffset;
+}
+
+// ===================================================================================================================
+// Scratch Memory
+// ===================================================================================================================
+// Every thread lazily reserves its own scratch arenas, so getting temporary memory never locks or calls malloc.
+static thread_local LC_Arena scratchArenas[LC_SCRATCH_ARENA_COUNT];
+
+static LC_Arena* LC_Scratch_GetArena(const uint32 index) {
+    LC_Arena *arena = &scratchArenas[index];
+    if (arena->buffer == NULL && arena->currentBlock == NULL) {
+        if (!LC_Arena_InitializeVirtual(arena, LC_SCRATCH_ARENA_RESERVE_SIZE, 0)) {
+            // platforms without virtual memory support fall back to chained blocks
+            LC_Arena_InitializeGrowable(arena, LC_ArenaBacking_Pages(), 256 * 1024);
+        }
+    }
+    return arena;
+}
+
+TemporaryArenaMemory LC_Scratch_Begin(LC_Arena **conflicts, const uint32 conflictCount) {
+    // Hand out the first scratch arena that the caller is not already using. A function that receives an arena from
+    // its caller passes it as a conflict so its own temporary allocations cannot clobber the caller's.
+    for (uint32 i = 0; i < LC_SCRATCH_ARENA_COUNT; i++) {
+        LC_Arena *candidate = &scratchArenas[i];
+        bool isConflicting = false;
+        for (uint32 j = 0; j < conflictCount; j++) {
+            if (conflicts[j] == candidate) {
+                isConflicting = true;
+                break;
+            }
+        }
+        if (!isConflicting) return LC_Arena_BeginTemporaryMemory(LC_Scratch_GetArena(i));
+    }
+
+    assert(0 && "Every scratch arena conflicts, increase LC_SCRATCH_ARENA_COUNT");
+    TemporaryArenaMemory none = {0};
+    return none;
+}
+
+void LC_Scratch_End(const TemporaryArenaMemory scratch) {
+    LC_Arena_EndTemporary(scratch);
+}
+
+void LC_Scratch_ReleaseThreadArenas(void) {
+    for (uint32 i = 0; i < LC_SCRATCH_ARENA_COUNT; i++) {
+        LC_Arena_Destroy(&scratchArenas[i]);
+    }
+}
+
+// ===================================================================================================================
+// Pool Allocator
+// ===================================================================================================================
+static constexpr uint64 POOL_FREE_SLOT_MAGIC = 0xF4EE5107F4EE5107ull;
+static constexpr uchar POOL_POISON_BYTE = 0xDD;
+
+static void LC_Pool_InitializeCommon(LC_Pool *pool, const size_t slotSize, const size_t slotAlignment) {
+    assert(LC_IsPowerOfTwo(slotAlignment));
+
+    // every slot has to be able to hold the intrusive free list node while it is not in use
+    const size_t minimumSize = slotSize > sizeof(LC_PoolFreeSlot) ? slotSize : sizeof(LC_PoolFreeSlot);
+    const size_t alignment = slotAlignment > alignof(LC_PoolFreeSlot) ? slotAlignment : alignof(LC_PoolFreeSlot);
+
+    pool->arena = NULL;
+    pool->freeList = NULL;
+    pool->firstChunk = NULL;
+    pool->currentChunk = NULL;
+    pool->cursor = NULL;
+    pool->slotSize = LC_AlignForward(minimumSize, alignment);
+    pool->slotAlignment = alignment;
+    pool->slotsPerChunk = 0;
+    pool->chunkCount = 0;
+    pool->allocatedSlots = 0;
+    pool->capacitySlots = 0;
+#ifdef DEBUG
+    pool->debugChecks = true;
+#else
+    pool->debugChecks = false;
+#endif
+}
+
+static LC_PoolChunk* LC_Pool_CarveChunk(LC_Pool *pool, uchar *memory, const size_t length) {
+    LC_PoolChunk *chunk = (LC_PoolChunk *) LC_AlignForward((uintptr_t) memory, alignof(LC_PoolChunk));
+    uchar *firstSlot = (uchar *) LC_AlignForward((uintptr_t) (chunk + 1), pool->slotAlignment);
+    if (firstSlot + pool->slotSize > memory + length) return NULL;
+
+    const size_t slotCount = (size_t) (memory + length - firstSlot) / pool->slotSize;
+    chunk->next = NULL;
+    chunk->firstSlot = firstSlot;
+    chunk->end = firstSlot + slotCount * pool->slotSize;
+
+    if (pool->currentChunk != NULL) pool->currentChunk->next = chunk;
+    if (pool->firstChunk == NULL) pool->firstChunk = chunk;
+    pool->currentChunk = chunk;
+    pool->cursor = firstSlot;
+    pool->chunkCount++;
+    pool->capacitySlots += slotCount;
+
+    return chunk;
+}
+
+bool LC_Pool_Initialize(LC_Pool *pool, void *backingBuffer, const size_t backingBufferLength, const size_t slotSize,
+                        const size_t slotAlignment) {
+    LC_Pool_InitializeCommon(pool, slotSize, slotAlignment);
+
+    return LC_Pool_CarveChunk(pool, backingBuffer, backingBufferLength) != NULL;
+}
+
+void LC_Pool_InitializeFromArena(LC_Pool *pool, LC_Arena *arena, const size_t slotSize, const size_t slotAlignment,
+                                 const uint32 slotsPerChunk) {
+    LC_Pool_InitializeCommon(pool, slotSize, slotAlignment);
+    pool->arena = arena;
+    pool->slotsPerChunk = slotsPerChunk > 0 ? slotsPerChunk : 64;
+}
+
+void LC_Pool_SetDebugChecks(LC_Pool *pool, const bool enabled) {
+    pool->debugChecks = enabled;
+}
+
+void* LC_Pool_Allocate(LC_Pool *pool) {
+    uchar *slot = NULL;
+
+    if (pool->freeList != NULL) {
+        LC_PoolFreeSlot *freeSlot = pool->freeList;
+        pool->freeList = freeSlot->next;
+        slot = (uchar *) freeSlot;
+
+        if (pool->debugChecks) {
+            // a poisoned byte that changed means someone wrote to the slot after it was freed
+            for (size_t i = sizeof(LC_PoolFreeSlot); i < pool->slotSize; i++) {
+                if (slot[i] != POOL_POISON_BYTE) {
+                    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "LC_Pool: slot %p was written to after being freed",
+                                 (void *) slot);
+                    break;
+                }
+            }
+        }
+    } else {
+        // Bump through the chunks that are already carved (they may be reused after a FreeAll), then grow
+        while (pool->currentChunk != NULL && pool->cursor + pool->slotSize > pool->currentChunk->end &&
+               pool->currentChunk->next != NULL) {
+            pool->currentChunk = pool->currentChunk->next;
+            pool->cursor = pool->currentChunk->firstSlot;
+        }
+        if (pool->currentChunk == NULL || pool->cursor + pool->slotSize > pool->currentChunk->end) {
+            if (pool->arena == NULL) return NULL;
+
+            const size_t chunkLength = sizeof(LC_PoolChunk) + pool->slotAlignment +
+                                       (size_t) pool->slotsPerChunk * pool->slotSize;
+            uchar *memory = LC_Arena_AllocateNoZero(pool->arena, chunkLength);
+            if (memory == NULL || LC_Pool_CarveChunk(pool, memory, chunkLength) == NULL) return NULL;
+        }
+        slot = pool->cursor;
+        pool->cursor += pool->slotSize;
+    }
+
+    pool->allocatedSlots++;
+    memset(slot, 0, pool->slotSize);
+    return slot;
+}
+
+bool LC_Pool_Free(LC_Pool *pool, void *pointer) {
+    if (pointer == NULL) return true;
+
+    LC_PoolFreeSlot *freeSlot = pointer;
+    if (pool->debugChecks) {
+        // The magic value alone can be a coincidence in user data, so confirm by looking for the slot in the free list
+        if (freeSlot->magic == POOL_FREE_SLOT_MAGIC) {
+            for (const LC_PoolFreeSlot *slot = pool->freeList; slot != NULL; slot = slot->next) {
+                if (slot == freeSlot) {
+                    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "LC_Pool: double free of slot %p", pointer);
+                    return false;
+                }
+            }
+        }
+        memset((uchar *) pointer + sizeof(LC_PoolFreeSlot), POOL_POISON_BYTE, pool->slotSize - sizeof(LC_PoolFreeSlot));
+    }
+
+    freeSlot->magic = POOL_FREE_SLOT_MAGIC;
+    freeSlot->next = pool->freeList;
+    pool->freeList = freeSlot;
+    pool->allocatedSlots--;
+
+    return true;
+}
+
+void LC_Pool_FreeAll(LC_Pool *pool) {
+    // Chunks stay carved, allocation simply starts bumping from the first one again
+    pool->freeList = NULL;
+    pool->currentChunk = pool->firstChunk;
+    pool->cursor = pool->firstChunk != NULL ? pool->firstChunk->firstSlot : NULL;
+    pool->allocatedSlots = 0;
+}
+
+// ===================================================================================================================
+// General Purpose Heap
+// ===================================================================================================================
+// Every operation does a bounded amount of work: size classes are found with bit scans on the two level bitmaps,
+// and freed blocks are merged with at most their two physical neighbours.
+static constexpr size_t HEAP_ALIGN_SIZE_LOG2 = 4;
+static constexpr size_t HEAP_ALIGN_SIZE = 1 << HEAP_ALIGN_SIZE_LOG2;
+static constexpr uint32 HEAP_SL_INDEX_COUNT_LOG2 = 5;
+static constexpr uint32 HEAP_FL_INDEX_SHIFT = HEAP_SL_INDEX_COUNT_LOG2 + HEAP_ALIGN_SIZE_LOG2;
+static constexpr size_t HEAP_SMALL_BLOCK_SIZE = 1 << HEAP_FL_INDEX_SHIFT;
+static constexpr size_t HEAP_BLOCK_OVERHEAD = offsetof(LC_HeapBlock, nextFree);
+static constexpr size_t HEAP_MINIMUM_BLOCK_SIZE = sizeof(LC_HeapBlock) - HEAP_BLOCK_OVERHEAD;
+static constexpr size_t HEAP_MAXIMUM_BLOCK_SIZE = (size_t) 1 << (LC_HEAP_FL_INDEX_COUNT + HEAP_FL_INDEX_SHIFT - 1);
+static constexpr size_t HEAP_BLOCK_FREE_BIT = 1;
+static constexpr size_t HEAP_BLOCK_PREVIOUS_FREE_BIT = 2;
+static constexpr size_t HEAP_DEFAULT_GROW_SIZE = 1024 * 1024;
+
+static uint32 LC_Heap_FindLastSet(const size_t value) {
+    return (uint32) (sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(value));
+}
+
+static size_t LC_HeapBlock_GetSize(const LC_HeapBlock *block) {
+    return block->size & ~(HEAP_BLOCK_FREE_BIT | HEAP_BLOCK_PREVIOUS_FREE_BIT);
+}
+
+static void LC_HeapBlock_SetSize(LC_HeapBlock *block, const size_t size) {
+    block->size = size | (block->size & (HEAP_BLOCK_FREE_BIT | HEAP_BLOCK_PREVIOUS_FREE_BIT));
+}
+
+static bool LC_HeapBlock_IsFree(const LC_HeapBlock *block) {
+    return (block->size & HEAP_BLOCK_FREE_BIT) != 0;
+}
+
+static void* LC_HeapBlock_GetPayload(const LC_HeapBlock *block) {
+    return (uchar *) block + HEAP_BLOCK_OVERHEAD;
+}
+
+static LC_HeapBlock* LC_HeapBlock_FromPayload(const void *pointer) {
+    return (LC_HeapBlock *) ((uchar *) pointer - HEAP_BLOCK_OVERHEAD);
+}
+
+static LC_HeapBlock* LC_HeapBlock_GetNext(const LC_HeapBlock *block) {
+    return (LC_HeapBlock *) ((uchar *) LC_HeapBlock_GetPayload(block) + LC_HeapBlock_GetSize(block));
+}
+
+// Marks the block free or used and keeps the "previous is free" flag of its physical successor in sync
+static void LC_HeapBlock_SetFree(LC_HeapBlock *block, const bool isFree) {
+    LC_HeapBlock *next = LC_HeapBlock_GetNext(block);
+    if (isFree) {
+        block->size |= HEAP_BLOCK_FREE_BIT;
+        next->size |= HEAP_BLOCK_PREVIOUS_FREE_BIT;
+    } else {
+        block->size &= ~HEAP_BLOCK_FREE_BIT;
+        next->size &= ~HEAP_BLOCK_PREVIOUS_FREE_BIT;
+    }
+    next->previousPhysical = block;
+}
+
+static void LC_Heap_Mapping(const size_t size, uint32 *firstLevel, uint32 *secondLevel) {
+    if (size < HEAP_SMALL_BLOCK_SIZE) {
+        // small blocks are spread linearly over the second level of the first class
+        *firstLevel = 0;
+        *secondLevel = (uint32) (size / (HEAP_SMALL_BLOCK_SIZE / LC_HEAP_SL_INDEX_COUNT));
+    } else {
+        const uint32 lastSet = LC_Heap_FindLastSet(size);
+        *secondLevel = (uint32) (size >> (lastSet - HEAP_SL_INDEX_COUNT_LOG2)) ^ (1u << HEAP_SL_INDEX_COUNT_LOG2);
+        *firstLevel = lastSet - (HEAP_FL_INDEX_SHIFT - 1);
+    }
+}
+
+static void LC_Heap_MappingSearch(size_t size, uint32 *firstLevel, uint32 *secondLevel) {
+    // Round the request up to the next class so that any block found there is guaranteed to be big enough
+    if (size >= HEAP_SMALL_BLOCK_SIZE) {
+        size += ((size_t) 1 << (LC_Heap_FindLastSet(size) - HEAP_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    LC_Heap_Mapping(size, firstLevel, secondLevel);
+}
+
+static void LC_Heap_InsertFreeBlock(LC_Heap *heap, LC_HeapBlock *block) {
+    uint32 firstLevel, secondLevel;
+    LC_Heap_Mapping(LC_HeapBlock_GetSize(block), &firstLevel, &secondLevel);
+
+    LC_HeapBlock *head = heap->freeLists[firstLevel][secondLevel];
+    block->nextFree = head;
+    block->previousFree = NULL;
+    if (head != NULL) head->previousFree = block;
+    heap->freeLists[firstLevel][secondLevel] = block;
+
+    heap->firstLevelBitmap |= 1u << firstLevel;
+    heap->secondLevelBitmap[firstLevel] |= 1u << secondLevel;
+    heap->freeBlockCount++;
+}
+
+static void LC_Heap_RemoveFreeBlock(LC_Heap *heap, LC_HeapBlock *block) {
+    uint32 firstLevel, secondLevel;
+    LC_Heap_Mapping(LC_HeapBlock_GetSize(block), &firstLevel, &secondLevel);
+
+    if (block->previousFree != NULL) block->previousFree->nextFree = block->nextFree;
+    if (block->nextFree != NULL) block->nextFree->previousFree = block->previousFree;
+    if (heap->freeLists[firstLevel][secondLevel] == block) {
+        heap->freeLists[firstLevel][secondLevel] = block->nextFree;
+        if (block->nextFree == NULL) {
+            heap->secondLevelBitmap[firstLevel] &= ~(1u << secondLevel);
+            if (heap->secondLevelBitmap[firstLevel] == 0) heap->firstLevelBitmap &= ~(1u << firstLevel);
+        }
+    }
+    heap->freeBlockCount--;
+}
+
+static LC_HeapBlock* LC_Heap_FindSuitableBlock(const LC_Heap *heap, uint32 firstLevel, uint32 secondLevel) {
+    if (firstLevel >= LC_HEAP_FL_INDEX_COUNT) return NULL;
+
+    uint32 secondLevelMap = heap->secondLevelBitmap[firstLevel] & (~0u << secondLevel);
+    if (secondLevelMap == 0) {
+        // nothing left in this class, take the smallest non-empty larger class
+        const uint32 firstLevelMap = firstLevel + 1 < LC_HEAP_FL_INDEX_COUNT ?
+                                     heap->firstLevelBitmap & (~0u << (firstLevel + 1)) : 0;
+        if (firstLevelMap == 0) return NULL;
+
+        firstLevel = (uint32) __builtin_ctz(firstLevelMap);
+        secondLevelMap = heap->secondLevelBitmap[firstLevel];
+    }
+    secondLevel = (uint32) __builtin_ctz(secondLevelMap);
+
+    return heap->freeLists[firstLevel][secondLevel];
+}
+
+// Splits 'block' after 'size' bytes of payload when the remainder can hold a block of its own, the remainder is freed
+static void LC_Heap_TrimBlock(LC_Heap *heap, LC_HeapBlock *block, const size_t size) {
+    const size_t blockSize = LC_HeapBlock_GetSize(block);
+    if (blockSize < size + HEAP_BLOCK_OVERHEAD + HEAP_MINIMUM_BLOCK_SIZE) return;
+
+    LC_HeapBlock *remaining = (LC_HeapBlock *) ((uchar *) LC_HeapBlock_GetPayload(block) + size);
+    remaining->size = blockSize - size - HEAP_BLOCK_OVERHEAD;
+    LC_HeapBlock_SetSize(block, size);
+    remaining->previousPhysical = block;
+
+    // the remainder may border a free block, merge it so that free blocks never sit next to each other
+    LC_HeapBlock *next = LC_HeapBlock_GetNext(remaining);
+    if (LC_HeapBlock_IsFree(next)) {
+        LC_Heap_RemoveFreeBlock(heap, next);
+        remaining->size += LC_HeapBlock_GetSize(next) + HEAP_BLOCK_OVERHEAD;
+    }
+    LC_HeapBlock_SetFree(remaining, true);
+    LC_Heap_InsertFreeBlock(heap, remaining);
+}
+
+static bool LC_Heap_AddRegion(LC_Heap *heap, void *memory, const size_t length) {
+    uchar *start = (uchar *) LC_AlignForward((uintptr_t) memory, HEAP_ALIGN_SIZE);
+    uchar *end = (uchar *) memory + length;
+    if (start + 2 * HEAP_BLOCK_OVERHEAD + HEAP_MINIMUM_BLOCK_SIZE > end) return false;
+
+    // One free block spanning the region, followed by a zero sized used sentinel that stops coalescing
+    size_t blockSize = (size_t) (end - start) - 2 * HEAP_BLOCK_OVERHEAD;
+    blockSize &= ~(HEAP_ALIGN_SIZE - 1);
+    if (blockSize >= HEAP_MAXIMUM_BLOCK_SIZE) blockSize = HEAP_MAXIMUM_BLOCK_SIZE - HEAP_ALIGN_SIZE;
+
+    LC_HeapBlock *block = (LC_HeapBlock *) start;
+    block->previousPhysical = NULL;
+    block->size = blockSize;
+
+    LC_HeapBlock *sentinel = LC_HeapBlock_GetNext(block);
+    sentinel->size = 0;
+    LC_HeapBlock_SetFree(block, true);
+    LC_Heap_InsertFreeBlock(heap, block);
+
+    heap->totalBytes += blockSize;
+    heap->regionCount++;
+
+    return true;
+}
+
+bool LC_Heap_Initialize(LC_Heap *heap, LC_Arena *arena, const size_t size) {
+    heap->arena = arena;
+    heap->growSize = size > HEAP_DEFAULT_GROW_SIZE ? size : HEAP_DEFAULT_GROW_SIZE;
+    heap->firstLevelBitmap = 0;
+    memset(heap->secondLevelBitmap, 0, sizeof(heap->secondLevelBitmap));
+    memset(heap->freeLists, 0, sizeof(heap->freeLists));
+    heap->totalBytes = 0;
+    heap->usedBytes = 0;
+    heap->usedBlockCount = 0;
+    heap->freeBlockCount = 0;
+    heap->regionCount = 0;
+
+    void *memory = LC_AllocateAndAlignArenaNoZero(arena, size, HEAP_ALIGN_SIZE);
+    if (memory == NULL) return false;
+
+    return LC_Heap_AddRegion(heap, memory, size);
+}
+
+static void* LC_Heap_AllocateInternal(LC_Heap *heap, const size_t size, size_t align, const bool zero) {
+    assert(LC_IsPowerOfTwo(align));
+    if (size == 0 || size > HEAP_MAXIMUM_BLOCK_SIZE / 2) return NULL;
+    if (align < HEAP_ALIGN_SIZE) align = HEAP_ALIGN_SIZE;
+
+    size_t adjustedSize = LC_AlignForward(size, HEAP_ALIGN_SIZE);
+    if (adjustedSize < HEAP_MINIMUM_BLOCK_SIZE) adjustedSize = HEAP_MINIMUM_BLOCK_SIZE;
+
+    // Over aligned requests search for enough slack to cut a free block off the front of the one that is found
+    const size_t gapMinimum = HEAP_BLOCK_OVERHEAD + HEAP_MINIMUM_BLOCK_SIZE;
+    const size_t searchSize = align > HEAP_ALIGN_SIZE ? adjustedSize + align + gapMinimum : adjustedSize;
+
+    uint32 firstLevel, secondLevel;
+    LC_Heap_MappingSearch(searchSize, &firstLevel, &secondLevel);
+    LC_HeapBlock *block = LC_Heap_FindSuitableBlock(heap, firstLevel, secondLevel);
+    if (block == NULL && heap->arena != NULL) {
+        const size_t neededLength = searchSize + searchSize / 4 + 2 * HEAP_BLOCK_OVERHEAD + HEAP_ALIGN_SIZE;
+        const size_t regionLength = neededLength > heap->growSize ? neededLength : heap->growSize;
+        void *memory = LC_AllocateAndAlignArenaNoZero(heap->arena, regionLength, HEAP_ALIGN_SIZE);
+        if (memory != NULL && LC_Heap_AddRegion(heap, memory, regionLength)) {
+            block = LC_Heap_FindSuitableBlock(heap, firstLevel, secondLevel);
+        }
+    }
+    if (block == NULL) return NULL;
+    LC_Heap_RemoveFreeBlock(heap, block);
+
+    if (align > HEAP_ALIGN_SIZE) {
+        const uintptr_t payload = (uintptr_t) LC_HeapBlock_GetPayload(block);
+        uintptr_t aligned = LC_AlignForward(payload, align);
+        if (aligned != payload && aligned - payload < gapMinimum) {
+            aligned = LC_AlignForward(payload + gapMinimum, align);
+        }
+        const size_t gap = aligned - payload;
+        if (gap != 0) {
+            // the leading gap becomes a free block of its own, its predecessor is used so nothing merges
+            LC_HeapBlock *alignedBlock = (LC_HeapBlock *) (aligned - HEAP_BLOCK_OVERHEAD);
+            alignedBlock->size = LC_HeapBlock_GetSize(block) - gap;
+            LC_HeapBlock_SetSize(block, gap - HEAP_BLOCK_OVERHEAD);
+            alignedBlock->previousPhysical = block;
+            LC_HeapBlock_SetFree(block, true);
+            LC_Heap_InsertFreeBlock(heap, block);
+            LC_HeapBlock_GetNext(alignedBlock)->previousPhysical = alignedBlock;
+            block = alignedBlock;
+        }
+    }
+
+    LC_HeapBlock_SetFree(block, false);
+    LC_Heap_TrimBlock(heap, block, adjustedSize);
+
+    heap->usedBytes += LC_HeapBlock_GetSize(block);
+    heap->usedBlockCount++;
+
+    // The whole block is cleared, a zeroing resize relies on the slack past 'size' being clean
+    void *pointer = LC_HeapBlock_GetPayload(block);
+    if (zero) memset(pointer, 0, LC_HeapBlock_GetSize(block));
+    return pointer;
+}
+
+void* LC_Heap_AllocateAndAlign(LC_Heap *heap, const size_t size, const size_t align) {
+    return LC_Heap_AllocateInternal(heap, size, align, true);
+}
+
+void* LC_Heap_Allocate(LC_Heap *heap, const size_t size) {
+    return LC_Heap_AllocateInternal(heap, size, DEFAULT_ALIGNMENT, true);
+}
+
+void* LC_Heap_AllocateNoZero(LC_Heap *heap, const size_t size) {
+    return LC_Heap_AllocateInternal(heap, size, DEFAULT_ALIGNMENT, false);
+}
+
+void LC_Heap_Free(LC_Heap *heap, void *pointer) {
+    if (pointer == NULL) return;
+
+    LC_HeapBlock *block = LC_HeapBlock_FromPayload(pointer);
+    assert(!LC_HeapBlock_IsFree(block) && "Heap block freed twice");
+    heap->usedBytes -= LC_HeapBlock_GetSize(block);
+    heap->usedBlockCount--;
+
+    // merge with the physical neighbours, free blocks are never adjacent so there is at most one on each side
+    if (block->size & HEAP_BLOCK_PREVIOUS_FREE_BIT) {
+        LC_HeapBlock *previous = block->previousPhysical;
+        LC_Heap_RemoveFreeBlock(heap, previous);
+        LC_HeapBlock_SetSize(previous, LC_HeapBlock_GetSize(previous) + LC_HeapBlock_GetSize(block) + HEAP_BLOCK_OVERHEAD);
+        block = previous;
+    }
+    LC_HeapBlock *next = LC_HeapBlock_GetNext(block);
+    if (LC_HeapBlock_IsFree(next)) {
+        LC_Heap_RemoveFreeBlock(heap, next);
+        LC_HeapBlock_SetSize(block, LC_HeapBlock_GetSize(block) + LC_HeapBlock_GetSize(next) + HEAP_BLOCK_OVERHEAD);
+    }
+
+    LC_HeapBlock_SetFree(block, true);
+    LC_Heap_InsertFreeBlock(heap, block);
+}
+
+// With 'zero' every byte of the block past 'newSize' is clean afterwards, so the block capacity never hides stale data
+static void* LC_Heap_ResizeInternal(LC_Heap *heap, void *oldMemory, const size_t newSize, const bool zero) {
+    if (oldMemory == NULL) return LC_Heap_AllocateInternal(heap, newSize, DEFAULT_ALIGNMENT, zero);
+    if (newSize == 0) {
+        LC_Heap_Free(heap, oldMemory);
+        return NULL;
+    }
+
+    LC_HeapBlock *block = LC_HeapBlock_FromPayload(oldMemory);
+    const size_t oldSize = LC_HeapBlock_GetSize(block);
+    size_t adjustedSize = LC_AlignForward(newSize, HEAP_ALIGN_SIZE);
+    if (adjustedSize < HEAP_MINIMUM_BLOCK_SIZE) adjustedSize = HEAP_MINIMUM_BLOCK_SIZE;
+
+    // Grow in place by swallowing a free successor when it is big enough
+    LC_HeapBlock *next = LC_HeapBlock_GetNext(block);
+    if (adjustedSize > oldSize && LC_HeapBlock_IsFree(next) &&
+        oldSize + HEAP_BLOCK_OVERHEAD + LC_HeapBlock_GetSize(next) >= adjustedSize) {
+        LC_Heap_RemoveFreeBlock(heap, next);
+        LC_HeapBlock_SetSize(block, oldSize + HEAP_BLOCK_OVERHEAD + LC_HeapBlock_GetSize(next));
+        LC_HeapBlock_SetFree(block, false);
+    }
+
+    if (LC_HeapBlock_GetSize(block) >= adjustedSize) {
+        LC_Heap_TrimBlock(heap, block, adjustedSize);
+        const size_t capacity = LC_HeapBlock_GetSize(block);
+        heap->usedBytes += capacity;
+        heap->usedBytes -= oldSize;
+        if (zero) {
+            // a shrink leaves the released bytes behind in the block, a grow brings in the free successor's
+            const size_t clearFrom = newSize < oldSize ? newSize : oldSize;
+            memset((uchar *) oldMemory + clearFrom, 0, capacity - clearFrom);
+        }
+        return oldMemory;
+    }
+
+    void *newMemory = LC_Heap_AllocateInternal(heap, newSize, DEFAULT_ALIGNMENT, false);
+    if (newMemory == NULL) return NULL;
+    memcpy(newMemory, oldMemory, oldSize);
+    if (zero) memset((uchar *) newMemory + oldSize, 0, LC_Heap_GetAllocationSize(newMemory) - oldSize);
+    LC_Heap_Free(heap, oldMemory);
+
+    return newMemory;
+}
+
+void* LC_Heap_Resize(LC_Heap *heap, void *oldMemory, const size_t newSize) {
+    return LC_Heap_ResizeInternal(heap, oldMemory, newSize, true);
+}
+
+size_t LC_Heap_GetAllocationSize(const void *pointer) {
+    return LC_HeapBlock_GetSize(LC_HeapBlock_FromPayload(pointer));
+}
+
+void LC_Heap_GetStats(const LC_Heap *heap, LC_HeapStats *stats) {
+    stats->totalBytes = heap->totalBytes;
+    stats->usedBytes = heap->usedBytes;
+    stats->usedBlockCount = heap->usedBlockCount;
+    stats->freeBlockCount = heap->freeBlockCount;
+    stats->regionCount = heap->regionCount;
+    stats->largestFreeBlock = 0;
+
+    // Block headers are not payload, so whatever is neither used nor overhead is free
+    stats->freeBytes = heap->totalBytes - heap->usedBytes -
+                       (heap->usedBlockCount + heap->freeBlockCount - heap->regionCount) * HEAP_BLOCK_OVERHEAD;
+
+    // the largest free block lives in the highest non-empty class, only that one list has to be walked
+    if (heap->firstLevelBitmap != 0) {
+        const uint32 firstLevel = LC_Heap_FindLastSet(heap->firstLevelBitmap);
+        const uint32 secondLevel = LC_Heap_FindLastSet(heap->secondLevelBitmap[firstLevel]);
+        for (const LC_HeapBlock *block = heap->freeLists[firstLevel][secondLevel]; block != NULL; block = block->nextFree) {
+            if (LC_HeapBlock_GetSize(block) > stats->largestFreeBlock) stats->largestFreeBlock = LC_HeapBlock_GetSize(block);
+        }
+    }
+    stats->fragmentation = stats->freeBytes > 0 ? 1.0f - (float) stats->largestFreeBlock / (float) stats->freeBytes : 0.0f;
+}
+
+// ===================================================================================================================
+// Allocator Interface
+// ===================================================================================================================
+
+static void* LC_Allocator_MallocAllocate(void *userData, const size_t size, const size_t align) {
+    (void)userData;
+    // malloc only guarantees fundamental alignment
+    assert(align <= DEFAULT_ALIGNMENT);
+    return malloc(size);
+}
+
+static void* LC_Allocator_MallocResize(void *userData, void *oldMemory, const size_t oldSize, const size_t newSize,
+                                       const size_t align) {
+    (void)userData;
+    (void)oldSize;
+    assert(align <= DEFAULT_ALIGNMENT);
+    return realloc(oldMemory, newSize);
+}
+
+static void LC_Allocator_MallocFree(void *userData, void *memory, const size_t size) {
+    (void)userData;
+    (void)size;
+    free(memory);
+}
+
+LC_Allocator LC_Allocator_Malloc(void) {
+    LC_Allocator allocator;
+    allocator.allocate = LC_Allocator_MallocAllocate;
+    allocator.resize = LC_Allocator_MallocResize;
+    allocator.free = LC_Allocator_MallocFree;
+    allocator.userData = NULL;
+
+    return allocator;
+}
+
+static void* LC_Allocator_ArenaAllocate(void *userData, const size_t size, const size_t align) {
+    return LC_AllocateAndAlignArenaNoZero(userData, size, align);
+}
+
+static void* LC_Allocator_ArenaResize(void *userData, void *oldMemory, const size_t oldSize, const size_t newSize,
+                                      const size_t align) {
+    return LC_Arena_ResizeAndAlignNoZero(userData, oldMemory, oldSize, newSize, align);
+}
+
+static void LC_Allocator_ArenaFree(void *userData, void *memory, const size_t size) {
+    (void)size;
+    LC_Arena_Free(userData, memory);
+}
+
+LC_Allocator LC_Allocator_FromArena(LC_Arena *arena) {
+    LC_Allocator allocator;
+    allocator.allocate = LC_Allocator_ArenaAllocate;
+    allocator.resize = LC_Allocator_ArenaResize;
+    allocator.free = LC_Allocator_ArenaFree;
+    allocator.userData = arena;
+
+    return allocator;
+}
+
+static void* LC_Allocator_HeapAllocate(void *userData, const size_t size, const size_t align) {
+    return LC_Heap_AllocateInternal(userData, size, align, false);
+}
+
+static void* LC_Allocator_HeapResize(void *userData, void *oldMemory, const size_t oldSize, const size_t newSize,
+                                     const size_t align) {
+    if (align <= DEFAULT_ALIGNMENT || oldMemory == NULL) {
+        return oldMemory == NULL ? LC_Heap_AllocateInternal(userData, newSize, align, false) :
+               LC_Heap_ResizeInternal(userData, oldMemory, newSize, false);
+    }
+    // LC_Heap_ResizeInternal only keeps the default alignment when it has to move the memory
+    void *newMemory = LC_Heap_AllocateInternal(userData, newSize, align, false);
+    if (newMemory == NULL) return NULL;
+    memcpy(newMemory, oldMemory, oldSize < newSize ? oldSize : newSize);
+    LC_Heap_Free(userData, oldMemory);
+
+    return newMemory;
+}
+
+static void LC_Allocator_HeapFree(void *userData, void *memory, const size_t size) {
+    (void)size;
+    LC_Heap_Free(userData, memory);
+}
+
+LC_Allocator LC_Allocator_FromHeap(LC_Heap *heap) {
+    LC_Allocator allocator;
+    allocator.allocate = LC_Allocator_HeapAllocate;
+    allocator.resize = LC_Allocator_HeapResize;
+    allocator.free = LC_Allocator_HeapFree;
+    allocator.userData = heap;
+
+    return allocator;
+}
+
+static void* LC_Allocator_PoolAllocate(void *userData, const size_t size, const size_t align) {
+    const LC_Pool *pool = userData;
+    if (size > pool->slotSize || align > pool->slotAlignment) return NULL;
+    return LC_Pool_Allocate(userData);
+}
+
+static void* LC_Allocator_PoolResize(void *userData, void *oldMemory, const size_t oldSize, const size_t newSize,
+                                     const size_t align) {
+    (void)oldSize;
+    const LC_Pool *pool = userData;
+    // every slot has the same size, a resize either still fits or cannot be satisfied
+    if (newSize > pool->slotSize || align > pool->slotAlignment) return NULL;
+    return oldMemory != NULL ? oldMemory : LC_Pool_Allocate(userData);
+}
+
+static void LC_Allocator_PoolFree(void *userData, void *memory, const size_t size) {
+    (void)size;
+    LC_Pool_Free(userData, memory);
+}
+
+LC_Allocator LC_Allocator_FromPool(LC_Pool *pool) {
+    LC_Allocator allocator;
+    allocator.allocate = LC_Allocator_PoolAllocate;
+    allocator.resize = LC_Allocator_PoolResize;
+    allocator.free = LC_Allocator_PoolFree;
+    allocator.userData = pool;
+
+    return allocator;
+}
+
+static void* LC_Allocator_TrackingAllocate(void *userData, const size_t size, const size_t align) {
+    LC_TrackingAllocator *tracking = userData;
+    void *memory = tracking->parent.allocate(tracking->parent.userData, size, align);
+    if (memory == NULL) return NULL;
+
+    tracking->allocationCount++;
+    tracking->currentBytes += size;
+    if (tracking->currentBytes > tracking->peakBytes) tracking->peakBytes = tracking->currentBytes;
+
+    return memory;
+}
+
+static void* LC_Allocator_TrackingResize(void *userData, void *oldMemory, const size_t oldSize, const size_t newSize,
+                                         const size_t align) {
+    LC_TrackingAllocator *tracking = userData;
+    void *memory = tracking->parent.resize(tracking->parent.userData, oldMemory, oldSize, newSize, align);
+    if (memory == NULL) return NULL;
+
+    if (oldMemory == NULL) tracking->allocationCount++;
+    tracking->currentBytes = tracking->currentBytes - oldSize + newSize;
+    if (tracking->currentBytes > tracking->peakBytes) tracking->peakBytes = tracking->currentBytes;
+
+    return memory;
+}
+
+static void LC_Allocator_TrackingFree(void *userData, void *memory, const size_t size) {
+    LC_TrackingAllocator *tracking = userData;
+    if (memory == NULL) return;
+
+    tracking->parent.free(tracking->parent.userData, memory, size);
+    tracking->freeCount++;
+    tracking->currentBytes -= size;
+}
+
+LC_Allocator LC_Allocator_Tracking(LC_TrackingAllocator *tracking, const LC_Allocator parent, const char *name) {
+    tracking->parent = parent;
+    tracking->name = name;
+    tracking->currentBytes = 0;
+    tracking->peakBytes = 0;
+    tracking->allocationCount = 0;
+    tracking->freeCount = 0;
+
+    LC_Allocator allocator;
+    allocator.allocate = LC_Allocator_TrackingAllocate;
+    allocator.resize = LC_Allocator_TrackingResize;
+    allocator.free = LC_Allocator_TrackingFree;
+    allocator.userData = tracking;
+
+    return allocator;
+}
+
+void* LC_Allocator_Allocate(const LC_Allocator *allocator, const size_t size, const size_t align) {
+    void *memory = allocator->allocate(allocator->userData, size, align);
+    // zero new memory by default, the same as the arena
+    if (memory != NULL) memset(memory, 0, size);
+    return memory;
+}
+
+void* LC_Allocator_AllocateNoZero(const LC_Allocator *allocator, const size_t size, const size_t align) {
+    return allocator->allocate(allocator->userData, size, align);
+}
+
+void* LC_Allocator_Resize(const LC_Allocator *allocator, void *oldMemory, const size_t oldSize, const size_t newSize,
+                          const size_t align) {
+    void *memory = allocator->resize(allocator->userData, oldMemory, oldSize, newSize, align);
+    if (memory != NULL && newSize > oldSize) memset((uchar *) memory + oldSize, 0, newSize - oldSize);
+    return memory;
+}
+
+void* LC_Allocator_ResizeNoZero(const LC_Allocator *allocator, void *oldMemory, const size_t oldSize,
+                                const size_t newSize, const size_t align) {
+    return allocator->resize(allocator->userData, oldMemory, oldSize, newSize, align);
+}
+
+void LC_Allocator_Free(const LC_Allocator *allocator, void *memory, const size_t size) {
+    if (memory == NULL) return;
+    allocator->free(allocator->userData, memory, size);
+}
+
+// ===================================================================================================================
+// File Operations
+// ===================================================================================================================
+
+void LC_GetFileContentString(LC_Arena *arena, const char *filePath, char **fileContents) {
+    // the contents are overwritten right away, so the arena does not need to clear them first
+    const LC_Allocator allocator = LC_Allocator_FromArena(arena);
+    size_t allocationSize;
+    LC_GetFileContentStringWithAllocator(&allocator, filePath, fileContents, &allocationSize);
+}
+
+bool LC_GetFileContentBinary(LC_Arena *arena, const char *filePath, uchar **fileContents, size_t *fileSize, char *errorLog) {
+    const LC_Allocator allocator = LC_Allocator_FromArena(arena);
+    return LC_GetFileContentBinaryWithAllocator(&allocator, filePath, fileContents, fileSize, errorLog);
+}
+
+bool LC_File_Map(LC_FileView *view, const char *filePath, const uint32 hints, char *errorLog) {
+    view->data = NULL;
+    view->length = 0;
+    view->_isMapped = false;
+    if (filePath == NULL) return false;
+
+    void *data;
+    size_t length;
+    bool isMapped;
+#ifdef _WIN32
+    const bool success = LC_Win32_MapFile(filePath, hints, &data, &length, &isMapped);
+#elif __linux__
+    const bool success = LC_Linux_MapFile(filePath, hints, &data, &length, &isMapped);
+#else
+    (void)hints;
+    isMapped = false;
+    bool success = false;
+    FILE *file = fopen(filePath, "rb");
+    if (file != NULL) {
+        fseek(file, 0, SEEK_END);
+        length = (size_t) ftell(file);
+        fseek(file, 0, SEEK_SET);
+        data = malloc(length > 0 ? length : 1);
+        success = data != NULL && fread(data, 1, length, file) == length;
+        if (!success) free(data);
+        fclose(file);
+    }
+#endif
+    if (!success) {
+        if (errorLog != NULL) snprintf(errorLog, 1024, "Could not open or read file: %s", filePath);
+        return false;
+    }
+
+    view->data = data;
+    view->length = length;
+    view->_isMapped = isMapped;
+    return true;
+}
+
+void LC_File_Unmap(LC_FileView *view) {
+    if (view->data != NULL) {
+#ifdef _WIN32
+        LC_Win32_UnmapFile((void *) view->data, view->length, view->_isMapped);
+#elif __linux__
+        LC_Linux_UnmapFile((void *) view->data, view->length, view->_isMapped);
+#else
+        free((void *) view->data);
+#endif
+    }
+    view->data = NULL;
+    view->length = 0;
+    view->_isMapped = false;
+}
+
+void LC_GetFileContentStringWithAllocator(const LC_Allocator *allocator, const char *filePath, char **fileContents,
+                                          size_t *allocationSize) {
+    *allocationSize = 0;
+
+    LC_FileView view;
+    if (!LC_File_Map(&view, filePath, LC_FILE_HINT_SEQUENTIAL, NULL)) return;
+
+    // One copy out of the page cache, with room for the null terminating character '\0' at the end
+    *fileContents = LC_Allocator_AllocateNoZero(allocator, view.length + 1, DEFAULT_ALIGNMENT);
+    if (*fileContents != NULL) {
+        if (view.length > 0) memcpy(*fileContents, view.data, view.length);
+        (*fileContents)[view.length] = '\0';
+        *allocationSize = view.length + 1;
+    }
+
+    LC_File_Unmap(&view);
+}
+
+bool LC_GetFileContentBinaryWithAllocator(const LC_Allocator *allocator, const char *filePath, uchar **fileContents,
+                                          size_t *fileSize, char *errorLog) {
+    *fileSize = 0;
+
+    LC_FileView view;
+    if (!LC_File_Map(&view, filePath, LC_FILE_HINT_SEQUENTIAL, NULL)) {
+        snprintf(errorLog, 1024, "File not found: %s", filePath);
+        return false;
+    }
+
+    *fileContents = LC_Allocator_AllocateNoZero(allocator, view.length, DEFAULT_ALIGNMENT);
+    if (*fileContents == NULL) {
+        LC_File_Unmap(&view);
+        snprintf(errorLog, 1024, "Memory allocation failed: %s", filePath);
+        return false;
+    }
+    if (view.length > 0) memcpy(*fileContents, view.data, view.length);
+    *fileSize = view.length;
+
+    LC_File_Unmap(&view);
+    return true;
+}
+
+// ASYNC LOADING
+// Opening a file and finding its size stay synchronous on the submitting thread, they are answered from the inode
+// cache and the arena can only be used from one thread. Only the reads, which wait on the disk, are handed off.
+static constexpr uint64 FILE_LOADER_MAX_READ_SIZE = 1u << 30;
+
+static void LC_FileLoader_PushPending(LC_FileLoader *loader, LC_FileRequest *request) {
+    request->_next = NULL;
+    if (loader->_pendingTail != NULL) loader->_pendingTail->_next = request;
+    else loader->_pendingHead = request;
+    loader->_pendingTail = request;
+}
+
+static LC_FileRequest* LC_FileLoader_PopPending(LC_FileLoader *loader) {
+    LC_FileRequest *request = loader->_pendingHead;
+    if (request == NULL) return NULL;
+    loader->_pendingHead = request->_next;
+    if (loader->_pendingHead == NULL) loader->_pendingTail = NULL;
+    return request;
+}
+
+static void LC_FileLoader_PushCompleted(LC_FileLoader *loader, LC_FileRequest *request) {
+    request->_next = NULL;
+    if (loader->_completedTail != NULL) loader->_completedTail->_next = request;
+    else loader->_completedHead = request;
+    loader->_completedTail = request;
+}
+
+static FILE* LC_File_OpenForReading(const char *filePath, uint64 *size) {
+    FILE *file = fopen(filePath, "rb");
+    if (file == NULL) return NULL;
+#ifdef _WIN32
+    const bool success = _fseeki64(file, 0, SEEK_END) == 0;
+    const int64 end = success ? _ftelli64(file) : -1;
+    if (end < 0 || _fseeki64(file, 0, SEEK_SET) != 0) {
+#else
+    const bool success = fseeko(file, 0, SEEK_END) == 0;
+    const int64 end = success ? (int64) ftello(file) : -1;
+    if (end < 0 || fseeko(file, 0, SEEK_SET) != 0) {
+#endif
+        fclose(file);
+        return NULL;
+    }
+    *size = (uint64) end;
+    return file;
+}
+
+static void LC_FileRequest_Close(LC_FileRequest *request) {
+#ifdef __linux__
+    if (request->_fileDescriptor >= 0) LC_Linux_CloseFile(request->_fileDescriptor);
+#endif
+    if (request->_file != NULL) fclose(request->_file);
+    request->_fileDescriptor = -1;
+    request->_file = NULL;
+}
+
+#ifdef __linux__
+// Hands pending reads to the ring until it or the completion budget is full. A file is read in pieces of at most 1 GB
+// because a single read can't be larger than 2 GB.
+static void LC_FileLoader_FillRing(LC_FileLoader *loader) {
+    while (loader->_pendingHead != NULL && loader->_inFlight < LC_FILE_LOADER_QUEUE_DEPTH) {
+        LC_FileRequest *request = loader->_pendingHead;
+        const uint64 remaining = request->length - request->_bytesRead;
+        const uint32 readSize = (uint32) (remaining < FILE_LOADER_MAX_READ_SIZE ? remaining : FILE_LOADER_MAX_READ_SIZE);
+        if (!LC_Linux_IoRing_QueueRead(loader->_ring, request->_fileDescriptor, request->data + request->_bytesRead,
+                                       readSize, request->_bytesRead, (uint64) (uintptr_t) request)) break;
+        LC_FileLoader_PopPending(loader);
+        loader->_inFlight++;
+    }
+    LC_Linux_IoRing_Submit(loader->_ring, 0);
+}
+
+static void LC_FileLoader_ReapRing(LC_FileLoader *loader) {
+    uint64 userData;
+    int32 result;
+    while (LC_Linux_IoRing_PopCompletion(loader->_ring, &userData, &result)) {
+        loader->_inFlight--;
+        LC_FileRequest *request = (LC_FileRequest *) (uintptr_t) userData;
+        if (result == -EAGAIN || result == -EINTR) {
+            LC_FileLoader_PushPending(loader, request);
+            continue;
+        }
+        // A read of nothing before the end means the file was truncated after its size was taken
+        if (result <= 0) {
+            request->_hasFailed = true;
+            LC_FileLoader_PushCompleted(loader, request);
+            continue;
+        }
+        request->_bytesRead += (uint64) result;
+        if (request->_bytesRead < request->length) LC_FileLoader_PushPending(loader, request);
+        else LC_FileLoader_PushCompleted(loader, request);
+    }
+}
+#endif
+
+static int LC_FileLoader_Worker(void *data) {
+    LC_FileLoader *loader = data;
+    SDL_LockMutex(loader->_mutex);
+    for (;;) {
+        while (loader->_pendingHead == NULL && !loader->_isShuttingDown) {
+            SDL_WaitCondition(loader->_workAvailable, loader->_mutex);
+        }
+        // Work that was queued before the shutdown is still finished
+        LC_FileRequest *request = LC_FileLoader_PopPending(loader);
+        if (request == NULL) break;
+        SDL_UnlockMutex(loader->_mutex);
+
+        // fread takes a size_t, the arena allocation already made sure the length fits into one
+        const size_t bytesRead = fread(request->data, 1, (size_t) request->length, request->_file);
+        request->_bytesRead = bytesRead;
+        request->_hasFailed = bytesRead != request->length;
+
+        SDL_LockMutex(loader->_mutex);
+        LC_FileLoader_PushCompleted(loader, request);
+        SDL_SignalCondition(loader->_workCompleted);
+    }
+    SDL_UnlockMutex(loader->_mutex);
+    return 0;
+}
+
+bool LC_FileLoader_Initialize(LC_FileLoader *loader, const LC_FileLoaderBackend backend, uint32 threadCount) {
+    memset(loader, 0, sizeof(*loader));
+#ifdef __linux__
+    if (backend == LC_FILE_LOADER_BACKEND_DEFAULT) {
+        loader->_ring = LC_Linux_IoRing_Create(LC_FILE_LOADER_QUEUE_DEPTH);
+        if (loader->_ring != NULL) return true;
+    }
+#else
+    (void)backend;
+#endif
+
+    loader->_mutex = SDL_CreateMutex();
+    loader->_workAvailable = SDL_CreateCondition();
+    loader->_workCompleted = SDL_CreateCondition();
+    if (loader->_mutex == NULL || loader->_workAvailable == NULL || loader->_workCompleted == NULL) {
+        LC_FileLoader_Destroy(loader);
+        return false;
+    }
+
+    if (threadCount == 0) threadCount = (uint32) SDL_GetNumLogicalCPUCores();
+    if (threadCount == 0) threadCount = 1;
+    if (threadCount > LC_FILE_LOADER_MAX_THREADS) threadCount = LC_FILE_LOADER_MAX_THREADS;
+    for (uint32 i = 0; i < threadCount; i++) {
+        loader->_threads[i] = SDL_CreateThread(LC_FileLoader_Worker, "LC_FileLoader", loader);
+        if (loader->_threads[i] == NULL) break;
+        loader->_threadCount++;
+    }
+    if (loader->_threadCount == 0) {
+        LC_FileLoader_Destroy(loader);
+        return false;
+    }
+    return true;
+}
+
+bool LC_FileLoader_Submit(LC_FileLoader *loader, LC_FileBatch *batch, LC_Arena *arena, const char *const *filePaths,
+                          const uint32 count, const LC_FileLoadedFunction onLoaded, void *userData) {
+    memset(batch, 0, sizeof(*batch));
+    batch->onLoaded = onLoaded;
+    batch->userData = userData;
+    if (count == 0) return true;
+
+    batch->requests = LC_AllocateAndAlignArena(arena, count * sizeof(LC_FileRequest), alignof(LC_FileRequest));
+    if (batch->requests == NULL) return false;
+    batch->count = count;
+    batch->remaining = count;
+
+    SDL_LockMutex(loader->_mutex);
+    for (uint32 i = 0; i < count; i++) {
+        LC_FileRequest *request = &batch->requests[i];
+        request->path = filePaths[i];
+        request->batch = batch;
+        request->status = LC_FILE_REQUEST_PENDING;
+        request->_fileDescriptor = -1;
+
+        bool isOpen;
+#ifdef __linux__
+        if (loader->_ring != NULL) {
+            isOpen = LC_Linux_OpenFileForReading(request->path, &request->_fileDescriptor, &request->length);
+        } else
+#endif
+        {
+            request->_file = LC_File_OpenForReading(request->path, &request->length);
+            isOpen = request->_file != NULL;
+        }
+
+        // One extra byte for the null terminating character '\0'
+        if (isOpen && request->length < SIZE_MAX) {
+            request->data = LC_AllocateAndAlignArenaNoZero(arena, (size_t) request->length + 1, DEFAULT_ALIGNMENT);
+        }
+        if (request->data == NULL) {
+            request->_hasFailed = true;
+            LC_FileLoader_PushCompleted(loader, request);
+        } else if (request->length == 0) {
+            LC_FileLoader_PushCompleted(loader, request);
+        } else {
+            LC_FileLoader_PushPending(loader, request);
+        }
+    }
+    if (loader->_threadCount > 0) SDL_BroadcastCondition(loader->_workAvailable);
+    SDL_UnlockMutex(loader->_mutex);
+
+#ifdef __linux__
+    if (loader->_ring != NULL) LC_FileLoader_FillRing(loader);
+#endif
+    return true;
+}
+
+uint32 LC_FileLoader_Poll(LC_FileLoader *loader) {
+#ifdef __linux__
+    if (loader->_ring != NULL) {
+        LC_FileLoader_ReapRing(loader);
+        // Reads that came back short continue right away, before the callbacks run
+        LC_FileLoader_FillRing(loader);
+    }
+#endif
+
+    SDL_LockMutex(loader->_mutex);
+    LC_FileRequest *request = loader->_completedHead;
+    loader->_completedHead = NULL;
+    loader->_completedTail = NULL;
+    SDL_UnlockMutex(loader->_mutex);
+
+    uint32 finishedCount = 0;
+    while (request != NULL) {
+        // The callback may submit new work, which reuses the link
+        LC_FileRequest *next = request->_next;
+        LC_FileRequest_Close(request);
+
+        LC_FileBatch *batch = request->batch;
+        if (request->_hasFailed) {
+            request->status = LC_FILE_REQUEST_FAILED;
+            batch->failedCount++;
+        } else {
+            request->data[request->length] = '\0';
+            request->status = LC_FILE_REQUEST_LOADED;
+        }
+        batch->remaining--;
+        if (batch->onLoaded != NULL) batch->onLoaded(request, batch->userData);
+
+        finishedCount++;
+        request = next;
+    }
+    return finishedCount;
+}
+
+bool LC_FileBatch_IsDone(const LC_FileBatch *batch) {
+    return batch->remaining == 0;
+}
+
+void LC_FileLoader_Wait(LC_FileLoader *loader, const LC_FileBatch *batch) {
+    while (!LC_FileBatch_IsDone(batch)) {
+        if (LC_FileLoader_Poll(loader) > 0) continue;
+
+#ifdef __linux__
+        if (loader->_ring != NULL) {
+            if (loader->_inFlight > 0 && !LC_Linux_IoRing_Submit(loader->_ring, 1)) SDL_Delay(1);
+            continue;
+        }
+#endif
+        SDL_LockMutex(loader->_mutex);
+        while (loader->_completedHead == NULL) SDL_WaitCondition(loader->_workCompleted, loader->_mutex);
+        SDL_UnlockMutex(loader->_mutex);
+    }
+}
+
+void LC_FileLoader_Destroy(LC_FileLoader *loader) {
+#ifdef __linux__
+    if (loader->_ring != NULL) {
+        while (loader->_inFlight > 0 || loader->_pendingHead != NULL) {
+            LC_FileLoader_ReapRing(loader);
+            LC_FileLoader_FillRing(loader);
+            if (loader->_inFlight > 0 && !LC_Linux_IoRing_Submit(loader->_ring, 1)) SDL_Delay(1);
+        }
+        LC_Linux_IoRing_Destroy(loader->_ring);
+        loader->_ring = NULL;
+    }
+#endif
+
+    if (loader->_threadCount > 0) {
+        SDL_LockMutex(loader->_mutex);
+        loader->_isShuttingDown = true;
+        SDL_BroadcastCondition(loader->_workAvailable);
+        SDL_UnlockMutex(loader->_mutex);
+        for (uint32 i = 0; i < loader->_threadCount; i++) SDL_WaitThread(loader->_threads[i], NULL);
+        loader->_threadCount = 0;
+    }
+
+    // Closes the files of everything that finished but was never polled
+    LC_FileLoader_Poll(loader);
+
+    if (loader->_workCompleted != NULL) SDL_DestroyCondition(loader->_workCompleted);
+    if (loader->_workAvailable != NULL) SDL_DestroyCondition(loader->_workAvailable);
+    if (loader->_mutex != NULL) SDL_DestroyMutex(loader->_mutex);
+    loader->_workCompleted = NULL;
+    loader->_workAvailable = NULL;
+    loader->_mutex = NULL;
+}
+
+bool LC_File_LoadAll(LC_Arena *arena, const char *const *filePaths, const uint32 count, LC_FileBatch *batch) {
+    memset(batch, 0, sizeof(*batch));
+    // The count is also the thread count, so nothing to load would start a thread per core otherwise
+    if (count == 0) return true;
+
+    LC_FileLoader loader;
+    if (!LC_FileLoader_Initialize(&loader, LC_FILE_LOADER_BACKEND_DEFAULT, count)) return false;
+
+    const bool isSubmitted = LC_FileLoader_Submit(&loader, batch, arena, filePaths, count, nullptr, nullptr);
+    if (isSubmitted) LC_FileLoader_Wait(&loader, batch);
+    LC_FileLoader_Destroy(&loader);
+    return isSubmitted && batch->failedCount == 0;
+}
+
+// STREAMING
+// Each buffer is either full, waiting for the caller, or free for the reader. The reader fills them alternately and
+// the caller takes them in the same order, so neither ever has to look at the other buffer.
+static int LC_FileStream_ReadAhead(void *data) {
+    LC_FileStream *stream = data;
+    uint32 writeIndex = 0;
+    for (;;) {
+        SDL_LockMutex(stream->_mutex);
+        while (stream->_isFull[writeIndex] && !stream->_isShuttingDown) {
+            SDL_WaitCondition(stream->_chunkReleased, stream->_mutex);
+        }
+        const bool isShuttingDown = stream->_isShuttingDown;
+        SDL_UnlockMutex(stream->_mutex);
+        if (isShuttingDown) break;
+
+        const size_t length = fread(stream->_buffers[writeIndex], 1, stream->chunkSize, stream->_file);
+        const bool isLastChunk = length < stream->chunkSize;
+
+        SDL_LockMutex(stream->_mutex);
+        stream->_lengths[writeIndex] = length;
+        stream->_isFull[writeIndex] = length > 0;
+        if (isLastChunk) {
+            stream->_isReaderDone = true;
+            stream->hasFailed = ferror((FILE *) stream->_file) != 0;
+        }
+        SDL_SignalCondition(stream->_chunkFilled);
+        SDL_UnlockMutex(stream->_mutex);
+
+        if (isLastChunk) break;
+        writeIndex ^= 1;
+    }
+    return 0;
+}
+
+bool LC_FileStream_Open(LC_FileStream *stream, LC_Arena *arena, const char *filePath, size_t chunkSize,
+                        char *errorLog) {
+    memset(stream, 0, sizeof(*stream));
+    if (chunkSize == 0) chunkSize = LC_FILE_STREAM_DEFAULT_CHUNK_SIZE;
+    stream->chunkSize = chunkSize;
+
+    // Pipes can't report a size but can still be streamed
+    FILE *file = LC_File_OpenForReading(filePath, &stream->fileSize);
+    if (file == NULL) file = fopen(filePath, "rb");
+    if (file == NULL) {
+        if (errorLog != NULL) snprintf(errorLog, 1024, "Could not open file: %s", filePath);
+        return false;
+    }
+    // Chunks are at least as large as the stdio buffer, so it would only add a copy
+    setvbuf(file, NULL, _IONBF, 0);
+    stream->_file = file;
+
+    stream->_buffers[0] = LC_AllocateAndAlignArenaNoZero(arena, chunkSize, 64);
+    stream->_buffers[1] = LC_AllocateAndAlignArenaNoZero(arena, chunkSize, 64);
+    if (stream->_buffers[0] == NULL || stream->_buffers[1] == NULL) {
+        if (errorLog != NULL) snprintf(errorLog, 1024, "Memory allocation failed: %s", filePath);
+        LC_FileStream_Close(stream);
+        return false;
+    }
+
+    stream->_mutex = SDL_CreateMutex();
+    stream->_chunkFilled = SDL_CreateCondition();
+    stream->_chunkReleased = SDL_CreateCondition();
+    if (stream->_mutex != NULL && stream->_chunkFilled != NULL && stream->_chunkReleased != NULL) {
+        stream->_thread = SDL_CreateThread(LC_FileStream_ReadAhead, "LC_FileStream", stream);
+    }
+    if (stream->_thread == NULL) {
+        if (errorLog != NULL) snprintf(errorLog, 1024, "Could not start the read-ahead thread: %s", filePath);
+        LC_FileStream_Close(stream);
+        return false;
+    }
+    return true;
+}
+
+bool LC_FileStream_Next(LC_FileStream *stream, const uchar **chunk, size_t *length) {
+    *chunk = NULL;
+    *length = 0;
+
+    SDL_LockMutex(stream->_mutex);
+    // The previous chunk goes back to the reader
+    if (stream->_isHoldingChunk) {
+        stream->_isFull[stream->_readIndex] = false;
+        stream->_isHoldingChunk = false;
+        stream->_readIndex ^= 1;
+        SDL_SignalCondition(stream->_chunkReleased);
+    }
+
+    const uint32 readIndex = stream->_readIndex;
+    while (!stream->_isFull[readIndex] && !stream->_isReaderDone) {
+        SDL_WaitCondition(stream->_chunkFilled, stream->_mutex);
+    }
+    const bool hasChunk = stream->_isFull[readIndex];
+    if (hasChunk) {
+        stream->_isHoldingChunk = true;
+        *chunk = stream->_buffers[readIndex];
+        *length = stream->_lengths[readIndex];
+        stream->offset = stream->_bytesReturned;
+        stream->_bytesReturned += *length;
+    }
+    SDL_UnlockMutex(stream->_mutex);
+    return hasChunk;
+}
+
+void LC_FileStream_Close(LC_FileStream *stream) {
+    if (stream->_thread != NULL) {
+        SDL_LockMutex(stream->_mutex);
+        stream->_isShuttingDown = true;
+        SDL_BroadcastCondition(stream->_chunkReleased);
+        SDL_UnlockMutex(stream->_mutex);
+        SDL_WaitThread(stream->_thread, NULL);
+        stream->_thread = NULL;
+    }
+    if (stream->_file != NULL) fclose(stream->_file);
+    stream->_file = NULL;
+
+    // The buffers live in the arena
+    if (stream->_chunkReleased != NULL) SDL_DestroyCondition(stream->_chunkReleased);
+    if (stream->_chunkFilled != NULL) SDL_DestroyCondition(stream->_chunkFilled);
+    if (stream->_mutex != NULL) SDL_DestroyMutex(stream->_mutex);
+    stream->_chunkReleased = NULL;
+    stream->_chunkFilled = NULL;
+    stream->_mutex = NULL;
+}
+
+// ===================================================================================================================
+// Hashing
+// ===================================================================================================================
+// wyhash style: input is consumed in 48 byte stripes by three independent multiply-fold lanes, the tail is read as
+// two possibly overlapping 8 byte words. The 128 bit hash runs a second set of lanes with different secrets.
+
+static constexpr uint64 HASH_SECRETS[2][4] = {
+    { 0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull },
+    { 0xA0761D6478BD642Full, 0xE7037ED1A0B428DBull, 0x8EBC6AF09C88C6E3ull, 0x589965CC75374CC3ull },
+};
+
+static void LC_Hash_Multiply(uint64 *a, uint64 *b) {
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t product = (__uint128_t) *a * *b;
+    *a = (uint64) product;
+    *b = (uint64) (product >> 64);
+#else
+    const uint64 aHigh = *a >> 32, aLow = (uint32) *a;
+    const uint64 bHigh = *b >> 32, bLow = (uint32) *b;
+    const uint64 high = aHigh * bHigh, middle0 = aHigh * bLow, middle1 = bHigh * aLow, low = aLow * bLow;
+    const uint64 t = low + (middle0 << 32);
+    const uint64 carry = (t < low) + ((t + (middle1 << 32)) < t);
+    *a = t + (middle1 << 32);
+    *b = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+}
+
+static uint64 LC_Hash_Mix(uint64 a, uint64 b) {
+    LC_Hash_Multiply(&a, &b);
+    return a ^ b;
+}
+
+static uint64 LC_Hash_Read64(const uchar *p) {
+    uint64 value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static uint64 LC_Hash_Read32(const uchar *p) {
+    uint32 value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Lane state of the stripe loop, shared by the one shot and streaming versions so both produce the same hash
+typedef struct {
+    uint64 seed;
+    uint64 see1;
+    uint64 see2;
+} LC_HashLane;
+
+static void LC_Hash_InitializeLane(LC_HashLane *lane, const uint64 seed, const uint64 *secret) {
+    lane->seed = seed ^ LC_Hash_Mix(seed ^ secret[0], secret[1]);
+    lane->see1 = lane->seed;
+    lane->see2 = lane->seed;
+}
+
+static void LC_Hash_ConsumeStripe(LC_HashLane *lane, const uchar *p, const uint64 *secret) {
+    lane->seed = LC_Hash_Mix(LC_Hash_Read64(p) ^ secret[1], LC_Hash_Read64(p + 8) ^ lane->seed);
+    lane->see1 = LC_Hash_Mix(LC_Hash_Read64(p + 16) ^ secret[2], LC_Hash_Read64(p + 24) ^ lane->see1);
+    lane->see2 = LC_Hash_Mix(LC_Hash_Read64(p + 32) ^ secret[3], LC_Hash_Read64(p + 40) ^ lane->see2);
+}
+
+// Hashes what is left after the stripes. 'p' points at the 'remaining' unconsumed bytes; when 'totalLength' is above
+// 16 the 16 bytes before 'p + remaining' must be readable even if some of them were already consumed.
+static uint64 LC_Hash_Finish(uint64 seed, const uchar *p, size_t remaining, const uint64 totalLength,
+                             const uint64 *secret) {
+    uint64 a, b;
+    if (totalLength <= 16) {
+        if (remaining >= 4) {
+            const size_t offset = (remaining >> 3) << 2;
+            a = LC_Hash_Read32(p) << 32 | LC_Hash_Read32(p + offset);
+            b = LC_Hash_Read32(p + remaining - 4) << 32 | LC_Hash_Read32(p + remaining - 4 - offset);
+        } else if (remaining > 0) {
+            a = (uint64) p[0] << 16 | (uint64) p[remaining >> 1] << 8 | p[remaining - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        while (remaining > 16) {
+            seed = LC_Hash_Mix(LC_Hash_Read64(p) ^ secret[1], LC_Hash_Read64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        a = LC_Hash_Read64(p + remaining - 16);
+        b = LC_Hash_Read64(p + remaining - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    LC_Hash_Multiply(&a, &b);
+    return LC_Hash_Mix(a ^ secret[0] ^ totalLength, b ^ secret[1]);
+}
+
+static uint64 LC_Hash_BytesWithSecret(const void *data, const size_t length, const uint64 seed,
+                                      const uint64 *secret) {
+    const uchar *p = data;
+    size_t remaining = length;
+    LC_HashLane lane;
+    LC_Hash_InitializeLane(&lane, seed, secret);
+
+    if (remaining >= 48) {
+        do {
+            LC_Hash_ConsumeStripe(&lane, p, secret);
+            p += 48;
+            remaining -= 48;
+        } while (remaining >= 48);
+        lane.seed ^= lane.see1 ^ lane.see2;
+    }
+
+    return LC_Hash_Finish(lane.seed, p, remaining, length, secret);
+}
+
+uint64 LC_Hash_Bytes64(const void *data, const size_t length, const uint64 seed) {
+    return LC_Hash_BytesWithSecret(data, length, seed, HASH_SECRETS[0]);
+}
+
+LC_Hash128 LC_Hash_Bytes128(const void *data, const size_t length, const uint64 seed) {
+    LC_Hash128 hash;
+    hash.low = LC_Hash_BytesWithSecret(data, length, seed, HASH_SECRETS[0]);
+    hash.high = LC_Hash_BytesWithSecret(data, length, seed, HASH_SECRETS[1]);
+    return hash;
+}
+
+uint64 LC_Hash_String64(const LC_String *string, const uint64 seed) {
+    return LC_Hash_Bytes64(string->data, string->length, seed);
+}
+
+LC_Hash128 LC_Hash_String128(const LC_String *string, const uint64 seed) {
+    return LC_Hash_Bytes128(string->data, string->length, seed);
+}
+
+uint64 LC_Hash_U64(uint64 value, const uint64 seed) {
+    // murmur3 finalizer, spreads every input bit over the whole word so the low bits can pick a slot
+    value ^= seed;
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+bool LC_Hash_IsEqual128(const LC_Hash128 a, const LC_Hash128 b) {
+    return a.low == b.low && a.high == b.high;
+}
+
+// STREAMING
+// The last 16 consumed bytes are kept in front of the pending ones, the tail read can reach back into them just like
+// the one shot version reads back into already hashed input.
+static constexpr size_t HASH_STREAM_HISTORY = 16;
+
+void LC_HashStream_Initialize(LC_HashStream *stream, const uint64 seed, const bool wide) {
+    memset(stream, 0, sizeof(*stream));
+    stream->wide = wide;
+    for (uint32 i = 0; i < (wide ? 2u : 1u); i++) {
+        LC_HashLane lane;
+        LC_Hash_InitializeLane(&lane, seed, HASH_SECRETS[i]);
+        stream->seed[i] = lane.seed;
+        stream->see1[i] = lane.see1;
+        stream->see2[i] = lane.see2;
+    }
+}
+
+static void LC_HashStream_ConsumeStripe(LC_HashStream *stream, const uchar *p) {
+    for (uint32 i = 0; i < (stream->wide ? 2u : 1u); i++) {
+        LC_HashLane lane = { stream->seed[i], stream->see1[i], stream->see2[i] };
+        LC_Hash_ConsumeStripe(&lane, p, HASH_SECRETS[i]);
+        stream->seed[i] = lane.seed;
+        stream->see1[i] = lane.see1;
+        stream->see2[i] = lane.see2;
+    }
+    stream->stripeCount++;
+}
+
+void LC_HashStream_Update(LC_HashStream *stream, const void *data, size_t length) {
+    const uchar *p = data;
+    uchar *pending = stream->buffer + HASH_STREAM_HISTORY;
+    stream->totalLength += length;
+
+    // A stripe is only hashed once more input follows it, the final bytes always stay pending for LC_Hash_Finish
+    if (stream->bufferLength + length <= 48) {
+        memcpy(pending + stream->bufferLength, p, length);
+        stream->bufferLength += (uint32) length;
+        return;
+    }
+
+    if (stream->bufferLength > 0) {
+        const size_t fill = 48 - stream->bufferLength;
+        memcpy(pending + stream->bufferLength, p, fill);
+        p += fill;
+        length -= fill;
+        LC_HashStream_ConsumeStripe(stream, pending);
+        memcpy(stream->buffer, pending + 48 - HASH_STREAM_HISTORY, HASH_STREAM_HISTORY);
+        stream->bufferLength = 0;
+    }
+
+    if (length > 48) {
+        do {
+            LC_HashStream_ConsumeStripe(stream, p);
+            p += 48;
+            length -= 48;
+        } while (length > 48);
+        memcpy(stream->buffer, p - HASH_STREAM_HISTORY, HASH_STREAM_HISTORY);
+    }
+    memcpy(pending, p, length);
+    stream->bufferLength = (uint32) length;
+}
+
+static uint64 LC_HashStream_FinishLane(const LC_HashStream *stream, const uint32 laneIndex) {
+    const uint64 *secret = HASH_SECRETS[laneIndex];
+    const uchar *p = stream->buffer + HASH_STREAM_HISTORY;
+    size_t remaining = stream->bufferLength;
+    LC_HashLane lane = { stream->seed[laneIndex], stream->see1[laneIndex], stream->see2[laneIndex] };
+    uint64 stripeCount = stream->stripeCount;
+
+    if (remaining == 48) {
+        LC_Hash_ConsumeStripe(&lane, p, secret);
+        p += 48;
+        remaining = 0;
+        stripeCount++;
+    }
+    if (stripeCount > 0) {
+        lane.seed ^= lane.see1 ^ lane.see2;
+    }
+
+    return LC_Hash_Finish(lane.seed, p, remaining, stream->totalLength, secret);
+}
+
+uint64 LC_HashStream_Finish64(const LC_HashStream *stream) {
+    return LC_HashStream_FinishLane(stream, 0);
+}
+
+LC_Hash128 LC_HashStream_Finish128(const LC_HashStream *stream) {
+    ASSERT(stream->wide, "LC_HashStream_Finish128 needs a stream initialized as wide");
+    LC_Hash128 hash;
+    hash.low = LC_HashStream_FinishLane(stream, 0);
+    hash.high = LC_HashStream_FinishLane(stream, 1);
+    return hash;
+}
+
+// BATCH
+// Integer keys are finalized four at a time in AVX2 registers (two with SSE2). Neither has a 64 bit multiply, so it
+// is put together from three 32x32 bit products; the result is bit for bit the same as LC_Hash_U64.
+#ifdef LC_X86_SIMD
+
+__attribute__((target("avx2")))
+static __m256i LC_Hash_Multiply64AVX2(const __m256i a, const __m256i b) {
+    const __m256i low = _mm256_mul_epu32(a, b);
+    const __m256i cross0 = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b);
+    const __m256i cross1 = _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32));
+    return _mm256_add_epi64(low, _mm256_slli_epi64(_mm256_add_epi64(cross0, cross1), 32));
+}
+
+__attribute__((target("avx2")))
+static __m256i LC_Hash_U64AVX2(__m256i value) {
+    const __m256i multiplier0 = _mm256_set1_epi64x((int64) 0xFF51AFD7ED558CCDull);
+    const __m256i multiplier1 = _mm256_set1_epi64x((int64) 0xC4CEB9FE1A85EC53ull);
+    value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 33));
+    value = LC_Hash_Multiply64AVX2(value, multiplier0);
+    value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 33));
+    value = LC_Hash_Multiply64AVX2(value, multiplier1);
+    return _mm256_xor_si256(value, _mm256_srli_epi64(value, 33));
+}
+
+__attribute__((target("avx2")))
+static size_t LC_Hash_BatchU64AVX2(const uint64 *keys, uint64 *hashes, const size_t count, const uint64 seed) {
+    const __m256i seedVector = _mm256_set1_epi64x((int64) seed);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i value = _mm256_loadu_si256((const __m256i *) (keys + i));
+        _mm256_storeu_si256((__m256i *) (hashes + i), LC_Hash_U64AVX2(_mm256_xor_si256(value, seedVector)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t LC_Hash_BatchU32AVX2(const uint32 *keys, uint64 *hashes, const size_t count, const uint64 seed) {
+    const __m256i seedVector = _mm256_set1_epi64x((int64) seed);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i value = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (keys + i)));
+        _mm256_storeu_si256((__m256i *) (hashes + i), LC_Hash_U64AVX2(_mm256_xor_si256(value, seedVector)));
+    }
+    return i;
+}
+
+__attribute__((target("sse2")))
+static __m128i LC_Hash_Multiply64SSE2(const __m128i a, const __m128i b) {
+    const __m128i low = _mm_mul_epu32(a, b);
+    const __m128i cross0 = _mm_mul_epu32(_mm_srli_epi64(a, 32), b);
+    const __m128i cross1 = _mm_mul_epu32(a, _mm_srli_epi64(b, 32));
+    return _mm_add_epi64(low, _mm_slli_epi64(_mm_add_epi64(cross0, cross1), 32));
+}
+
+__attribute__((target("sse2")))
+static size_t LC_Hash_BatchU64SSE2(const uint64 *keys, uint64 *hashes, const size_t count, const uint64 seed) {
+    const __m128i seedVector = _mm_set1_epi64x((int64) seed);
+    const __m128i multiplier0 = _mm_set1_epi64x((int64) 0xFF51AFD7ED558CCDull);
+    const __m128i multiplier1 = _mm_set1_epi64x((int64) 0xC4CEB9FE1A85EC53ull);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i value = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (keys + i)), seedVector);
+        value = _mm_xor_si128(value, _mm_srli_epi64(value, 33));
+        value = LC_Hash_Multiply64SSE2(value, multiplier0);
+        value = _mm_xor_si128(value, _mm_srli_epi64(value, 33));
+        value = LC_Hash_Multiply64SSE2(value, multiplier1);
+        value = _mm_xor_si128(value, _mm_srli_epi64(value, 33));
+        _mm_storeu_si128((__m128i *) (hashes + i), value);
+    }
+    return i;
+}
+#endif
+
+void LC_Hash_BatchU64(const uint64 *keys, uint64 *hashes, const size_t count, const uint64 seed) {
+    size_t i = 0;
+#ifdef LC_X86_SIMD
+    if (LC_HasAVX2()) {
+        i = LC_Hash_BatchU64AVX2(keys, hashes, count, seed);
+    } else {
+        i = LC_Hash_BatchU64SSE2(keys, hashes, count, seed);
+    }
+#endif
+    for (; i < count; i++) {
+        hashes[i] = LC_Hash_U64(keys[i], seed);
+    }
+}
+
+void LC_Hash_BatchU32(const uint32 *keys, uint64 *hashes, const size_t count, const uint64 seed) {
+    size_t i = 0;
+#ifdef LC_X86_SIMD
+    if (LC_HasAVX2()) {
+        i = LC_Hash_BatchU32AVX2(keys, hashes, count, seed);
+    }
+#endif
+    for (; i < count; i++) {
+        hashes[i] = LC_Hash_U64(keys[i], seed);
+    }
+}
+
+void LC_Hash_BatchStrings(const LC_String *strings, uint64 *hashes, const size_t count, const uint64 seed) {
+    // Variable length keys don't fit in vector lanes; four independent hashes per iteration still keep the
+    // multipliers busy while one of them waits on a load
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const uint64 hash0 = LC_Hash_String64(&strings[i], seed);
+        const uint64 hash1 = LC_Hash_String64(&strings[i + 1], seed);
+        const uint64 hash2 = LC_Hash_String64(&strings[i + 2], seed);
+        const uint64 hash3 = LC_Hash_String64(&strings[i + 3], seed);
+        hashes[i] = hash0;
+        hashes[i + 1] = hash1;
+        hashes[i + 2] = hash2;
+        hashes[i + 3] = hash3;
+    }
+    for (; i < count; i++) {
+        hashes[i] = LC_Hash_String64(&strings[i], seed);
+    }
+}
+
+// ===================================================================================================================
+// Data Structures
+// ===================================================================================================================
+
+void LC_List_Initialize(LC_List *list, const size_t sizeOfElement) {
+    LC_List_InitializeWithAllocator(list, sizeOfElement, LC_Allocator_Malloc());
+}
+
+void LC_List_InitializeWithAllocator(LC_List *list, const size_t sizeOfElement, const LC_Allocator allocator) {
+    list->_allocator = allocator;
+    list->_sizeOfElement = sizeOfElement;
+    list->_actualBufferSize = 16;
+    list->_length = 0;
+    list->_data = LC_Allocator_Allocate(&list->_allocator, list->_actualBufferSize * list->_sizeOfElement,
+                                        DEFAULT_ALIGNMENT);
+}
+
+uint32 LC_List_GetLength(const LC_List *list) {
+    return list->_length;
+}
+
+void* LC_List_GetData(const LC_List *list) {
+    return list->_data;
+}
+
+void* LC_List_AddElement(LC_List *list, const void *element) {
+    const uchar *bytes = element;
+    uchar *pointerToEnd = list->_data + list->_length * list->_sizeOfElement;
+    if (list->_length + 1 > list->_actualBufferSize) {
+        list->_actualBufferSize *= 2;
+        uchar *newPointer = LC_Allocator_Resize(&list->_allocator, list->_data,
+                                                list->_actualBufferSize / 2 * list->_sizeOfElement,
+                                                list->_actualBufferSize * list->_sizeOfElement, DEFAULT_ALIGNMENT);
+        if (newPointer == NULL) {
+            list->_actualBufferSize /= 2;
+            return newPointer;
+        }
+        list->_data = newPointer;
+        pointerToEnd = list->_data + list->_length * list->_sizeOfElement;
+    }
+    memcpy(pointerToEnd, bytes, list->_sizeOfElement);
+    list->_length++;
+    return pointerToEnd;
+}
+
+void* LC_List_GetElement(const LC_List *list, uint32 index) {
+    if (index >= list->_length) return NULL;
+
+    return list->_data + index * list->_sizeOfElement;
+}
+
+void LC_List_Destroy(LC_List *list) {
+    LC_Allocator_Free(&list->_allocator, list->_data, list->_actualBufferSize * list->_sizeOfElement);
+    list->_sizeOfElement = 0;
+    list->_actualBufferSize = 0;
+    list->_length = 0;
+    list->_data = NULL;
+}
+
+// HASH MAP
+static constexpr uint32 HASH_MAP_DISTANCE_MASK = 0xFF;
+static constexpr uint32 HASH_MAP_MINIMUM_CAPACITY = 16;
+
+static uint64 LC_HashMap_HashString(const void *key) {
+    const LC_String *string = key;
+    return LC_Hash_String64(string, 0);
+}
+
+static bool LC_HashMap_IsEqualString(const void *a, const void *b) {
+    return LC_String_IsEqual(a, b);
+}
+
+static uint64 LC_HashMap_HashCString(const void *key) {
+    const char *string = *(const char * const *) key;
+    return LC_Hash_Bytes64(string, strlen(string), 0);
+}
+
+static bool LC_HashMap_IsEqualCString(const void *a, const void *b) {
+    return strcmp(*(const char * const *) a, *(const char * const *) b) == 0;
+}
+
+static uint64 LC_HashMap_HashInt32(const void *key) {
+    return LC_Hash_U64(*(const uint32 *) key, 0);
+}
+
+static bool LC_HashMap_IsEqualInt32(const void *a, const void *b) {
+    return *(const int32 *) a == *(const int32 *) b;
+}
+
+static uint64 LC_HashMap_HashInt64(const void *key) {
+    return LC_Hash_U64(*(const uint64 *) key, 0);
+}
+
+static bool LC_HashMap_IsEqualInt64(const void *a, const void *b) {
+    return *(const int64 *) a == *(const int64 *) b;
+}
+
+LC_HashMapKeyType LC_HashMapKey_String(void) {
+    LC_HashMapKeyType keyType;
+    keyType.hash = LC_HashMap_HashString;
+    keyType.isEqual = LC_HashMap_IsEqualString;
+    keyType.keySize = sizeof(LC_String);
+    return keyType;
+}
+
+LC_HashMapKeyType LC_HashMapKey_CString(void) {
+    LC_HashMapKeyType keyType;
+    keyType.hash = LC_HashMap_HashCString;
+    keyType.isEqual = LC_HashMap_IsEqualCString;
+    keyType.keySize = sizeof(const char *);
+    return keyType;
+}
+
+LC_HashMapKeyType LC_HashMapKey_Int32(void) {
+    LC_HashMapKeyType keyType;
+    keyType.hash = LC_HashMap_HashInt32;
+    keyType.isEqual = LC_HashMap_IsEqualInt32;
+    keyType.keySize = sizeof(int32);
+    return keyType;
+}
+
+LC_HashMapKeyType LC_HashMapKey_Int64(void) {
+    LC_HashMapKeyType keyType;
+    keyType.hash = LC_HashMap_HashInt64;
+    keyType.isEqual = LC_HashMap_IsEqualInt64;
+    keyType.keySize = sizeof(int64);
+    return keyType;
+}
+
+void LC_HashMap_Initialize(LC_HashMap *map, const LC_HashMapKeyType keyType, const size_t valueSize,
+                           const LC_Allocator allocator) {
+    map->_metadata = NULL;
+    map->_keys = NULL;
+    map->_values = NULL;
+    map->_capacity = 0;
+    map->_length = 0;
+    map->_valueSize = valueSize;
+    map->_allocationSize = 0;
+    map->_keyType = keyType;
+    map->_allocator = allocator;
+}
+
+static uint32 LC_HashMap_GetFragment(const uint64 hash) {
+    return (uint32) (hash >> 32) & ~HASH_MAP_DISTANCE_MASK;
+}
+
+static uchar* LC_HashMap_GetKey(const LC_HashMap *map, const uint32 index) {
+    return map->_keys + (size_t) index * map->_keyType.keySize;
+}
+
+static uchar* LC_HashMap_GetValue(const LC_HashMap *map, const uint32 index) {
+    return map->_values + (size_t) index * map->_valueSize;
+}
+
+// Exchanges the entry in 'index' with the one being carried in the spare slot at the end of the arrays
+static void LC_HashMap_SwapWithCarried(const LC_HashMap *map, const uint32 index, uint32 *carriedMetadata) {
+    const uint32 metadata = map->_metadata[index];
+    map->_metadata[index] = *carriedMetadata;
+    *carriedMetadata = metadata;
+    uchar *residentKey = LC_HashMap_GetKey(map, index);
+    uchar *residentValue = LC_HashMap_GetValue(map, index);
+    uchar *carriedKey = LC_HashMap_GetKey(map, map->_capacity);
+    uchar *carriedValue = LC_HashMap_GetValue(map, map->_capacity);
+    for (size_t i = 0; i < map->_keyType.keySize; i++) {
+        const uchar temp = residentKey[i];
+        residentKey[i] = carriedKey[i];
+        carriedKey[i] = temp;
+    }
+    for (size_t i = 0; i < map->_valueSize; i++) {
+        const uchar temp = residentValue[i];
+        residentValue[i] = carriedValue[i];
+        carriedValue[i] = temp;
+    }
+}
+
+// Places an entry that is known not to be in the map yet. Returns the slot the entry ended up in, or UINT32_MAX when
+// a probe sequence got too long for the distance bits and the table has to grow. The map is left unchanged then.
+static uint32 LC_HashMap_Place(LC_HashMap *map, const uint64 hash, const void *key, const void *value) {
+    const uint32 mask = map->_capacity - 1;
+    // The entry being carried lives in the spare slot at the end of the arrays, so it can be swapped with residents
+    uchar *carriedKey = LC_HashMap_GetKey(map, map->_capacity);
+    uchar *carriedValue = LC_HashMap_GetValue(map, map->_capacity);
+    memcpy(carriedKey, key, map->_keyType.keySize);
+    if (map->_valueSize != 0) {
+        if (value != NULL) memcpy(carriedValue, value, map->_valueSize);
+        else memset(carriedValue, 0, map->_valueSize);
+    }
+    uint32 carriedMetadata = LC_HashMap_GetFragment(hash) | 1;
+    uint32 index = (uint32) hash & mask;
+    // Every slot the carried entry was swapped into, at most one per step of the probe sequence
+    uint32 swappedIndices[HASH_MAP_DISTANCE_MASK + 1];
+    uint32 swapCount = 0;
+
+    for (;;) {
+        const uint32 metadata = map->_metadata[index];
+        if (metadata == 0) {
+            map->_metadata[index] = carriedMetadata;
+            memcpy(LC_HashMap_GetKey(map, index), carriedKey, map->_keyType.keySize);
+            if (map->_valueSize != 0) memcpy(LC_HashMap_GetValue(map, index), carriedValue, map->_valueSize);
+            return swapCount > 0 ? swappedIndices[0] : index;
+        }
+        // Robin Hood: an entry closer to its home slot than the carried one gives up its place
+        if ((metadata & HASH_MAP_DISTANCE_MASK) < (carriedMetadata & HASH_MAP_DISTANCE_MASK)) {
+            LC_HashMap_SwapWithCarried(map, index, &carriedMetadata);
+            swappedIndices[swapCount++] = index;
+        }
+        if ((carriedMetadata & HASH_MAP_DISTANCE_MASK) == HASH_MAP_DISTANCE_MASK) break;
+        carriedMetadata++;
+        index = (index + 1) & mask;
+    }
+
+    // Out of distance bits: every displaced entry goes back to its slot with the distance it had there
+    while (swapCount > 0) {
+        const uint32 swappedIndex = swappedIndices[--swapCount];
+        carriedMetadata -= (index - swappedIndex) & mask;
+        LC_HashMap_SwapWithCarried(map, swappedIndex, &carriedMetadata);
+        index = swappedIndex;
+    }
+    return UINT32_MAX;
+}
+
+// A cluster that is still too long at this capacity is spread out by doubling it, unless the hash function is hopeless
+static bool LC_HashMap_IsWorthGrowing(const LC_HashMap *map, const uint32 capacity) {
+    return capacity < 1u << 30 && (capacity <= 4096 || capacity / 64 <= map->_length);
+}
+
+static bool LC_HashMap_Rehash(LC_HashMap *map, uint32 capacity) {
+    // One allocation holds the metadata, then the keys and the values, each with a spare slot used while inserting
+    const size_t keySize = map->_keyType.keySize;
+    for (;;) {
+        const size_t metadataSize = LC_AlignForward((size_t) capacity * sizeof(uint32), DEFAULT_ALIGNMENT);
+        const size_t keysSize = LC_AlignForward((size_t) (capacity + 1) * keySize, DEFAULT_ALIGNMENT);
+        const size_t allocationSize = metadataSize + keysSize + (size_t) (capacity + 1) * map->_valueSize;
+        uchar *memory = LC_Allocator_AllocateNoZero(&map->_allocator, allocationSize, DEFAULT_ALIGNMENT);
+        if (memory == NULL) return false;
+        memset(memory, 0, metadataSize);
+
+        LC_HashMap old = *map;
+        map->_metadata = (uint32 *) memory;
+        map->_keys = memory + metadataSize;
+        map->_values = memory + metadataSize + keysSize;
+        map->_capacity = capacity;
+        map->_allocationSize = allocationSize;
+
+        bool overflowed = false;
+        for (uint32 i = 0; i < old._capacity && !overflowed; i++) {
+            if (old._metadata[i] == 0) continue;
+            const uchar *key = old._keys + (size_t) i * keySize;
+            overflowed = LC_HashMap_Place(map, map->_keyType.hash(key), key,
+                                          old._values + (size_t) i * old._valueSize) == UINT32_MAX;
+        }
+        if (!overflowed) {
+            LC_Allocator_Free(&map->_allocator, old._metadata, old._allocationSize);
+            return true;
+        }
+
+        // a pathological cluster, give the entries more room and try again
+        LC_Allocator_Free(&map->_allocator, memory, allocationSize);
+        *map = old;
+        if (!LC_HashMap_IsWorthGrowing(map, capacity)) return false;
+        capacity *= 2;
+    }
+}
+
+bool LC_HashMap_Reserve(LC_HashMap *map, const uint32 count) {
+    // keep the load factor at or below 7/8
+    const uint64 needed = (uint64) count + count / 7 + 1;
+    uint64 capacity = map->_capacity > HASH_MAP_MINIMUM_CAPACITY ? map->_capacity : HASH_MAP_MINIMUM_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+    // The slot indices are 32 bit and UINT32_MAX means not found
+    if (capacity > (uint64) 1 << 31) return false;
+    if (capacity == map->_capacity) return true;
+
+    return LC_HashMap_Rehash(map, (uint32) capacity);
+}
+
+static uint32 LC_HashMap_Find(const LC_HashMap *map, const uint64 hash, const void *key) {
+    if (map->_capacity == 0) return UINT32_MAX;
+
+    const uint32 mask = map->_capacity - 1;
+    const uint32 fragment = LC_HashMap_GetFragment(hash);
+    uint32 index = (uint32) hash & mask;
+    for (uint32 distance = 1; ; distance++) {
+        const uint32 metadata = map->_metadata[index];
+        // an empty slot or a resident closer to home than we are means the key would have been placed before it
+        if ((metadata & HASH_MAP_DISTANCE_MASK) < distance) return UINT32_MAX;
+        if (metadata == (fragment | distance) && map->_keyType.isEqual(LC_HashMap_GetKey(map, index), key)) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+void* LC_HashMap_Insert(LC_HashMap *map, const void *key, const void *value) {
+    const uint64 hash = map->_keyType.hash(key);
+    const uint32 existing = LC_HashMap_Find(map, hash, key);
+    if (existing != UINT32_MAX) {
+        if (value != NULL && map->_valueSize != 0) memcpy(LC_HashMap_GetValue(map, existing), value, map->_valueSize);
+        return LC_HashMap_GetValue(map, existing);
+    }
+
+    if ((uint64) (map->_length + 1) * 8 > (uint64) map->_capacity * 7 && !LC_HashMap_Reserve(map, map->_length + 1)) {
+        return NULL;
+    }
+    uint32 index = LC_HashMap_Place(map, hash, key, value);
+    while (index == UINT32_MAX) {
+        // The map is as it was before the insert, so a failed rehash loses nothing
+        if (!LC_HashMap_IsWorthGrowing(map, map->_capacity) || !LC_HashMap_Rehash(map, map->_capacity * 2)) {
+            return NULL;
+        }
+        index = LC_HashMap_Place(map, hash, key, value);
+    }
+    map->_length++;
+
+    return LC_HashMap_GetValue(map, index);
+}
+
+void* LC_HashMap_Get(const LC_HashMap *map, const void *key) {
+    const uint32 index = LC_HashMap_Find(map, map->_keyType.hash(key), key);
+    if (index == UINT32_MAX) return NULL;
+    return LC_HashMap_GetValue(map, index);
+}
+
+bool LC_HashMap_Contains(const LC_HashMap *map, const void *key) {
+    return LC_HashMap_Find(map, map->_keyType.hash(key), key) != UINT32_MAX;
+}
+
+bool LC_HashMap_Remove(LC_HashMap *map, const void *key) {
+    uint32 index = LC_HashMap_Find(map, map->_keyType.hash(key), key);
+    if (index == UINT32_MAX) return false;
+
+    // Backward shift: pull every following entry that is away from its home slot one step closer
+    const uint32 mask = map->_capacity - 1;
+    for (;;) {
+        const uint32 next = (index + 1) & mask;
+        const uint32 metadata = map->_metadata[next];
+        if ((metadata & HASH_MAP_DISTANCE_MASK) <= 1) break;
+
+        map->_metadata[index] = metadata - 1;
+        memcpy(LC_HashMap_GetKey(map, index), LC_HashMap_GetKey(map, next), map->_keyType.keySize);
+        if (map->_valueSize != 0) {
+            memcpy(LC_HashMap_GetValue(map, index), LC_HashMap_GetValue(map, next), map->_valueSize);
+        }
+        index = next;
+    }
+    map->_metadata[index] = 0;
+    map->_length--;
+
+    return true;
+}
+
+uint32 LC_HashMap_GetLength(const LC_HashMap *map) {
+    return map->_length;
+}
+
+bool LC_HashMap_Next(const LC_HashMap *map, uint32 *iterator, void **key, void **value) {
+    // start with '*iterator' set to 0
+    while (*iterator < map->_capacity) {
+        const uint32 index = (*iterator)++;
+        if (map->_metadata[index] == 0) continue;
+        if (key != NULL) *key = LC_HashMap_GetKey(map, index);
+        if (value != NULL) *value = LC_HashMap_GetValue(map, index);
+        return true;
+    }
+    return false;
+}
+
+void LC_HashMap_Clear(LC_HashMap *map) {
+    if (map->_metadata != NULL) memset(map->_metadata, 0, (size_t) map->_capacity * sizeof(uint32));
+    map->_length = 0;
+}
+
+void LC_HashMap_Destroy(LC_HashMap *map) {
+    LC_Allocator_Free(&map->_allocator, map->_metadata, map->_allocationSize);
+    map->_metadata = NULL;
+    map->_keys = NULL;
+    map->_values = NULL;
+    map->_capacity = 0;
+    map->_length = 0;
+    map->_allocationSize = 0;
+}
+
+// STRING INTERNER
+static constexpr uint32 STRING_INTERNER_PAGE_SIZE = 1024;
+
+static uint32 LC_StringInterner_InternLocked(LC_StringInterner *interner, const LC_String *string) {
+    const uint32 *existing = LC_HashMap_Get(&interner->_map, string);
+    if (existing != NULL) return *existing;
+
+    const uint32 id = interner->_count + 1;
+    const uint32 pageIndex = id / STRING_INTERNER_PAGE_SIZE;
+    if (pageIndex >= LC_STRING_INTERNER_MAX_PAGES) return LC_STRING_ID_NONE;
+    if (interner->_pages[pageIndex] == NULL) {
+        interner->_pages[pageIndex] = LC_AllocateAndAlignArena(interner->arena,
+                                                               STRING_INTERNER_PAGE_SIZE * sizeof(LC_String),
+                                                               alignof(LC_String));
+        if (interner->_pages[pageIndex] == NULL) return LC_STRING_ID_NONE;
+    }
+
+    // The interned copy is null terminated so IDs can be turned back into C strings for APIs that need them
+    LC_String copy;
+    copy.length = string->length;
+    copy.data = LC_AllocateAndAlignArenaNoZero(interner->arena, (size_t) string->length + 1, 1);
+    if (copy.data == NULL) return LC_STRING_ID_NONE;
+    memcpy(copy.data, string->data, string->length);
+    copy.data[string->length] = '\0';
+
+    if (LC_HashMap_Insert(&interner->_map, &copy, &id) == NULL) return LC_STRING_ID_NONE;
+    interner->_pages[pageIndex][id % STRING_INTERNER_PAGE_SIZE] = copy;
+    interner->_count = id;
+    return id;
+}
+
+bool LC_StringInterner_Initialize(LC_StringInterner *interner, LC_Arena *arena, const bool isThreadSafe) {
+    memset(interner, 0, sizeof(*interner));
+    interner->arena = arena;
+    LC_HashMap_Initialize(&interner->_map, LC_HashMapKey_String(), sizeof(uint32), LC_Allocator_FromArena(arena));
+
+    if (isThreadSafe) {
+        interner->_lock = SDL_CreateRWLock();
+        if (interner->_lock == NULL) return false;
+    }
+    return true;
+}
+
+uint32 LC_StringInterner_Intern(LC_StringInterner *interner, const LC_String *string) {
+    if (interner->_lock == NULL) return LC_StringInterner_InternLocked(interner, string);
+
+    // Loaders mostly intern names that are already known, those only need the shared lock. A miss is repeated under
+    // the exclusive lock because another thread may have added the string in between.
+    const uint32 id = LC_StringInterner_Find(interner, string);
+    if (id != LC_STRING_ID_NONE) return id;
+
+    SDL_LockRWLockForWriting(interner->_lock);
+    const uint32 newId = LC_StringInterner_InternLocked(interner, string);
+    SDL_UnlockRWLock(interner->_lock);
+    return newId;
+}
+
+uint32 LC_StringInterner_InternCString(LC_StringInterner *interner, const char *cString) {
+    LC_String string;
+    string.length = (uint32) LC_CString_GetLength(cString);
+    string.data = (char *) cString;
+    return LC_StringInterner_Intern(interner, &string);
+}
+
+uint32 LC_StringInterner_Find(LC_StringInterner *interner, const LC_String *string) {
+    if (interner->_lock != NULL) SDL_LockRWLockForReading(interner->_lock);
+    const uint32 *existing = LC_HashMap_Get(&interner->_map, string);
+    const uint32 id = existing != NULL ? *existing : LC_STRING_ID_NONE;
+    if (interner->_lock != NULL) SDL_UnlockRWLock(interner->_lock);
+    return id;
+}
+
+LC_String LC_StringInterner_GetString(const LC_StringInterner *interner, const uint32 id) {
+    // Pages never move once allocated, so a valid ID can be resolved without taking the lock
+    ASSERT(id != LC_STRING_ID_NONE && id / STRING_INTERNER_PAGE_SIZE < LC_STRING_INTERNER_MAX_PAGES,
+           "Not an ID handed out by this interner");
+    return interner->_pages[id / STRING_INTERNER_PAGE_SIZE][id % STRING_INTERNER_PAGE_SIZE];
+}
+
+uint32 LC_StringInterner_GetCount(LC_StringInterner *interner) {
+    if (interner->_lock != NULL) SDL_LockRWLockForReading(interner->_lock);
+    const uint32 count = interner->_count;
+    if (interner->_lock != NULL) SDL_UnlockRWLock(interner->_lock);
+    return count;
+}
+
+void LC_StringInterner_Destroy(LC_StringInterner *interner) {
+    // The strings, pages and table live in the arena and go away with it
+    if (interner->_lock != NULL) SDL_DestroyRWLock(interner->_lock);
+    interner->_lock = NULL;
+}
+
+// SPSC RING
+static uint32 LC_RoundUpToPowerOfTwo(const uint32 value) {
+    uint32 result = 2;
+    while (result < value && result < (1u << 31)) result <<= 1;
+    return result;
+}
+
+bool LC_SpscRing_Initialize(LC_SpscRing *ring, LC_Arena *arena, const uint32 capacity, const size_t elementSize) {
+    memset(ring, 0, sizeof(*ring));
+    ring->_capacity = LC_RoundUpToPowerOfTwo(capacity);
+    ring->_elementSize = elementSize;
+    ring->_buffer = LC_AllocateAndAlignArenaNoZero(arena, (size_t) ring->_capacity * elementSize, LC_CACHE_LINE_SIZE);
+    return ring->_buffer != NULL;
+}
+
+uint32 LC_SpscRing_PushBatch(LC_SpscRing *ring, const void *elements, const uint32 count) {
+    const uint64 tail = atomic_load_explicit(&ring->_tail, memory_order_relaxed);
+    uint64 freeCount = ring->_capacity - (tail - ring->_cachedHead);
+    if (freeCount < count) {
+        ring->_cachedHead = atomic_load_explicit(&ring->_head, memory_order_acquire);
+        freeCount = ring->_capacity - (tail - ring->_cachedHead);
+    }
+    const uint32 pushCount = count < freeCount ? count : (uint32) freeCount;
+    if (pushCount == 0) return 0;
+
+    // At most two copies, the second one when the elements wrap around the end of the buffer
+    const uint32 index = (uint32) tail & (ring->_capacity - 1);
+    const uint32 firstCount = pushCount < ring->_capacity - index ? pushCount : ring->_capacity - index;
+    memcpy(ring->_buffer + index * ring->_elementSize, elements, firstCount * ring->_elementSize);
+    memcpy(ring->_buffer, (const uchar *) elements + firstCount * ring->_elementSize,
+           (pushCount - firstCount) * ring->_elementSize);
+
+    atomic_store_explicit(&ring->_tail, tail + pushCount, memory_order_release);
+    return pushCount;
+}
+
+uint32 LC_SpscRing_PopBatch(LC_SpscRing *ring, void *elements, const uint32 maxCount) {
+    const uint64 head = atomic_load_explicit(&ring->_head, memory_order_relaxed);
+    uint64 available = ring->_cachedTail - head;
+    if (available < maxCount) {
+        ring->_cachedTail = atomic_load_explicit(&ring->_tail, memory_order_acquire);
+        available = ring->_cachedTail - head;
+    }
+    const uint32 popCount = maxCount < available ? maxCount : (uint32) available;
+    if (popCount == 0) return 0;
+
+    const uint32 index = (uint32) head & (ring->_capacity - 1);
+    const uint32 firstCount = popCount < ring->_capacity - index ? popCount : ring->_capacity - index;
+    memcpy(elements, ring->_buffer + index * ring->_elementSize, firstCount * ring->_elementSize);
+    memcpy((uchar *) elements + firstCount * ring->_elementSize, ring->_buffer,
+           (popCount - firstCount) * ring->_elementSize);
+
+    // Hands the slots back only after they have been copied out
+    atomic_store_explicit(&ring->_head, head + popCount, memory_order_release);
+    return popCount;
+}
+
+bool LC_SpscRing_Push(LC_SpscRing *ring, const void *element) {
+    return LC_SpscRing_PushBatch(ring, element, 1) == 1;
+}
+
+bool LC_SpscRing_Pop(LC_SpscRing *ring, void *element) {
+    return LC_SpscRing_PopBatch(ring, element, 1) == 1;
+}
+
+uint32 LC_SpscRing_GetCount(LC_SpscRing *ring) {
+    const uint64 head = atomic_load_explicit(&ring->_head, memory_order_acquire);
+    return (uint32) (atomic_load_explicit(&ring->_tail, memory_order_acquire) - head);
+}
+
+// MPMC QUEUE
+// A cell is a sequence number followed by the element. The sequence equals the position of the lap a producer may
+// fill the cell in, position + 1 once the element is in, and position + capacity when a consumer has taken it out.
+static _Atomic(uint64)* LC_MpmcQueue_GetSequence(const LC_MpmcQueue *queue, const uint64 position) {
+    return (_Atomic(uint64) *) (queue->_cells + (position & (queue->_capacity - 1)) * queue->_cellSize);
+}
+
+static uchar* LC_MpmcQueue_GetElement(const LC_MpmcQueue *queue, const uint64 position) {
+    return queue->_cells + (position & (queue->_capacity - 1)) * queue->_cellSize + sizeof(uint64);
+}
+
+bool LC_MpmcQueue_Initialize(LC_MpmcQueue *queue, LC_Arena *arena, const uint32 capacity, const size_t elementSize) {
+    memset(queue, 0, sizeof(*queue));
+    queue->_capacity = LC_RoundUpToPowerOfTwo(capacity);
+    queue->_elementSize = elementSize;
+    // Elements are copied with memcpy, the cells only need to keep the sequence numbers aligned
+    queue->_cellSize = LC_AlignForward(sizeof(uint64) + elementSize, alignof(uint64));
+    queue->_cells = LC_AllocateAndAlignArenaNoZero(arena, queue->_capacity * queue->_cellSize, LC_CACHE_LINE_SIZE);
+    if (queue->_cells == NULL) return false;
+
+    for (uint32 i = 0; i < queue->_capacity; i++) {
+        atomic_init(LC_MpmcQueue_GetSequence(queue, i), i);
+    }
+    return true;
+}
+
+// A batch claims a run of consecutive cells with a single compare and swap. The run only covers cells that were
+// already seen in the wanted state, and they stay in it until their position is claimed, which the swap makes ours.
+uint32 LC_MpmcQueue_PushBatch(LC_MpmcQueue *queue, const void *elements, const uint32 count) {
+    if (count == 0) return 0;
+    uint64 position = atomic_load_explicit(&queue->_enqueuePosition, memory_order_relaxed);
+    for (;;) {
+        uint32 readyCount = 0;
+        while (readyCount < count && readyCount < queue->_capacity &&
+               atomic_load_explicit(LC_MpmcQueue_GetSequence(queue, position + readyCount), memory_order_acquire) ==
+               position + readyCount) {
+            readyCount++;
+        }
+
+        if (readyCount == 0) {
+            const uint64 sequence = atomic_load_explicit(LC_MpmcQueue_GetSequence(queue, position),
+                                                         memory_order_acquire);
+            // The cell still holds the element of the previous lap
+            if ((int64) (sequence - position) < 0) return 0;
+            // Another producer got here first
+            position = atomic_load_explicit(&queue->_enqueuePosition, memory_order_relaxed);
+            continue;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&queue->_enqueuePosition, &position, position + readyCount,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            for (uint32 i = 0; i < readyCount; i++) {
+                memcpy(LC_MpmcQueue_GetElement(queue, position + i),
+                       (const uchar *) elements + i * queue->_elementSize, queue->_elementSize);
+                atomic_store_explicit(LC_MpmcQueue_GetSequence(queue, position + i), position + i + 1,
+                                      memory_order_release);
+            }
+            return readyCount;
+        }
+    }
+}
+
+uint32 LC_MpmcQueue_PopBatch(LC_MpmcQueue *queue, void *elements, const uint32 maxCount) {
+    if (maxCount == 0) return 0;
+    uint64 position = atomic_load_explicit(&queue->_dequeuePosition, memory_order_relaxed);
+    for (;;) {
+        uint32 readyCount = 0;
+        while (readyCount < maxCount && readyCount < queue->_capacity &&
+               atomic_load_explicit(LC_MpmcQueue_GetSequence(queue, position + readyCount), memory_order_acquire) ==
+               position + readyCount + 1) {
+            readyCount++;
+        }
+
+        if (readyCount == 0) {
+            const uint64 sequence = atomic_load_explicit(LC_MpmcQueue_GetSequence(queue, position),
+                                                         memory_order_acquire);
+            // Nothing has been pushed into the cell yet
+            if ((int64) (sequence - (position + 1)) < 0) return 0;
+            position = atomic_load_explicit(&queue->_dequeuePosition, memory_order_relaxed);
+            continue;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&queue->_dequeuePosition, &position, position + readyCount,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            for (uint32 i = 0; i < readyCount; i++) {
+                memcpy((uchar *) elements + i * queue->_elementSize, LC_MpmcQueue_GetElement(queue, position + i),
+                       queue->_elementSize);
+                atomic_store_explicit(LC_MpmcQueue_GetSequence(queue, position + i),
+                                      position + i + queue->_capacity, memory_order_release);
+            }
+            return readyCount;
+        }
+    }
+}
+
+bool LC_MpmcQueue_Push(LC_MpmcQueue *queue, const void *element) {
+    return LC_MpmcQueue_PushBatch(queue, element, 1) == 1;
+}
+
+bool LC_MpmcQueue_Pop(LC_MpmcQueue *queue, void *element) {
+    return LC_MpmcQueue_PopBatch(queue, element, 1) == 1;
+}
+
+// ===================================================================================================================
+// Job System
+// ===================================================================================================================
+// Idle threads spin this many times looking for work before a worker goes to sleep or a waiting thread yields
+static constexpr uint32 JOB_SYSTEM_SPIN_COUNT = 256;
+
+typedef struct {
+    LC_JobSystem *system;
+    uint32 threadIndex;
+} LC_JobWorkerStart;
+
+typedef struct {
+    LC_ParallelForFunction function;
+    void *userData;
+    uint32 begin;
+    uint32 end;
+} LC_ParallelForRange;
+
+static thread_local LC_JobSystem *jobSystemOfThread;
+static thread_local uint32 jobThreadIndex = LC_JOB_THREAD_NONE;
+static thread_local uint32 jobRandomState;
+
+static void LC_JobSystem_Pause(void) {
+#ifdef LC_X86_SIMD
+    _mm_pause();
+#endif
+}
+
+// xorshift32, only used to pick where to steal from
+static uint32 LC_JobSystem_NextRandom(void) {
+    uint32 x = jobRandomState != 0 ? jobRandomState : 0x9E3779B9u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    jobRandomState = x;
+    return x;
+}
 
-void LC_String_Initialize(LC_String *string, char *cString) {
-    uint32 count = 0;
+static bool LC_JobDeque_Push(LC_JobDeque *deque, LC_Job *job) {
+    const int64 bottom = atomic_load_explicit(&deque->_bottom, memory_order_relaxed);
+    const int64 top = atomic_load_explicit(&deque->_top, memory_order_acquire);
+    if (bottom - top >= LC_JOB_QUEUE_CAPACITY) return false;
 
-    while (cString[count] != '\0') {
-        count++;
-    }
+    atomic_store_explicit(&deque->_slots[bottom & (LC_JOB_QUEUE_CAPACITY - 1)], job, memory_order_relaxed);
+    // Publishes the slot, and the job it points to, to the thieves
+    atomic_store_explicit(&deque->_bottom, bottom + 1, memory_order_release);
+    return true;
+}
 
-    string->length = count;
-    string->data = cString;
+static LC_Job* LC_JobDeque_Pop(LC_JobDeque *deque) {
+    const int64 bottom = atomic_load_explicit(&deque->_bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->_bottom, bottom, memory_order_relaxed);
+    // The claim on the bottom slot has to be visible before 'top' is read, or a thief could take the same job
+    atomic_thread_fence(memory_order_seq_cst);
+    int64 top = atomic_load_explicit(&deque->_top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->_bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+    LC_Job *job = atomic_load_explicit(&deque->_slots[bottom & (LC_JOB_QUEUE_CAPACITY - 1)], memory_order_relaxed);
+    if (top == bottom) {
+        // The last job, the thieves may be after it too
+        if (!atomic_compare_exchange_strong_explicit(&deque->_top, &top, top + 1, memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            job = NULL;
+        }
+        atomic_store_explicit(&deque->_bottom, bottom + 1, memory_order_relaxed);
+    }
+    return job;
 }
 
-void LC_String_InitializeByCopy(LC_Arena *arena, LC_String *string, const char *cString) {
-    uint32 count = 0;
+static LC_Job* LC_JobDeque_Steal(LC_JobDeque *deque) {
+    int64 top = atomic_load_explicit(&deque->_top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    const int64 bottom = atomic_load_explicit(&deque->_bottom, memory_order_acquire);
+    if (top >= bottom) return NULL;
 
-    while (cString[count] != '\0') {
-        count++;
+    LC_Job *job = atomic_load_explicit(&deque->_slots[top & (LC_JOB_QUEUE_CAPACITY - 1)], memory_order_relaxed);
+    // Losing the race to the owner or another thief counts as finding nothing, the caller moves on
+    if (!atomic_compare_exchange_strong_explicit(&deque->_top, &top, top + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return NULL;
     }
+    return job;
+}
 
-    string->length = count;
-    string->data = LC_Arena_Allocate(arena, count + 1);
-    strncpy(string->data, cString, count + 1);
+static void LC_JobSystem_Execute(LC_Job *job) {
+    // The job may be gone as soon as its counter reaches zero
+    LC_JobCounter *counter = job->_counter;
+    job->function(job->data);
+    if (counter != NULL) atomic_fetch_sub_explicit(&counter->_pending, 1, memory_order_acq_rel);
 }
 
-bool LC_String_IsEqualCString(const LC_String *string, const char *cString) {
-    size_t cStringLength = strlen(cString);
-    if (string->length != cStringLength) return false;
+static bool LC_JobSystem_RunOne(LC_JobSystem *system) {
+    const bool isMember = jobSystemOfThread == system;
+    LC_Job *job = isMember ? LC_JobDeque_Pop(&system->_deques[jobThreadIndex]) : NULL;
 
-    for (size_t i = 0; i < string->length; i++) {
-        if (string->data[i] != cString[i]) return false;
+    // Victims are tried starting from a random one, so the thieves don't all queue up behind the same deque
+    const uint32 start = LC_JobSystem_NextRandom() % system->_threadCount;
+    for (uint32 i = 0; i < system->_threadCount && job == NULL; i++) {
+        const uint32 victim = (start + i) % system->_threadCount;
+        if (isMember && victim == jobThreadIndex) continue;
+        job = LC_JobDeque_Steal(&system->_deques[victim]);
     }
+    if (job == NULL) return false;
 
+    LC_JobSystem_Execute(job);
     return true;
 }
 
-bool LC_String_IsEqual(const LC_String *str1, const LC_String *str2) {
-    if (str1->length != str2->length) return false;
-    
-    for (size_t i = 0; i < str1->length; i++) {
-        if (str1->data[i] != str2->data[i]) return false;
+static bool LC_JobSystem_HasWork(LC_JobSystem *system) {
+    for (uint32 i = 0; i < system->_threadCount; i++) {
+        const int64 top = atomic_load(&system->_deques[i]._top);
+        if (atomic_load(&system->_deques[i]._bottom) > top) return true;
     }
-
-    return true;
+    return false;
 }
 
-uint32 LC_GetStringLengthSkipSpaces(const char *string, const uint32 length) {
-    uint32 count = 0;
-    if (string == NULL) return count;
+static int LC_JobSystem_WorkerMain(void *data) {
+    const LC_JobWorkerStart *start = data;
+    LC_JobSystem *system = start->system;
+    jobSystemOfThread = system;
+    jobThreadIndex = start->threadIndex;
+    jobRandomState = start->threadIndex * 0x9E3779B9u;
 
-    for (size_t i = 0; i < length; i++) {
-        if (string[i] != ' ') {
-            count++;
+    // Worker n goes on core n, core 0 is left to the thread that initialized the system
+    if (system->_isPinned) {
+        const uint32 core = start->threadIndex % (uint32) SDL_GetNumLogicalCPUCores();
+#ifdef _WIN32
+        LC_Win32_PinCurrentThread(core);
+#elif __linux__
+        LC_Linux_PinCurrentThread(core);
+#else
+        (void)core;
+#endif
+    }
+
+    uint32 idleCount = 0;
+    while (!atomic_load_explicit(&system->_isShuttingDown, memory_order_acquire)) {
+        if (LC_JobSystem_RunOne(system)) {
+            idleCount = 0;
+            continue;
+        }
+        if (++idleCount < JOB_SYSTEM_SPIN_COUNT) {
+            LC_JobSystem_Pause();
+            continue;
         }
+        idleCount = 0;
+
+        // Announcing the sleep before looking for work one last time pairs with the check in LC_JobSystem_Run: either
+        // this sees the new jobs or the submitter sees this worker and wakes it up
+        atomic_fetch_add_explicit(&system->_sleepingCount, 1, memory_order_seq_cst);
+        if (!LC_JobSystem_HasWork(system) && !atomic_load(&system->_isShuttingDown)) {
+            SDL_WaitSemaphore(system->_wakeUp);
+        }
+        atomic_fetch_sub_explicit(&system->_sleepingCount, 1, memory_order_relaxed);
     }
-    return count;
+
+    // The scratch arenas the jobs used on this thread
+    LC_Scratch_ReleaseThreadArenas();
+    return 0;
 }
 
-// ===================================================================================================================
-// Utility Operations
-// ===================================================================================================================
-void LC_SwapValues(void *x, void *y, const size_t sizeOfElement, bool *success) {
-    uchar *xBytes = x;
-    uchar *yBytes = y;
-    uchar *temp = malloc(sizeOfElement);
-    if (temp == NULL) {
-        *success = false;
-        return;
+bool LC_JobSystem_Initialize(LC_JobSystem *system, LC_Arena *arena, uint32 workerCount, const bool pinWorkers) {
+    memset(system, 0, sizeof(*system));
+    if (workerCount == 0) {
+        const int32 coreCount = SDL_GetNumLogicalCPUCores();
+        workerCount = coreCount > 1 ? (uint32) coreCount - 1 : 1;
     }
-    memcpy(temp, xBytes, sizeOfElement);
-    memcpy(xBytes, yBytes, sizeOfElement);
-    memcpy(yBytes, temp, sizeOfElement);
-    free(temp);
+    system->_threadCount = workerCount + 1;
+    system->_isPinned = pinWorkers;
 
-    *success = true;
-}
+    system->_deques = LC_AllocateAndAlignArena(arena, system->_threadCount * sizeof(LC_JobDeque), alignof(LC_JobDeque));
+    system->_threads = LC_AllocateAndAlignArena(arena, system->_threadCount * sizeof(SDL_Thread *),
+                                                alignof(SDL_Thread *));
+    LC_JobWorkerStart *starts = LC_AllocateAndAlignArena(arena, system->_threadCount * sizeof(LC_JobWorkerStart),
+                                                         alignof(LC_JobWorkerStart));
+    system->_workerStarts = starts;
+    system->_wakeUp = SDL_CreateSemaphore(0);
+    if (system->_deques == NULL || system->_threads == NULL || starts == NULL || system->_wakeUp == NULL) {
+        if (system->_wakeUp != NULL) SDL_DestroySemaphore(system->_wakeUp);
+        system->_wakeUp = NULL;
+        system->_threadCount = 0;
+        return false;
+    }
 
-// ===================================================================================================================
-// Memory Allocations
-// ===================================================================================================================
-bool LC_IsPowerOfTwo(const uintptr_t x) {
-    return (x & (x - 1)) == 0;
+    jobSystemOfThread = system;
+    jobThreadIndex = 0;
+    for (uint32 i = 1; i < system->_threadCount; i++) {
+        starts[i].system = system;
+        starts[i].threadIndex = i;
+        system->_threads[i] = SDL_CreateThread(LC_JobSystem_WorkerMain, "LC_JobWorker", &starts[i]);
+        if (system->_threads[i] == NULL) {
+            // Runs with the workers that did start, their deques are the only ones in use
+            system->_threadCount = i;
+            break;
+        }
+    }
+    return true;
 }
 
-uintptr_t LC_AlignForward(const uintptr_t ptr, const size_t align) {
-    assert(LC_IsPowerOfTwo(align));
-
-    uintptr_t p = ptr;
-    const uintptr_t a = align;
-    // Same as (p % a) but faster as 'a' is a power of two
-    const uintptr_t modulo = p & (a - 1);
+void LC_JobSystem_Run(LC_JobSystem *system, LC_Job *jobs, const uint32 count, LC_JobCounter *counter) {
+    ASSERT(jobSystemOfThread == system, "Jobs can only be run from the initializing thread or from other jobs");
+    if (counter != NULL) atomic_fetch_add_explicit(&counter->_pending, (int32) count, memory_order_relaxed);
 
-    if (modulo != 0) {
-        // if 'p' address is not aligned, push the address to the next value which is aligned
-        p += a - modulo;
+    LC_JobDeque *deque = &system->_deques[jobThreadIndex];
+    for (uint32 i = 0; i < count; i++) {
+        jobs[i]._counter = counter;
+        if (!LC_JobDeque_Push(deque, &jobs[i])) LC_JobSystem_Execute(&jobs[i]);
     }
 
-    return p;
+    atomic_thread_fence(memory_order_seq_cst);
+    const int32 sleepingCount = atomic_load_explicit(&system->_sleepingCount, memory_order_relaxed);
+    for (int32 i = 0; i < sleepingCount && (uint32) i < count; i++) SDL_SignalSemaphore(system->_wakeUp);
 }
 
-void *LC_AllocateAndAlignArena(LC_Arena *arena, const size_t size, const size_t align) {
-    // Align 'currentOffset' forward to the specified alignment
-    const uintptr_t currentPointer = (uintptr_t) arena->buffer + arena->currentOffset;
-    uintptr_t offset = LC_AlignForward(currentPointer, align);
-    offset -= (uintptr_t) arena->buffer;
-
-    // check to see if the backing memory has space left
-    if (offset + size <= arena->bufferLength) {
-        void *pointer = &arena->buffer[offset];
-        arena->previousOffset = offset;
-        arena->currentOffset = offset + size;
-
-        // zero new memory by default
-        memset(pointer, 0, size);
-        return pointer;
+void LC_JobSystem_Wait(LC_JobSystem *system, LC_JobCounter *counter) {
+    uint32 idleCount = 0;
+    while (atomic_load_explicit(&counter->_pending, memory_order_acquire) > 0) {
+        if (LC_JobSystem_RunOne(system)) {
+            idleCount = 0;
+            continue;
+        }
+        // What is left is running on other threads
+        if (++idleCount < JOB_SYSTEM_SPIN_COUNT) {
+            LC_JobSystem_Pause();
+        } else {
+            SDL_Delay(0);
+        }
     }
-    // return NULL if the arena is out of memory (or handle differently)
-    return NULL;
 }
 
-void *LC_Arena_Allocate(LC_Arena *arena, const size_t size) {
-    return LC_AllocateAndAlignArena(arena, size, DEFAULT_ALIGNMENT);
+bool LC_JobCounter_IsDone(const LC_JobCounter *counter) {
+    return atomic_load_explicit(&counter->_pending, memory_order_acquire) == 0;
 }
 
-void LC_Arena_Initialize(LC_Arena *arena, void *backingBuffer, const size_t backingBufferLength) {
-    arena->buffer = (uchar *) backingBuffer;
-    arena->bufferLength = backingBufferLength;
-    arena->currentOffset = 0;
-    arena->previousOffset = 0;
+static void LC_JobSystem_RunParallelForRange(void *data) {
+    const LC_ParallelForRange *range = data;
+    range->function(range->userData, range->begin, range->end);
 }
 
-// void LC_FreeArena(LC_Arena *arena, void *pointer) {
-    // do nothing
-// }
+void LC_JobSystem_ParallelFor(LC_JobSystem *system, const uint32 count, uint32 batchSize,
+                              const LC_ParallelForFunction function, void *userData) {
+    if (count == 0) return;
+    if (batchSize == 0) batchSize = count / (system->_threadCount * 4);
+    if (batchSize == 0) batchSize = 1;
+    const uint32 batchCount = (uint32) (((uint64) count + batchSize - 1) / batchSize);
+    if (batchCount == 1) {
+        function(userData, 0, count);
+        return;
+    }
 
-void *LC_Arena_ResizeAndAlign(LC_Arena *arena, void *oldMemory, const size_t oldSize, const size_t newSize,
-                             const size_t align) {
-    assert(LC_IsPowerOfTwo(align));
+    const TemporaryArenaMemory scratch = LC_Scratch_Begin(NULL, 0);
+    LC_Job *jobs = LC_AllocateAndAlignArenaNoZero(scratch.arena, batchCount * sizeof(LC_Job), alignof(LC_Job));
+    LC_ParallelForRange *ranges = LC_AllocateAndAlignArenaNoZero(scratch.arena, batchCount * sizeof(LC_ParallelForRange),
+                                                                 alignof(LC_ParallelForRange));
+    if (jobs == NULL || ranges == NULL) {
+        function(userData, 0, count);
+        LC_Scratch_End(scratch);
+        return;
+    }
 
-    if (oldMemory == NULL || oldSize == 0) return LC_AllocateAndAlignArena(arena, newSize, align);
-    if (arena->buffer <= (uchar *) oldMemory && (uchar *) oldMemory < arena->buffer + arena->bufferLength) {
-        if (arena->buffer + arena->previousOffset == oldMemory) {
-            arena->currentOffset = arena->previousOffset + newSize;
-            if (newSize > oldSize) {
-                memset(&arena->buffer[arena->currentOffset], 0, newSize - oldSize);
-            }
-            return oldMemory;
-        }
-        void *newMemory = LC_AllocateAndAlignArena(arena, newSize, align);
-        const size_t copySize = oldSize < newSize ? oldSize : newSize;
-        // copy across old memory ot the new memory
-        memmove(newMemory, oldMemory, copySize);
-        return newMemory;
+    for (uint32 i = 0; i < batchCount; i++) {
+        ranges[i].function = function;
+        ranges[i].userData = userData;
+        ranges[i].begin = i * batchSize;
+        ranges[i].end = count - ranges[i].begin > batchSize ? ranges[i].begin + batchSize : count;
+        jobs[i].function = LC_JobSystem_RunParallelForRange;
+        jobs[i].data = &ranges[i];
     }
-    assert(0 && "Memory is out of bounds of the buffer in this arena");
+    LC_JobCounter counter = {0};
+    LC_JobSystem_Run(system, jobs, batchCount, &counter);
+    LC_JobSystem_Wait(system, &counter);
+    LC_Scratch_End(scratch);
 }
 
-void *LC_Arena_Resize(LC_Arena *arena, void *oldMemory, const size_t oldSize, const size_t newSize) {
-    return LC_Arena_ResizeAndAlign(arena, oldMemory, oldSize, newSize, DEFAULT_ALIGNMENT);
+uint32 LC_JobSystem_GetThreadCount(const LC_JobSystem *system) {
+    return system->_threadCount;
 }
 
-void LC_Arena_FreeAll(LC_Arena *arena) {
-    arena->currentOffset = 0;
-    arena->previousOffset = 0;
+uint32 LC_JobSystem_GetThreadIndex(void) {
+    return jobThreadIndex;
 }
 
-TemporaryArenaMemory LC_Arena_BeginTemporaryMemory(LC_Arena *arena) {
-    TemporaryArenaMemory temporaryArena;
-    temporaryArena.arena = arena;
-    temporaryArena.previousOffset = arena->previousOffset;
-    temporaryArena.currentOffset = arena->currentOffset;
+void LC_JobSystem_Destroy(LC_JobSystem *system) {
+    if (system->_threadCount == 0) return;
 
-    return temporaryArena;
-}
+    atomic_store_explicit(&system->_isShuttingDown, true, memory_order_release);
+    for (uint32 i = 1; i < system->_threadCount; i++) SDL_SignalSemaphore(system->_wakeUp);
+    for (uint32 i = 1; i < system->_threadCount; i++) SDL_WaitThread(system->_threads[i], NULL);
+    SDL_DestroySemaphore(system->_wakeUp);
+    system->_wakeUp = NULL;
+    system->_threadCount = 0;
 
-void LC_Arena_EndTemporary(const TemporaryArenaMemory temporaryArena) {
-    temporaryArena.arena->previousOffset = temporaryArena.previousOffset;
-    temporaryArena.arena->currentOffset = temporaryArena.currentOffset;
+    if (jobSystemOfThread == system) {
+        jobSystemOfThread = NULL;
+        jobThreadIndex = LC_JOB_THREAD_NONE;
+    }
+    // The deques and thread handles live in the arena
 }
 
 // ===================================================================================================================
-// File Operations
+// Sorting Algorithms
 // ===================================================================================================================
+// Introsort in the style of pdqsort. The pivot is the median of three, or of three medians of three on larger ranges,
+// and the partition loops run without bounds checks because the pivot selection leaves an element on each side that
+// stops them. Recursion only goes into the smaller side, the depth limit switches to heapsort when the pivots keep
+// turning out badly.
+static constexpr int32 SORT_INSERTION_THRESHOLD = 24;
+static constexpr int32 SORT_NINTHER_THRESHOLD = 128;
 
-void LC_GetFileContentString(LC_Arena *arena, const char *filePath, char **fileContents) {
-    if (filePath == NULL) return;
-
-    // Open the file in "read mode"
-    FILE *file = fopen(filePath, "r");
-
-    if (file == NULL) return;
-    // Move the pointer of the current position in the file to the end.
-    fseek(file, 0, SEEK_END);
-    // Traverse the file from the beginning of the file to the current position. The current position of the pointer
-    // was set to be the end of the file with SEEK_END in the previous statement.
-    const int32 length = (int32)ftell(file);
-    // Move the pointer of the current position back to the beginning of the file
-    fseek(file, 0, SEEK_SET);
-
-    // Allocate memory for the string. We add 1 to the length to store the null terminating character '\0' at the end.
-    *fileContents = LC_Arena_Allocate(arena, sizeof(char) * (length + 1));
+static inline void LC_SortIntegers_Swap(int32 *array, const int32 a, const int32 b) {
+    const int32 temp = array[a];
+    array[a] = array[b];
+    array[b] = temp;
+}
 
-    char c;
-    int32 i = 0;
+// Orders the three elements so that array[a] <= array[b] <= array[c]
+static inline void LC_SortIntegers_Sort3(int32 *array, const int32 a, const int32 b, const int32 c) {
+    if (array[b] < array[a]) LC_SortIntegers_Swap(array, a, b);
+    if (array[c] < array[b]) LC_SortIntegers_Swap(array, b, c);
+    if (array[b] < array[a]) LC_SortIntegers_Swap(array, a, b);
+}
 
-    // fgetc will return each character until it get to the end of file where it will return EOF and the loop will end.
-    while ((c = (char) fgetc(file)) != EOF) {
-        (*fileContents)[i] = c;
-        i++;
+static void LC_SortIntegers_Insertion(int32 *array, const int32 begin, const int32 end) {
+    for (int32 i = begin + 1; i < end; i++) {
+        const int32 value = array[i];
+        int32 j = i;
+        while (j > begin && value < array[j - 1]) {
+            array[j] = array[j - 1];
+            j--;
+        }
+        array[j] = value;
     }
+}
 
-    (*fileContents)[i] = '\0';
-
-    fclose(file);
+static void LC_SortIntegers_SiftDown(int32 *array, int32 root, const int32 length) {
+    const int32 value = array[root];
+    for (;;) {
+        int32 child = 2 * root + 1;
+        if (child >= length) break;
+        if (child + 1 < length && array[child] < array[child + 1]) child++;
+        if (!(value < array[child])) break;
+        array[root] = array[child];
+        root = child;
+    }
+    array[root] = value;
 }
 
-bool LC_GetFileContentBinary(LC_Arena *arena, const char *filePath, uchar **fileContents, size_t *fileSize, char *errorLog) {
-    FILE *file = fopen(filePath, "rb");
-    if (file == NULL) {
-        *fileSize = 0;
-        snprintf(errorLog, 1024, "File not found: %s", filePath);
-        return false;
+static void LC_SortIntegers_Heap(int32 *array, const int32 length) {
+    for (int32 i = length / 2 - 1; i >= 0; i--) LC_SortIntegers_SiftDown(array, i, length);
+    for (int32 i = length - 1; i > 0; i--) {
+        LC_SortIntegers_Swap(array, 0, i);
+        LC_SortIntegers_SiftDown(array, 0, i);
     }
+}
 
-    fseek(file, 0, SEEK_END);
-    *fileSize = ftell(file);
-    fseek(file, 0, SEEK_SET);
+// Moves elements smaller than the pivot at array[begin] to its left and the rest to its right, returns where the pivot
+// ends up
+static int32 LC_SortIntegers_PartitionRight(int32 *array, const int32 begin, const int32 end) {
+    const int32 pivot = array[begin];
+    int32 first = begin;
+    int32 last = end;
 
-    *fileContents = LC_Arena_Allocate(arena, *fileSize);
-    if (*fileContents == NULL) {
-        fclose(file);
-        snprintf(errorLog, 1024, "Memory allocation failed: %s", filePath);
-        return false;
+    while (array[++first] < pivot) {}
+    if (first - 1 == begin) {
+        while (first < last && !(array[--last] < pivot)) {}
+    } else {
+        while (!(array[--last] < pivot)) {}
+    }
+    while (first < last) {
+        LC_SortIntegers_Swap(array, first, last);
+        while (array[++first] < pivot) {}
+        while (!(array[--last] < pivot)) {}
     }
-    fread(*fileContents, *fileSize, 1, file);
-    fclose(file);
 
-    return true;
+    const int32 pivotPosition = first - 1;
+    array[begin] = array[pivotPosition];
+    array[pivotPosition] = pivot;
+    return pivotPosition;
 }
 
-// ===================================================================================================================
-// Data Structures
-// ===================================================================================================================
-
-void LC_List_Initialize(LC_List *list, const size_t sizeOfElement) {
-    list->_sizeOfElement = sizeOfElement;
-    list->_actualBufferSize = 16;
-    list->_length = 0;
-    list->_data = calloc(list->_actualBufferSize, list->_sizeOfElement);
-}
+// Used when no element of the range is smaller than the pivot. Elements equal to it go left and are done, returns the
+// position of the last of them.
+static int32 LC_SortIntegers_PartitionLeft(int32 *array, const int32 begin, const int32 end) {
+    const int32 pivot = array[begin];
+    int32 first = begin;
+    int32 last = end;
 
-uint32 LC_List_GetLength(const LC_List *list) {
-    return list->_length;
-}
+    while (pivot < array[--last]) {}
+    if (last + 1 == end) {
+        while (first < last && !(pivot < array[++first])) {}
+    } else {
+        while (!(pivot < array[++first])) {}
+    }
+    while (first < last) {
+        LC_SortIntegers_Swap(array, first, last);
+        while (pivot < array[--last]) {}
+        while (!(pivot < array[++first])) {}
+    }
 
-void* LC_List_GetData(const LC_List *list) {
-    return list->_data;
+    array[begin] = array[last];
+    array[last] = pivot;
+    return last;
 }
 
-void* LC_List_AddElement(LC_List *list, const void *element) {
-    const uchar *bytes = element;
-    uchar *pointerToEnd = list->_data + list->_length * list->_sizeOfElement;
-    if (list->_length + 1 > list->_actualBufferSize) {
-        list->_actualBufferSize *= 2;
-        uchar *newPointer = realloc(list->_data, list->_actualBufferSize * list->_sizeOfElement);
-        if (newPointer == NULL) {
-            list->_actualBufferSize /= 2;
-            return newPointer;
+// NOLINTNEXTLINE(misc-no-recursion)
+static void LC_SortIntegers_Loop(int32 *array, int32 begin, int32 end, int32 depthLimit, bool isLeftmost) {
+    for (;;) {
+        const int32 size = end - begin;
+        if (size < SORT_INSERTION_THRESHOLD) {
+            LC_SortIntegers_Insertion(array, begin, end);
+            return;
+        }
+        if (depthLimit-- == 0) {
+            LC_SortIntegers_Heap(array + begin, size);
+            return;
         }
-        list->_data = newPointer;
-        pointerToEnd = list->_data + list->_length * list->_sizeOfElement;
-        memset(pointerToEnd, 0, list->_actualBufferSize / 2 * list->_sizeOfElement);
-    }
-    memcpy(pointerToEnd, bytes, list->_sizeOfElement);
-    list->_length++;
-    return pointerToEnd;
-}
 
-void* LC_List_GetElement(const LC_List *list, uint32 index) {
-    if (index >= list->_length) return NULL;
+        const int32 middle = begin + size / 2;
+        if (size > SORT_NINTHER_THRESHOLD) {
+            LC_SortIntegers_Sort3(array, begin, middle, end - 1);
+            LC_SortIntegers_Sort3(array, begin + 1, middle - 1, end - 2);
+            LC_SortIntegers_Sort3(array, begin + 2, middle + 1, end - 3);
+            LC_SortIntegers_Sort3(array, middle - 1, middle, middle + 1);
+            LC_SortIntegers_Swap(array, begin, middle);
+        } else {
+            LC_SortIntegers_Sort3(array, middle, begin, end - 1);
+        }
 
-    return list->_data + index * list->_sizeOfElement;
-}
+        // Everything in a range that is not the leftmost is at least the element before it. A pivot equal to that
+        // element means a run of duplicates, the third way of the partition: they are gathered and skipped.
+        if (!isLeftmost && !(array[begin - 1] < array[begin])) {
+            begin = LC_SortIntegers_PartitionLeft(array, begin, end) + 1;
+            continue;
+        }
 
-void LC_List_Destroy(LC_List *list) {
-    list->_sizeOfElement = 0;
-    list->_actualBufferSize = 0;
-    list->_length = 0;
-    free(list->_data);
+        const int32 pivotPosition = LC_SortIntegers_PartitionRight(array, begin, end);
+        if (pivotPosition - begin < end - (pivotPosition + 1)) {
+            LC_SortIntegers_Loop(array, begin, pivotPosition, depthLimit, isLeftmost);
+            begin = pivotPosition + 1;
+            isLeftmost = false;
+        } else {
+            LC_SortIntegers_Loop(array, pivotPosition + 1, end, depthLimit, false);
+            end = pivotPosition;
+        }
+    }
 }
 
-// ===================================================================================================================
-// Sorting Algorithms
-// ===================================================================================================================
 void LC_QuickSortIntegers(int32 *array, const int32 length) {
-    srand(time(nullptr));
+    if (length < 2) return;
 
-    LC_QuickSortIntegersRecursive(array, 0, length - 1);
+    // Twice the depth of a perfectly balanced partition tree
+    int32 depthLimit = 0;
+    for (int32 n = length; n > 1; n >>= 1) depthLimit += 2;
+    LC_SortIntegers_Loop(array, 0, length, depthLimit, true);
 }
 
 // NOLINTNEXTLINE(misc-no-recursion)
@@ -343,64 +3947,274 @@ int32 LC_QSIntegersPartition(int32 *array, const int32 low, const int32 high) {
     return i;
 }
 
+// Bottom-up merge sort: runs of SORT_MERGE_RUN_LENGTH are insertion sorted, then neighbouring runs of doubling width
+// are merged. Only the left run of each merge is copied out, the right run is read in place because the merge can
+// never overtake it.
+static constexpr uint32 SORT_MERGE_RUN_LENGTH = 32;
+
+// Buffers for large arrays outgrow the reserve of the scratch arenas, those come from the heap instead
+static void* LC_Sort_AllocateBuffer(const TemporaryArenaMemory scratch, const size_t size, bool *isOnHeap) {
+    void *buffer = LC_AllocateAndAlignArenaNoZero(scratch.arena, size, LC_CACHE_LINE_SIZE);
+    *isOnHeap = buffer == NULL;
+    if (buffer == NULL) buffer = malloc(size);
+    assert(buffer != NULL && "Out of memory for the sort buffer");
+    return buffer;
+}
+
 void LC_MergeSortIntegers(int32 *array, const uint32 size) {
-    if (size <= 0) return;
-    LC_MergeSortIntegersRecursive(array, 0, (int32)size - 1);
+    if (size < 2) return;
+
+    const TemporaryArenaMemory scratch = LC_Scratch_Begin(nullptr, 0);
+    bool isOnHeap;
+    int32 *buffer = LC_Sort_AllocateBuffer(scratch, (size_t) size * sizeof(int32), &isOnHeap);
+    if (buffer != NULL) LC_MergeSortIntegersWithBuffer(array, size, buffer);
+    if (isOnHeap) free(buffer);
+    LC_Scratch_End(scratch);
 }
 
-// NOLINTNEXTLINE(misc-no-recursion)
-void LC_MergeSortIntegersRecursive(int32 *array, const int32 low, const int32 high) {
-    if (high <= low) return;
+void LC_MergeSortIntegersWithBuffer(int32 *array, const uint32 size, int32 *buffer) {
+    // 64 bit indices so stepping past the end of arrays close to UINT32_MAX elements can't wrap around
+    for (uint64 begin = 0; begin < size; begin += SORT_MERGE_RUN_LENGTH) {
+        const uint64 end = size - begin < SORT_MERGE_RUN_LENGTH ? size : begin + SORT_MERGE_RUN_LENGTH;
+        for (uint64 i = begin + 1; i < end; i++) {
+            const int32 value = array[i];
+            uint64 j = i;
+            while (j > begin && value < array[j - 1]) {
+                array[j] = array[j - 1];
+                j--;
+            }
+            array[j] = value;
+        }
+    }
+
+    for (uint64 width = SORT_MERGE_RUN_LENGTH; width < size; width *= 2) {
+        for (uint64 begin = 0; begin + width < size; begin += 2 * width) {
+            const uint64 middle = begin + width;
+            const uint64 end = size - middle < width ? size : middle + width;
+            // The runs are already in order, which makes sorted and mostly sorted input nearly free
+            if (!(array[middle] < array[middle - 1])) continue;
 
-    const int mid = low + (high - low) / 2;
-    LC_MergeSortIntegersRecursive(array, low, mid);
-    LC_MergeSortIntegersRecursive(array, mid + 1, high);
-    LC_MergeIntegers(array, low, mid, high);
+            memcpy(buffer, array + begin, width * sizeof(int32));
+            uint64 i = 0;
+            uint64 j = middle;
+            uint64 k = begin;
+            while (i < width && j < end) {
+                // Take from the right only when strictly smaller, which keeps equal elements in their order
+                const int32 left = buffer[i];
+                const int32 right = array[j];
+                const bool takeRight = right < left;
+                array[k++] = takeRight ? right : left;
+                j += takeRight;
+                i += !takeRight;
+            }
+            // What is left of the right run is already in place
+            memcpy(array + k, buffer + i, (width - i) * sizeof(int32));
+        }
+    }
 }
 
-void LC_MergeIntegers(int32 *array, const int32 low, const int32 mid, const int32 high) {
-    // Create left ← array[p..q] and right ← array[q+1..r]
-    const int32 n1 = mid - low + 1;
-    const int32 n2 = high - mid;
+// LSD radix sort over 8 bit digits. Keys are split into chunks that count their digits and then scatter them to the
+// offsets the counts give them, one chunk per thread in the parallel versions. Passes whose digit is the same in every
+// key are skipped. Signed and float keys are mapped to unsigned ones with the same order and back afterwards.
+static constexpr uint32 RADIX_BUCKET_COUNT = 256;
+// How many keys ahead the scatter prefetches the slot a key will be written to
+static constexpr uint32 RADIX_PREFETCH_DISTANCE = 16;
+
+typedef struct {
+    void *keys;
+    void *destinationKeys;
+    uint32 *values;
+    uint32 *destinationValues;
+    uint32 count;
+    uint32 chunkSize;
+    uint32 keyBytes;
+    uint32 shift;
+    // RADIX_BUCKET_COUNT counters per chunk
+    uint32 *histograms;
+} LC_RadixSortPass;
 
-    int32 left[n1], right[n2];
+static inline uint32 LC_RadixSort_Digit(const void *keys, const uint32 keyBytes, const uint32 index, const uint32 shift) {
+    if (keyBytes == 4) return (((const uint32 *) keys)[index] >> shift) & (RADIX_BUCKET_COUNT - 1);
+    return (uint32) (((const uint64 *) keys)[index] >> shift) & (RADIX_BUCKET_COUNT - 1);
+}
 
-    for (size_t i = 0; (int32)i < n1; i++)
-        left[i] = array[low + i];
-    for (size_t j = 0; (int32)j < n2; j++)
-        right[j] = array[mid + 1 + j];
+static void LC_RadixSort_CountChunk(void *userData, const uint32 chunk, const uint32 chunkEnd) {
+    (void)chunkEnd;
+    const LC_RadixSortPass *pass = userData;
+    const uint32 begin = chunk * pass->chunkSize;
+    const uint32 end = pass->count - begin < pass->chunkSize ? pass->count : begin + pass->chunkSize;
+    uint32 *histogram = pass->histograms + chunk * RADIX_BUCKET_COUNT;
+    memset(histogram, 0, RADIX_BUCKET_COUNT * sizeof(uint32));
+    if (pass->keyBytes == 4) {
+        const uint32 *keys = pass->keys;
+        for (uint32 i = begin; i < end; i++) histogram[(keys[i] >> pass->shift) & (RADIX_BUCKET_COUNT - 1)]++;
+    } else {
+        const uint64 *keys = pass->keys;
+        for (uint32 i = begin; i < end; i++) histogram[(keys[i] >> pass->shift) & (RADIX_BUCKET_COUNT - 1)]++;
+    }
+}
 
-    // Maintain current index of sub-arrays and main array
-    int32 i = 0;
-    int32 j = 0;
-    int32 k = low;
+// The histogram of the chunk holds its write offsets by now
+static void LC_RadixSort_ScatterChunk(void *userData, const uint32 chunk, const uint32 chunkEnd) {
+    (void)chunkEnd;
+    const LC_RadixSortPass *pass = userData;
+    const uint32 begin = chunk * pass->chunkSize;
+    const uint32 end = pass->count - begin < pass->chunkSize ? pass->count : begin + pass->chunkSize;
+    const uint32 shift = pass->shift;
+    uint32 *offsets = pass->histograms + chunk * RADIX_BUCKET_COUNT;
+    // Scattered writes are what the pass waits on, so the slot of a key a few iterations ahead is fetched early. Its
+    // offset may still move until then, but only within the same cache line or the next one.
+    const uint32 prefetchEnd = end - begin > RADIX_PREFETCH_DISTANCE ? end - RADIX_PREFETCH_DISTANCE : begin;
 
-    // Until we reach either end of either left or right, pick larger among
-    // elements of left and right and place them in the correct position at array[p..r]
-    while (i < n1 && j < n2) {
-        if (left[i] <= right[j]) {
-            array[k] = left[i];
-            i++;
-        } else {
-            array[k] = right[j];
-            j++;
+    if (pass->keyBytes == 4) {
+        const uint32 *keys = pass->keys;
+        uint32 *destination = pass->destinationKeys;
+        for (uint32 i = begin; i < end; i++) {
+            if (i < prefetchEnd) {
+                const uint32 ahead = (keys[i + RADIX_PREFETCH_DISTANCE] >> shift) & (RADIX_BUCKET_COUNT - 1);
+                __builtin_prefetch(&destination[offsets[ahead]], 1);
+            }
+            const uint32 key = keys[i];
+            const uint32 slot = offsets[(key >> shift) & (RADIX_BUCKET_COUNT - 1)]++;
+            destination[slot] = key;
+            if (pass->values != NULL) pass->destinationValues[slot] = pass->values[i];
         }
-        k++;
+    } else {
+        const uint64 *keys = pass->keys;
+        uint64 *destination = pass->destinationKeys;
+        for (uint32 i = begin; i < end; i++) {
+            if (i < prefetchEnd) {
+                const uint32 ahead = (uint32) (keys[i + RADIX_PREFETCH_DISTANCE] >> shift) & (RADIX_BUCKET_COUNT - 1);
+                __builtin_prefetch(&destination[offsets[ahead]], 1);
+            }
+            const uint64 key = keys[i];
+            const uint32 slot = offsets[(key >> shift) & (RADIX_BUCKET_COUNT - 1)]++;
+            destination[slot] = key;
+            if (pass->values != NULL) pass->destinationValues[slot] = pass->values[i];
+        }
+    }
+}
+
+// A null job system sorts on the calling thread
+static void LC_RadixSort(LC_JobSystem *system, void *keys, uint32 *values, const uint32 count, const uint32 keyBytes) {
+    if (count < 2) return;
+
+    const TemporaryArenaMemory scratch = LC_Scratch_Begin(nullptr, 0);
+    uint32 chunkCount = system != nullptr ? LC_JobSystem_GetThreadCount(system) : 1;
+    if (chunkCount > count) chunkCount = count;
+
+    // One buffer holds the copy of the keys, the copy of the values and every chunk's histogram
+    const size_t valuesOffset = (size_t) count * keyBytes;
+    size_t histogramsOffset = valuesOffset + (values != NULL ? (size_t) count * sizeof(uint32) : 0);
+    histogramsOffset = (histogramsOffset + LC_CACHE_LINE_SIZE - 1) & ~(size_t) (LC_CACHE_LINE_SIZE - 1);
+    const size_t bufferSize = histogramsOffset + (size_t) chunkCount * RADIX_BUCKET_COUNT * sizeof(uint32);
+    bool isOnHeap;
+    uchar *buffer = LC_Sort_AllocateBuffer(scratch, bufferSize, &isOnHeap);
+    if (buffer == NULL) {
+        LC_Scratch_End(scratch);
+        return;
     }
 
-    // When we run out of elements in either left or right,
-    // pick up the remaining elements and put in array[p..r]
-    while (i < n1) {
-        array[k] = left[i];
-        i++;
-        k++;
+    LC_RadixSortPass pass = {0};
+    pass.keys = keys;
+    pass.destinationKeys = buffer;
+    pass.values = values;
+    pass.destinationValues = values != NULL ? (uint32 *) (buffer + valuesOffset) : NULL;
+    pass.count = count;
+    pass.chunkSize = (uint32) (((uint64) count + chunkCount - 1) / chunkCount);
+    pass.keyBytes = keyBytes;
+    pass.histograms = (uint32 *) (buffer + histogramsOffset);
+
+    for (pass.shift = 0; pass.shift < keyBytes * 8; pass.shift += 8) {
+        if (chunkCount > 1) LC_JobSystem_ParallelFor(system, chunkCount, 1, LC_RadixSort_CountChunk, &pass);
+        else LC_RadixSort_CountChunk(&pass, 0, 1);
+
+        // Turn the counts into offsets: bucket by bucket, and within a bucket chunk by chunk so the sort stays stable
+        const uint32 firstDigit = LC_RadixSort_Digit(pass.keys, keyBytes, 0, pass.shift);
+        uint32 offset = 0;
+        bool isDigitConstant = false;
+        for (uint32 bucket = 0; bucket < RADIX_BUCKET_COUNT; bucket++) {
+            const uint32 bucketBegin = offset;
+            for (uint32 chunk = 0; chunk < chunkCount; chunk++) {
+                uint32 *counter = &pass.histograms[chunk * RADIX_BUCKET_COUNT + bucket];
+                const uint32 chunkCountInBucket = *counter;
+                *counter = offset;
+                offset += chunkCountInBucket;
+            }
+            if (bucket == firstDigit && offset - bucketBegin == count) isDigitConstant = true;
+        }
+        if (isDigitConstant) continue;
+
+        if (chunkCount > 1) LC_JobSystem_ParallelFor(system, chunkCount, 1, LC_RadixSort_ScatterChunk, &pass);
+        else LC_RadixSort_ScatterChunk(&pass, 0, 1);
+
+        void *swapKeys = pass.keys;
+        pass.keys = pass.destinationKeys;
+        pass.destinationKeys = swapKeys;
+        uint32 *swapValues = pass.values;
+        pass.values = pass.destinationValues;
+        pass.destinationValues = swapValues;
     }
 
-    while (j < n2) {
-        array[k] = right[j];
-        j++;
-        k++;
+    if (pass.keys != keys) {
+        memcpy(keys, pass.keys, (size_t) count * keyBytes);
+        if (values != NULL) memcpy(values, pass.values, (size_t) count * sizeof(uint32));
     }
+    if (isOnHeap) free(buffer);
+    LC_Scratch_End(scratch);
+}
+
+static void LC_RadixSort_FlipSigns(uint32 *keys, const uint32 count) {
+    for (uint32 i = 0; i < count; i++) keys[i] ^= 0x80000000u;
+}
+
+// Positive floats get their sign bit set, negative ones are inverted so larger magnitudes sort first
+static void LC_RadixSort_FloatsToKeys(uint32 *keys, const uint32 count) {
+    for (uint32 i = 0; i < count; i++) keys[i] ^= (uint32) -(int32) (keys[i] >> 31) | 0x80000000u;
+}
+
+static void LC_RadixSort_KeysToFloats(uint32 *keys, const uint32 count) {
+    for (uint32 i = 0; i < count; i++) keys[i] ^= ((keys[i] >> 31) - 1) | 0x80000000u;
+}
+
+void LC_RadixSortU32(uint32 *keys, uint32 *values, const uint32 count) {
+    LC_RadixSort(nullptr, keys, values, count, sizeof(uint32));
+}
+
+void LC_RadixSortI32(int32 *keys, uint32 *values, const uint32 count) {
+    LC_RadixSort_FlipSigns((uint32 *) keys, count);
+    LC_RadixSort(nullptr, keys, values, count, sizeof(uint32));
+    LC_RadixSort_FlipSigns((uint32 *) keys, count);
+}
+
+void LC_RadixSortF32(float *keys, uint32 *values, const uint32 count) {
+    LC_RadixSort_FloatsToKeys((uint32 *) keys, count);
+    LC_RadixSort(nullptr, keys, values, count, sizeof(uint32));
+    LC_RadixSort_KeysToFloats((uint32 *) keys, count);
+}
+
+void LC_RadixSortU64(uint64 *keys, uint32 *values, const uint32 count) {
+    LC_RadixSort(nullptr, keys, values, count, sizeof(uint64));
+}
+
+void LC_RadixSortU32Parallel(LC_JobSystem *system, uint32 *keys, uint32 *values, const uint32 count) {
+    LC_RadixSort(system, keys, values, count, sizeof(uint32));
+}
+
+void LC_RadixSortI32Parallel(LC_JobSystem *system, int32 *keys, uint32 *values, const uint32 count) {
+    LC_RadixSort_FlipSigns((uint32 *) keys, count);
+    LC_RadixSort(system, keys, values, count, sizeof(uint32));
+    LC_RadixSort_FlipSigns((uint32 *) keys, count);
+}
+
+void LC_RadixSortF32Parallel(LC_JobSystem *system, float *keys, uint32 *values, const uint32 count) {
+    LC_RadixSort_FloatsToKeys((uint32 *) keys, count);
+    LC_RadixSort(system, keys, values, count, sizeof(uint32));
+    LC_RadixSort_KeysToFloats((uint32 *) keys, count);
+}
+
+void LC_RadixSortU64Parallel(LC_JobSystem *system, uint64 *keys, uint32 *values, const uint32 count) {
+    LC_RadixSort(system, keys, values, count, sizeof(uint64));
 }
 
 // ===================================================================================================================
@@ -3,6 +3,9 @@
 
 #include <libraC.h>
 
+#include <stdint.h>
+#include <string.h>
+
 // ===================================================================================================================
 // #defines
 // ===================================================================================================================
@@ -20,6 +23,68 @@ do { \
 #define DEFAULT_ALIGNMENT (2*sizeof(void *))
 #endif
 
+// Initializer for an LC_String viewing a string literal: LC_String name = LC_STRING_LITERAL("name");
+#define LC_STRING_LITERAL(s) { sizeof(s) - 1, (char *) (s) }
+
+#if defined(__GNUC__)
+#define LC_PRINTF_FORMAT(formatIndex, firstArgument) __attribute__((format(printf, formatIndex, firstArgument)))
+#else
+#define LC_PRINTF_FORMAT(formatIndex, firstArgument)
+#endif
+
+// Returned by the byte and string search functions when there is no match
+#define LC_NOT_FOUND SIZE_MAX
+#define LC_STRING_NOT_FOUND UINT32_MAX
+
+// IDs handed out by a string interner start at 1, so 0 can mean "no string" in ID keyed arrays
+#define LC_STRING_ID_NONE 0
+// Every page holds 1024 strings, the default allows about a million interned strings
+#ifndef LC_STRING_INTERNER_MAX_PAGES
+#define LC_STRING_INTERNER_MAX_PAGES 1024
+#endif
+
+// Reads a file loader keeps in flight at once, and the most worker threads its thread backend starts
+#ifndef LC_FILE_LOADER_QUEUE_DEPTH
+#define LC_FILE_LOADER_QUEUE_DEPTH 256
+#endif
+#ifndef LC_FILE_LOADER_MAX_THREADS
+#define LC_FILE_LOADER_MAX_THREADS 16
+#endif
+
+#ifndef LC_FILE_STREAM_DEFAULT_CHUNK_SIZE
+#define LC_FILE_STREAM_DEFAULT_CHUNK_SIZE (4 * 1024 * 1024)
+#endif
+
+// Jobs each thread's deque holds, a power of two. A thread whose deque is full runs further jobs itself.
+#ifndef LC_JOB_QUEUE_CAPACITY
+#define LC_JOB_QUEUE_CAPACITY 4096
+#endif
+#define LC_JOB_THREAD_NONE UINT32_MAX
+
+#define LC_CACHE_LINE_SIZE 64
+
+// Atomic members of public structs. C++ code only hands these structs to the library, so it gets the plain type,
+// which has the same size and alignment for everything used here.
+#ifdef __cplusplus
+#define LC_ATOMIC(type) type
+#else
+#define LC_ATOMIC(type) _Atomic(type)
+#endif
+
+// Each thread owns this many scratch arenas, one more than the deepest chain of functions passing scratch memory on
+#ifndef LC_SCRATCH_ARENA_COUNT
+#define LC_SCRATCH_ARENA_COUNT 2
+#endif
+
+#ifndef LC_SCRATCH_ARENA_RESERVE_SIZE
+#define LC_SCRATCH_ARENA_RESERVE_SIZE (64 * 1024 * 1024)
+#endif
+
+// Two-level segregated fit heap: 32 first level size classes (powers of two), each split into 32 linear second level
+// classes
+#define LC_HEAP_FL_INDEX_COUNT 32
+#define LC_HEAP_SL_INDEX_COUNT 32
+
 // ===================================================================================================================
 // Structs
 // ===================================================================================================================
@@ -29,25 +94,383 @@ typedef struct {
     char *data;
 } LC_String;
 
+// Walks the tokens between delimiters of a string without copying them
+typedef struct {
+    LC_String remaining;
+    char delimiter;
+    bool isDone;
+} LC_StringSplitter;
+
+
+typedef void* (*LC_BackingAllocateFunction)(void *userData, size_t size);
+typedef void (*LC_BackingFreeFunction)(void *userData, void *memory, size_t size);
+
+// Where a growable arena gets its blocks from. 'allocate' being NULL means the arena is fixed to a single buffer.
+typedef struct {
+    LC_BackingAllocateFunction allocate;
+    LC_BackingFreeFunction free;
+    void *userData;
+} LC_ArenaBackingAllocator;
+
+// Header stored at the start of every block owned by a growable arena. The usable memory follows the header.
+typedef struct arenaBlock {
+    struct arenaBlock *previous;
+    uchar *buffer;
+    size_t bufferLength;
+    size_t previousOffset;
+    size_t currentOffset;
+    size_t allocationSize;
+} LC_ArenaBlock;
+
+typedef struct {
+    size_t capacity;
+    size_t used;
+} LC_ArenaBlockStats;
+
+typedef struct {
+    uint32 blockCount;
+    uint64 totalBlocksAllocated;
+    size_t reservedBytes;
+    size_t committedBytes;
+    size_t usedBytes;
+    size_t peakReservedBytes;
+} LC_ArenaStats;
+
+// When an arena clears memory: on every allocation, never, or in bulk whenever it is reset (FreeAll/EndTemporary)
+typedef enum {
+    LC_ARENA_ZERO_ALWAYS,
+    LC_ARENA_ZERO_NEVER,
+    LC_ARENA_ZERO_ON_RESET
+} LC_ArenaZeroPolicy;
 
 typedef struct {
     uchar *buffer;
     size_t bufferLength;
     size_t previousOffset;
     size_t currentOffset;
+    LC_ArenaZeroPolicy zeroPolicy;
+    LC_ArenaBlock *currentBlock;
+    LC_ArenaBackingAllocator backingAllocator;
+    size_t minimumBlockSize;
+    uint32 blockCount;
+    uint64 totalBlocksAllocated;
+    size_t reservedBytes;
+    size_t peakReservedBytes;
+    size_t virtualReservedLength;
+    size_t virtualRetainedLength;
 } LC_Arena;
 
+// Builds a string in an arena. The contents are always null terminated and move when the buffer has to grow, so views
+// taken with LC_StringBuilder_ToString are only valid until the next append.
 typedef struct {
     LC_Arena *arena;
+    char *data;
+    uint32 length;
+    uint32 capacity;
+} LC_StringBuilder;
+
+typedef struct {
+    LC_Arena *arena;
+    LC_ArenaBlock *block;
     size_t previousOffset;
     size_t currentOffset;
 } TemporaryArenaMemory;
 
+typedef struct poolFreeSlot {
+    struct poolFreeSlot *next;
+    uint64 magic;
+} LC_PoolFreeSlot;
+
+typedef struct poolChunk {
+    struct poolChunk *next;
+    uchar *firstSlot;
+    uchar *end;
+} LC_PoolChunk;
+
+typedef struct {
+    LC_Arena *arena;
+    LC_PoolFreeSlot *freeList;
+    LC_PoolChunk *firstChunk;
+    LC_PoolChunk *currentChunk;
+    uchar *cursor;
+    size_t slotSize;
+    size_t slotAlignment;
+    uint32 slotsPerChunk;
+    uint32 chunkCount;
+    size_t allocatedSlots;
+    size_t capacitySlots;
+    bool debugChecks;
+} LC_Pool;
+
+// Every heap block starts with this header. The free list links overlap the payload and are only valid while the
+// block is free.
+typedef struct heapBlock {
+    struct heapBlock *previousPhysical;
+    size_t size;
+    struct heapBlock *nextFree;
+    struct heapBlock *previousFree;
+} LC_HeapBlock;
+
+typedef struct {
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t freeBytes;
+    size_t largestFreeBlock;
+    uint32 usedBlockCount;
+    uint32 freeBlockCount;
+    uint32 regionCount;
+    float fragmentation;
+} LC_HeapStats;
+
+typedef struct {
+    LC_Arena *arena;
+    size_t growSize;
+    uint32 firstLevelBitmap;
+    uint32 secondLevelBitmap[LC_HEAP_FL_INDEX_COUNT];
+    LC_HeapBlock *freeLists[LC_HEAP_FL_INDEX_COUNT][LC_HEAP_SL_INDEX_COUNT];
+    size_t totalBytes;
+    size_t usedBytes;
+    uint32 usedBlockCount;
+    uint32 freeBlockCount;
+    uint32 regionCount;
+} LC_Heap;
+
+typedef void* (*LC_AllocateFunction)(void *userData, size_t size, size_t align);
+typedef void* (*LC_ResizeFunction)(void *userData, void *oldMemory, size_t oldSize, size_t newSize, size_t align);
+typedef void (*LC_FreeFunction)(void *userData, void *memory, size_t size);
+
+// A memory source that containers and loaders can be handed instead of calling malloc directly. The functions return
+// uninitialized memory, LC_Allocator_Allocate and LC_Allocator_Resize zero it like the arena does.
+typedef struct {
+    LC_AllocateFunction allocate;
+    LC_ResizeFunction resize;
+    LC_FreeFunction free;
+    void *userData;
+} LC_Allocator;
+
+// Wraps another allocator and counts what goes through it, to attribute memory to a subsystem
+typedef struct {
+    LC_Allocator parent;
+    const char *name;
+    size_t currentBytes;
+    size_t peakBytes;
+    uint64 allocationCount;
+    uint64 freeCount;
+} LC_TrackingAllocator;
+
+typedef struct {
+    uint64 low;
+    uint64 high;
+} LC_Hash128;
+
+// Incremental hashing for input that arrives in pieces, e.g. a file hashed while it is read. Finishing gives the same
+// value as hashing all of the input at once. A wide stream also computes the 128 bit hash at twice the cost.
+typedef struct {
+    uint64 seed[2];
+    uint64 see1[2];
+    uint64 see2[2];
+    uint64 totalLength;
+    uint64 stripeCount;
+    uchar buffer[64];
+    uint32 bufferLength;
+    bool wide;
+} LC_HashStream;
+
+// Access pattern hints for LC_File_Map, they can be combined
+typedef enum {
+    LC_FILE_HINT_NONE = 0,
+    LC_FILE_HINT_SEQUENTIAL = 1 << 0,
+    LC_FILE_HINT_RANDOM = 1 << 1,
+    LC_FILE_HINT_WILL_NEED = 1 << 2,
+} LC_FileHint;
+
+// Read-only contents of a file. Regular files are mapped so loading costs page faults instead of copies, anything
+// that can't be mapped (pipes, /proc files) is read into a heap buffer instead. The memory is not null terminated.
+typedef struct {
+    const uchar *data;
+    size_t length;
+    bool _isMapped;
+} LC_FileView;
+
+typedef enum {
+    LC_FILE_REQUEST_PENDING,
+    LC_FILE_REQUEST_LOADED,
+    LC_FILE_REQUEST_FAILED,
+} LC_FileRequestStatus;
+
+// io_uring where the kernel has it, worker threads everywhere else. Forcing the threads is mostly useful for tests.
+typedef enum {
+    LC_FILE_LOADER_BACKEND_DEFAULT,
+    LC_FILE_LOADER_BACKEND_THREADS,
+} LC_FileLoaderBackend;
+
+typedef struct fileRequest LC_FileRequest;
+typedef void (*LC_FileLoadedFunction)(LC_FileRequest *request, void *userData);
+
+typedef struct {
+    LC_FileRequest *requests;
+    uint32 count;
+    uint32 remaining;
+    uint32 failedCount;
+    LC_FileLoadedFunction onLoaded;
+    void *userData;
+} LC_FileBatch;
+
+// One file of a batch. The contents are read into the arena the batch was submitted with and are null terminated, so
+// text can be used in place; 'length' does not count the terminator.
+struct fileRequest {
+    const char *path;
+    uchar *data;
+    uint64 length;
+    LC_FileRequestStatus status;
+    LC_FileBatch *batch;
+    struct fileRequest *_next;
+    void *_file;
+    int32 _fileDescriptor;
+    uint64 _bytesRead;
+    bool _hasFailed;
+};
+
+// Reads whole batches of files in the background. The loader belongs to the thread that submits, polls and waits, the
+// completion callbacks run on that thread too, so they can create GPU resources.
+typedef struct {
+    LC_FileRequest *_pendingHead;
+    LC_FileRequest *_pendingTail;
+    LC_FileRequest *_completedHead;
+    LC_FileRequest *_completedTail;
+    void *_ring;
+    uint32 _inFlight;
+    SDL_Mutex *_mutex;
+    SDL_Condition *_workAvailable;
+    SDL_Condition *_workCompleted;
+    SDL_Thread *_threads[LC_FILE_LOADER_MAX_THREADS];
+    uint32 _threadCount;
+    bool _isShuttingDown;
+} LC_FileLoader;
+
+// Reads a file front to back in fixed size chunks, so only two chunks are ever in memory no matter how large the file
+// is. A background thread fills one buffer while the caller works on the other. 'fileSize' is 0 for pipes, the
+// stream then simply reads until the end of the input.
+typedef struct {
+    uint64 fileSize;
+    uint64 offset;
+    size_t chunkSize;
+    bool hasFailed;
+    void *_file;
+    uchar *_buffers[2];
+    size_t _lengths[2];
+    bool _isFull[2];
+    uint32 _readIndex;
+    uint64 _bytesReturned;
+    bool _isHoldingChunk;
+    bool _isReaderDone;
+    bool _isShuttingDown;
+    SDL_Thread *_thread;
+    SDL_Mutex *_mutex;
+    SDL_Condition *_chunkFilled;
+    SDL_Condition *_chunkReleased;
+} LC_FileStream;
+
+typedef uint64 (*LC_HashFunction)(const void *key);
+typedef bool (*LC_KeyEqualFunction)(const void *a, const void *b);
+
+// How a hash map hashes, compares and stores its keys. Keys are copied into the map by value, so an LC_String or C
+// string key stores the pointer and the characters have to outlive the map.
+typedef struct {
+    LC_HashFunction hash;
+    LC_KeyEqualFunction isEqual;
+    size_t keySize;
+} LC_HashMapKeyType;
+
+// Open addressing with Robin Hood probing. Each slot has a metadata word holding the upper hash bits and the probe
+// distance (0 marks an empty slot), removal shifts the following entries back so no tombstones are ever left behind.
+typedef struct {
+    uint32 *_metadata;
+    uchar *_keys;
+    uchar *_values;
+    uint32 _capacity;
+    uint32 _length;
+    size_t _valueSize;
+    size_t _allocationSize;
+    LC_HashMapKeyType _keyType;
+    LC_Allocator _allocator;
+} LC_HashMap;
+
+// Maps strings to dense IDs so they can be compared as integers and used to index flat arrays. Strings are copied
+// into the arena and live as long as it does; in thread safe mode the arena must not be used by anything else.
+typedef struct {
+    LC_Arena *arena;
+    LC_HashMap _map;
+    LC_String *_pages[LC_STRING_INTERNER_MAX_PAGES];
+    uint32 _count;
+    SDL_RWLock *_lock;
+} LC_StringInterner;
+
+// Bounded single producer, single consumer ring. Each side caches the other side's index and only reloads it when the
+// ring looks full or empty, so in steady state neither touches the other's cache line.
+typedef struct {
+    alignas(LC_CACHE_LINE_SIZE) LC_ATOMIC(uint64) _tail;
+    uint64 _cachedHead;
+    alignas(LC_CACHE_LINE_SIZE) LC_ATOMIC(uint64) _head;
+    uint64 _cachedTail;
+    alignas(LC_CACHE_LINE_SIZE) uchar *_buffer;
+    size_t _elementSize;
+    uint32 _capacity;
+} LC_SpscRing;
+
+// Bounded multi producer, multi consumer queue after Dmitry Vyukov. Every cell carries a sequence number that says
+// whether it is free or holds an element for the current lap, so producers and consumers only contend on their own
+// position counter.
+typedef struct {
+    alignas(LC_CACHE_LINE_SIZE) LC_ATOMIC(uint64) _enqueuePosition;
+    alignas(LC_CACHE_LINE_SIZE) LC_ATOMIC(uint64) _dequeuePosition;
+    alignas(LC_CACHE_LINE_SIZE) uchar *_cells;
+    size_t _cellSize;
+    size_t _elementSize;
+    uint32 _capacity;
+} LC_MpmcQueue;
+
+typedef void (*LC_JobFunction)(void *data);
+typedef void (*LC_ParallelForFunction)(void *userData, uint32 begin, uint32 end);
+
+// Number of jobs of a group that have not finished yet, starts at zero: LC_JobCounter counter = {0};
+typedef struct {
+    LC_ATOMIC(int32) _pending;
+} LC_JobCounter;
+
+// The job system only keeps pointers, a job has to stay in place until its counter reaches zero
+typedef struct {
+    LC_JobFunction function;
+    void *data;
+    LC_JobCounter *_counter;
+} LC_Job;
+
+// Chase-Lev deque: the owning thread pushes and pops at the bottom, idle threads steal from the top. Thieves write
+// 'top' while the owner works on 'bottom', so both get a cache line of their own.
+typedef struct {
+    alignas(LC_CACHE_LINE_SIZE) LC_ATOMIC(int64) _top;
+    alignas(LC_CACHE_LINE_SIZE) LC_ATOMIC(int64) _bottom;
+    alignas(LC_CACHE_LINE_SIZE) LC_ATOMIC(LC_Job *) _slots[LC_JOB_QUEUE_CAPACITY];
+} LC_JobDeque;
+
+// Thread 0 is the one that initialized the system, it runs jobs whenever it waits. Threads 1 and up are workers.
+typedef struct {
+    LC_JobDeque *_deques;
+    SDL_Thread **_threads;
+    void *_workerStarts;
+    uint32 _threadCount;
+    SDL_Semaphore *_wakeUp;
+    LC_ATOMIC(int32) _sleepingCount;
+    LC_ATOMIC(bool) _isShuttingDown;
+    bool _isPinned;
+} LC_JobSystem;
+
 typedef struct list {
     uchar *_data;
     uint32 _length;
     uint32 _actualBufferSize;
     size_t _sizeOfElement;
+    LC_Allocator _allocator;
 } LC_List;
 
 
@@ -60,6 +483,43 @@ void LC_String_InitializeByCopy(LC_Arena *arena, LC_String *string, const char *
 bool LC_String_IsEqualCString(const LC_String *string, const char *cString);
 bool LC_String_IsEqual(const LC_String *str1, const LC_String *str2);
 uint32 LC_GetStringLengthSkipSpaces(const char *string, uint32 length);
+uint32 LC_String_FindByte(const LC_String *string, char byte);
+uint32 LC_String_Find(const LC_String *string, const LC_String *needle);
+uint32 LC_String_CountByte(const LC_String *string, char byte);
+
+// Vectorized kernels the string functions are built on, usable on any byte range
+size_t LC_CString_GetLength(const char *cString);
+size_t LC_CString_GetLengthBounded(const char *cString, size_t maximum);
+bool LC_Bytes_IsEqual(const void *a, const void *b, size_t length);
+size_t LC_Bytes_FindByte(const void *data, size_t length, uchar byte);
+size_t LC_Bytes_Find(const void *haystack, size_t haystackLength, const void *needle, size_t needleLength);
+size_t LC_Bytes_CountByte(const void *data, size_t length, uchar byte);
+
+LC_String LC_String_Slice(const LC_String *string, uint32 start, uint32 end);
+LC_String LC_String_TrimLeft(const LC_String *string);
+LC_String LC_String_TrimRight(const LC_String *string);
+LC_String LC_String_Trim(const LC_String *string);
+bool LC_String_StartsWith(const LC_String *string, const LC_String *prefix);
+bool LC_String_EndsWith(const LC_String *string, const LC_String *suffix);
+bool LC_String_SplitOnce(const LC_String *string, char delimiter, LC_String *before, LC_String *after);
+void LC_StringSplitter_Initialize(LC_StringSplitter *splitter, const LC_String *string, char delimiter);
+bool LC_StringSplitter_Next(LC_StringSplitter *splitter, LC_String *token);
+
+// The whole string has to be the number, without surrounding spaces. Integers may be hexadecimal with a 0x prefix.
+bool LC_String_ParseInt64(const LC_String *string, int64 *value);
+bool LC_String_ParseInt32(const LC_String *string, int32 *value);
+bool LC_String_ParseDouble(const LC_String *string, double *value);
+bool LC_String_ParseFloat(const LC_String *string, float *value);
+
+void LC_StringBuilder_Initialize(LC_StringBuilder *builder, LC_Arena *arena, uint32 initialCapacity);
+bool LC_StringBuilder_Reserve(LC_StringBuilder *builder, uint32 capacity);
+bool LC_StringBuilder_AppendBytes(LC_StringBuilder *builder, const char *bytes, uint32 length);
+bool LC_StringBuilder_Append(LC_StringBuilder *builder, const LC_String *string);
+bool LC_StringBuilder_AppendCString(LC_StringBuilder *builder, const char *cString);
+bool LC_StringBuilder_AppendChar(LC_StringBuilder *builder, char c);
+bool LC_StringBuilder_AppendFormat(LC_StringBuilder *builder, const char *format, ...) LC_PRINTF_FORMAT(2, 3);
+LC_String LC_StringBuilder_ToString(const LC_StringBuilder *builder);
+void LC_StringBuilder_Clear(LC_StringBuilder *builder);
 
 // ===================================================================================================================
 // Utility Operations
@@ -73,44 +533,557 @@ void LC_SwapValues(void *x, void *y, size_t sizeOfElement, bool *success);
 bool LC_IsPowerOfTwo(uintptr_t x);
 uintptr_t LC_AlignForward(uintptr_t ptr, size_t align);
 void* LC_AllocateAndAlignArena(LC_Arena *arena, size_t size, size_t align);
+void* LC_AllocateAndAlignArenaNoZero(LC_Arena *arena, size_t size, size_t align);
 void* LC_Arena_Allocate(LC_Arena *arena, size_t size);
+void* LC_Arena_AllocateNoZero(LC_Arena *arena, size_t size);
 void LC_Arena_Initialize(LC_Arena *arena, void *backingBuffer, size_t backingBufferLength);
+void LC_Arena_SetZeroPolicy(LC_Arena *arena, LC_ArenaZeroPolicy zeroPolicy);
 void LC_Arena_Free(LC_Arena *arena, void *pointer);
 void* LC_Arena_ResizeAndAlign(LC_Arena *arena, void *oldMemory, size_t oldSize, size_t newSize, size_t align);
+void* LC_Arena_ResizeAndAlignNoZero(LC_Arena *arena, void *oldMemory, size_t oldSize, size_t newSize, size_t align);
 void* LC_Arena_Resize(LC_Arena *arena, void *oldMemory, size_t oldSize, size_t newSize);
+void* LC_Arena_ResizeNoZero(LC_Arena *arena, void *oldMemory, size_t oldSize, size_t newSize);
 void LC_Arena_FreeAll(LC_Arena *arena);
 
+bool LC_Arena_InitializeGrowable(LC_Arena *arena, LC_ArenaBackingAllocator backingAllocator, size_t minimumBlockSize);
+void LC_Arena_Destroy(LC_Arena *arena);
+LC_ArenaBackingAllocator LC_ArenaBacking_Malloc(void);
+LC_ArenaBackingAllocator LC_ArenaBacking_Pages(void);
+void LC_Arena_GetStats(const LC_Arena *arena, LC_ArenaStats *stats);
+uint32 LC_Arena_GetBlockStats(const LC_Arena *arena, LC_ArenaBlockStats *blockStats, uint32 maxBlocks);
+bool LC_Arena_InitializeVirtual(LC_Arena *arena, size_t reserveSize, size_t retainedCommitSize);
+
 TemporaryArenaMemory LC_Arena_BeginTemporaryMemory(LC_Arena *arena);
 void LC_Arena_EndTemporary(TemporaryArenaMemory temporaryArena);
 
+TemporaryArenaMemory LC_Scratch_Begin(LC_Arena **conflicts, uint32 conflictCount);
+void LC_Scratch_End(TemporaryArenaMemory scratch);
+void LC_Scratch_ReleaseThreadArenas(void);
+
+bool LC_Pool_Initialize(LC_Pool *pool, void *backingBuffer, size_t backingBufferLength, size_t slotSize,
+                        size_t slotAlignment);
+void LC_Pool_InitializeFromArena(LC_Pool *pool, LC_Arena *arena, size_t slotSize, size_t slotAlignment,
+                                 uint32 slotsPerChunk);
+void* LC_Pool_Allocate(LC_Pool *pool);
+bool LC_Pool_Free(LC_Pool *pool, void *pointer);
+void LC_Pool_FreeAll(LC_Pool *pool);
+void LC_Pool_SetDebugChecks(LC_Pool *pool, bool enabled);
+
+bool LC_Heap_Initialize(LC_Heap *heap, LC_Arena *arena, size_t size);
+void* LC_Heap_AllocateAndAlign(LC_Heap *heap, size_t size, size_t align);
+void* LC_Heap_Allocate(LC_Heap *heap, size_t size);
+void* LC_Heap_AllocateNoZero(LC_Heap *heap, size_t size);
+// Zeroes what the block gains. Memory from LC_Heap_AllocateNoZero has to be cleared up to
+// LC_Heap_GetAllocationSize by the caller for that to hold.
+void* LC_Heap_Resize(LC_Heap *heap, void *oldMemory, size_t newSize);
+void LC_Heap_Free(LC_Heap *heap, void *pointer);
+size_t LC_Heap_GetAllocationSize(const void *pointer);
+void LC_Heap_GetStats(const LC_Heap *heap, LC_HeapStats *stats);
+
+LC_Allocator LC_Allocator_Malloc(void);
+LC_Allocator LC_Allocator_FromArena(LC_Arena *arena);
+LC_Allocator LC_Allocator_FromHeap(LC_Heap *heap);
+LC_Allocator LC_Allocator_FromPool(LC_Pool *pool);
+LC_Allocator LC_Allocator_Tracking(LC_TrackingAllocator *tracking, LC_Allocator parent, const char *name);
+void* LC_Allocator_Allocate(const LC_Allocator *allocator, size_t size, size_t align);
+void* LC_Allocator_AllocateNoZero(const LC_Allocator *allocator, size_t size, size_t align);
+void* LC_Allocator_Resize(const LC_Allocator *allocator, void *oldMemory, size_t oldSize, size_t newSize, size_t align);
+void* LC_Allocator_ResizeNoZero(const LC_Allocator *allocator, void *oldMemory, size_t oldSize, size_t newSize,
+                                size_t align);
+void LC_Allocator_Free(const LC_Allocator *allocator, void *memory, size_t size);
+
 // ===================================================================================================================
 // File Operations
 // ===================================================================================================================
 
+bool LC_File_Map(LC_FileView *view, const char *filePath, uint32 hints, char *errorLog);
+void LC_File_Unmap(LC_FileView *view);
 void LC_GetFileContentString(LC_Arena *arena, const char *filePath, char **fileContents);
 bool LC_GetFileContentBinary(LC_Arena *arena, const char *filePath, uchar **fileContents, size_t *fileSize, char *errorLog);
+void LC_GetFileContentStringWithAllocator(const LC_Allocator *allocator, const char *filePath, char **fileContents,
+                                          size_t *allocationSize);
+bool LC_GetFileContentBinaryWithAllocator(const LC_Allocator *allocator, const char *filePath, uchar **fileContents,
+                                          size_t *fileSize, char *errorLog);
+
+// ASYNC LOADING
+// Only regular files can be loaded this way, LC_File_Map handles pipes and /proc. A thread count of 0 means one worker
+// per logical core, io_uring needs no workers at all.
+bool LC_FileLoader_Initialize(LC_FileLoader *loader, LC_FileLoaderBackend backend, uint32 threadCount);
+// Files are opened and their buffers allocated from 'arena' right away, the reads themselves happen in the background.
+// Files that can't be opened fail without stopping the rest of the batch. The paths must outlive the batch.
+bool LC_FileLoader_Submit(LC_FileLoader *loader, LC_FileBatch *batch, LC_Arena *arena, const char *const *filePaths,
+                          uint32 count, LC_FileLoadedFunction onLoaded, void *userData);
+// Finishes every request that completed since the last call and runs its callback, returns how many that were
+uint32 LC_FileLoader_Poll(LC_FileLoader *loader);
+void LC_FileLoader_Wait(LC_FileLoader *loader, const LC_FileBatch *batch);
+bool LC_FileBatch_IsDone(const LC_FileBatch *batch);
+// Waits for everything still in flight, the reads write into arena memory that must stay valid until then
+void LC_FileLoader_Destroy(LC_FileLoader *loader);
+// Loads a batch with a short-lived loader and waits for it, true when every file was read
+bool LC_File_LoadAll(LC_Arena *arena, const char *const *filePaths, uint32 count, LC_FileBatch *batch);
+
+// STREAMING
+// The two chunk buffers come from 'arena', a chunk size of 0 picks LC_FILE_STREAM_DEFAULT_CHUNK_SIZE
+bool LC_FileStream_Open(LC_FileStream *stream, LC_Arena *arena, const char *filePath, size_t chunkSize,
+                        char *errorLog);
+// Hands out the next chunk, which stays valid until the following call. Every chunk but the last is 'chunkSize'
+// long. Returns false at the end of the file, 'hasFailed' tells a read error apart from the end.
+bool LC_FileStream_Next(LC_FileStream *stream, const uchar **chunk, size_t *length);
+void LC_FileStream_Close(LC_FileStream *stream);
+
+// ===================================================================================================================
+// Hashing
+// ===================================================================================================================
+// Fast non-cryptographic hashes. The values are stable across runs and platforms of the same endianness, so they can
+// be stored as cache keys.
+
+uint64 LC_Hash_Bytes64(const void *data, size_t length, uint64 seed);
+LC_Hash128 LC_Hash_Bytes128(const void *data, size_t length, uint64 seed);
+uint64 LC_Hash_String64(const LC_String *string, uint64 seed);
+LC_Hash128 LC_Hash_String128(const LC_String *string, uint64 seed);
+uint64 LC_Hash_U64(uint64 value, uint64 seed);
+bool LC_Hash_IsEqual128(LC_Hash128 a, LC_Hash128 b);
+
+void LC_HashStream_Initialize(LC_HashStream *stream, uint64 seed, bool wide);
+void LC_HashStream_Update(LC_HashStream *stream, const void *data, size_t length);
+uint64 LC_HashStream_Finish64(const LC_HashStream *stream);
+LC_Hash128 LC_HashStream_Finish128(const LC_HashStream *stream);
+
+// Hash many keys in one call, 'hashes[i]' equals LC_Hash_U64(keys[i], seed) or LC_Hash_String64(&strings[i], seed)
+void LC_Hash_BatchU64(const uint64 *keys, uint64 *hashes, size_t count, uint64 seed);
+void LC_Hash_BatchU32(const uint32 *keys, uint64 *hashes, size_t count, uint64 seed);
+void LC_Hash_BatchStrings(const LC_String *strings, uint64 *hashes, size_t count, uint64 seed);
 
 // ===================================================================================================================
 // Data Structures
 // ===================================================================================================================
 
 void LC_List_Initialize(LC_List *list, size_t sizeOfElement);
+void LC_List_InitializeWithAllocator(LC_List *list, size_t sizeOfElement, LC_Allocator allocator);
 uint32 LC_List_GetLength(const LC_List *list);
 void* LC_List_GetData(const LC_List *list);
 void* LC_List_AddElement(LC_List *list, const void *element);
 void* LC_List_GetElement(const LC_List *list, uint32 index);
 void LC_List_Destroy(LC_List *list);
 
+// Typed dynamic array. LC_DEFINE_LIST(int32) defines LC_List_int32 and its LC_List_int32_* functions with the element
+// size known at compile time. Use LC_DEFINE_LIST_NAMED for types whose name is not a single identifier.
+#define LC_DEFINE_LIST(type) LC_DEFINE_LIST_NAMED(type, LC_List_##type)
+
+#define LC_DEFINE_LIST_NAMED(type, name) \
+typedef struct { \
+    type *data; \
+    uint32 length; \
+    uint32 capacity; \
+    LC_Allocator allocator; \
+} name; \
+\
+static inline void name##_Initialize(name *list, const LC_Allocator allocator) { \
+    list->data = NULL; \
+    list->length = 0; \
+    list->capacity = 0; \
+    list->allocator = allocator; \
+} \
+\
+static inline bool name##_Reserve(name *list, const uint32 capacity) { \
+    if (capacity <= list->capacity) return true; \
+    type *data = (type *) LC_Allocator_ResizeNoZero(&list->allocator, list->data, (size_t) list->capacity * sizeof(type), \
+                                                    (size_t) capacity * sizeof(type), DEFAULT_ALIGNMENT); \
+    if (data == NULL) return false; \
+    list->data = data; \
+    list->capacity = capacity; \
+    return true; \
+} \
+\
+static inline bool name##_Grow(name *list, const uint32 minimumCapacity) { \
+    uint32 capacity = list->capacity < 16 ? 16 : list->capacity; \
+    while (capacity < minimumCapacity) { \
+        capacity = capacity > UINT32_MAX / 2 ? UINT32_MAX : capacity * 2; \
+    } \
+    return name##_Reserve(list, capacity); \
+} \
+\
+static inline type* name##_Append(name *list, const type value) { \
+    if (list->length == list->capacity && !name##_Grow(list, list->length + 1)) return NULL; \
+    type *element = &list->data[list->length++]; \
+    *element = value; \
+    return element; \
+} \
+\
+static inline type* name##_AppendN(name *list, const type *values, const uint32 count) { \
+    if (list->length + count > list->capacity && !name##_Grow(list, list->length + count)) return NULL; \
+    type *first = &list->data[list->length]; \
+    memcpy(first, values, (size_t) count * sizeof(type)); \
+    list->length += count; \
+    return first; \
+} \
+\
+static inline type* name##_Get(const name *list, const uint32 index) { \
+    if (index >= list->length) return NULL; \
+    return &list->data[index]; \
+} \
+\
+static inline type* name##_Insert(name *list, const uint32 index, const type value) { \
+    if (index > list->length) return NULL; \
+    if (list->length == list->capacity && !name##_Grow(list, list->length + 1)) return NULL; \
+    memmove(&list->data[index + 1], &list->data[index], (size_t) (list->length - index) * sizeof(type)); \
+    list->data[index] = value; \
+    list->length++; \
+    return &list->data[index]; \
+} \
+\
+static inline void name##_Remove(name *list, const uint32 index) { \
+    if (index >= list->length) return; \
+    memmove(&list->data[index], &list->data[index + 1], (size_t) (list->length - index - 1) * sizeof(type)); \
+    list->length--; \
+} \
+\
+static inline void name##_SwapRemove(name *list, const uint32 index) { \
+    if (index >= list->length) return; \
+    list->data[index] = list->data[--list->length]; \
+} \
+\
+static inline void name##_Clear(name *list) { \
+    list->length = 0; \
+} \
+\
+static inline bool name##_ShrinkToFit(name *list) { \
+    if (list->length == list->capacity) return true; \
+    if (list->length == 0) { \
+        LC_Allocator_Free(&list->allocator, list->data, (size_t) list->capacity * sizeof(type)); \
+        list->data = NULL; \
+        list->capacity = 0; \
+        return true; \
+    } \
+    type *data = (type *) LC_Allocator_ResizeNoZero(&list->allocator, list->data, (size_t) list->capacity * sizeof(type), \
+                                                    (size_t) list->length * sizeof(type), DEFAULT_ALIGNMENT); \
+    if (data == NULL) return false; \
+    list->data = data; \
+    list->capacity = list->length; \
+    return true; \
+} \
+\
+static inline void name##_Destroy(name *list) { \
+    LC_Allocator_Free(&list->allocator, list->data, (size_t) list->capacity * sizeof(type)); \
+    list->data = NULL; \
+    list->length = 0; \
+    list->capacity = 0; \
+}
+
+LC_HashMapKeyType LC_HashMapKey_String(void);
+LC_HashMapKeyType LC_HashMapKey_CString(void);
+LC_HashMapKeyType LC_HashMapKey_Int32(void);
+LC_HashMapKeyType LC_HashMapKey_Int64(void);
+void LC_HashMap_Initialize(LC_HashMap *map, LC_HashMapKeyType keyType, size_t valueSize, LC_Allocator allocator);
+bool LC_HashMap_Reserve(LC_HashMap *map, uint32 count);
+void* LC_HashMap_Insert(LC_HashMap *map, const void *key, const void *value);
+void* LC_HashMap_Get(const LC_HashMap *map, const void *key);
+bool LC_HashMap_Contains(const LC_HashMap *map, const void *key);
+bool LC_HashMap_Remove(LC_HashMap *map, const void *key);
+uint32 LC_HashMap_GetLength(const LC_HashMap *map);
+bool LC_HashMap_Next(const LC_HashMap *map, uint32 *iterator, void **key, void **value);
+void LC_HashMap_Clear(LC_HashMap *map);
+void LC_HashMap_Destroy(LC_HashMap *map);
+
+bool LC_StringInterner_Initialize(LC_StringInterner *interner, LC_Arena *arena, bool isThreadSafe);
+uint32 LC_StringInterner_Intern(LC_StringInterner *interner, const LC_String *string);
+uint32 LC_StringInterner_InternCString(LC_StringInterner *interner, const char *cString);
+uint32 LC_StringInterner_Find(LC_StringInterner *interner, const LC_String *string);
+LC_String LC_StringInterner_GetString(const LC_StringInterner *interner, uint32 id);
+uint32 LC_StringInterner_GetCount(LC_StringInterner *interner);
+void LC_StringInterner_Destroy(LC_StringInterner *interner);
+
+// The capacity is rounded up to a power of two and the storage comes from the arena. Elements are copied in and out
+// by value. The batch functions move as many elements as fit or are available and return how many that were.
+bool LC_SpscRing_Initialize(LC_SpscRing *ring, LC_Arena *arena, uint32 capacity, size_t elementSize);
+bool LC_SpscRing_Push(LC_SpscRing *ring, const void *element);
+bool LC_SpscRing_Pop(LC_SpscRing *ring, void *element);
+uint32 LC_SpscRing_PushBatch(LC_SpscRing *ring, const void *elements, uint32 count);
+uint32 LC_SpscRing_PopBatch(LC_SpscRing *ring, void *elements, uint32 maxCount);
+uint32 LC_SpscRing_GetCount(LC_SpscRing *ring);
+
+bool LC_MpmcQueue_Initialize(LC_MpmcQueue *queue, LC_Arena *arena, uint32 capacity, size_t elementSize);
+bool LC_MpmcQueue_Push(LC_MpmcQueue *queue, const void *element);
+bool LC_MpmcQueue_Pop(LC_MpmcQueue *queue, void *element);
+uint32 LC_MpmcQueue_PushBatch(LC_MpmcQueue *queue, const void *elements, uint32 count);
+uint32 LC_MpmcQueue_PopBatch(LC_MpmcQueue *queue, void *elements, uint32 maxCount);
+
+// ===================================================================================================================
+// Job System
+// ===================================================================================================================
+// A worker count of 0 starts one worker per logical core besides the calling thread. Pinned workers are bound to a
+// core each. Jobs can be run from the initializing thread and from inside jobs; a job that waits runs other jobs in
+// the meantime, which is how dependencies are expressed. Jobs get temporary memory with LC_Scratch_Begin, every
+// worker has its own scratch arenas.
+bool LC_JobSystem_Initialize(LC_JobSystem *system, LC_Arena *arena, uint32 workerCount, bool pinWorkers);
+void LC_JobSystem_Run(LC_JobSystem *system, LC_Job *jobs, uint32 count, LC_JobCounter *counter);
+void LC_JobSystem_Wait(LC_JobSystem *system, LC_JobCounter *counter);
+bool LC_JobCounter_IsDone(const LC_JobCounter *counter);
+// Calls 'function' on ranges of at most 'batchSize' indices covering [0, count) and waits for all of them. A batch
+// size of 0 gives every thread a few batches, so stealing can even out uneven work.
+void LC_JobSystem_ParallelFor(LC_JobSystem *system, uint32 count, uint32 batchSize, LC_ParallelForFunction function,
+                              void *userData);
+uint32 LC_JobSystem_GetThreadCount(const LC_JobSystem *system);
+// Index of the calling thread within its job system, LC_JOB_THREAD_NONE for threads outside of one. Useful to give
+// every thread its own slot in an array of partial results.
+uint32 LC_JobSystem_GetThreadIndex(void);
+void LC_JobSystem_Destroy(LC_JobSystem *system);
+
 // ===================================================================================================================
 // Sorting Algorithms
 // ===================================================================================================================
+// Introsort: O(n log n) in the worst case, no allocations and a recursion depth of at most log2(length)
 void LC_QuickSortIntegers(int32 *array, int32 length);
+// The plain recursive quicksort on [low, high] with a random Lomuto pivot. Inputs with many duplicates make it quadratic.
 void LC_QuickSortIntegersRecursive(int32 *array, int32 low, int32 high);
 int32 LC_QSIntegersPartition(int32 *array, int32 low, int32 high);
 
+// Stable, non recursive merge sort. The buffer of 'size' elements comes from the thread's scratch arena, or from the
+// heap when it doesn't fit there.
 void LC_MergeSortIntegers(int32 *array, uint32 size);
-void LC_MergeSortIntegersRecursive(int32 *array, int32 low, int32 high);
-void LC_MergeIntegers(int32 *array, int32 low, int32 mid, int32 high);
+// Same as LC_MergeSortIntegers with a caller provided buffer that has room for 'size' elements
+void LC_MergeSortIntegersWithBuffer(int32 *array, uint32 size, int32 *buffer);
+// Stable LSD radix sorts. 'values' is an optional payload, for example indices into an array of records, that is
+// moved along with the keys, pass NULL to sort keys only. Temporary memory for a copy of both comes from the calling
+// thread's scratch arena or the heap, like for LC_MergeSortIntegers. Floats sort by IEEE order with -0 before 0, NaNs
+// end up at either end depending on their sign.
+void LC_RadixSortU32(uint32 *keys, uint32 *values, uint32 count);
+void LC_RadixSortI32(int32 *keys, uint32 *values, uint32 count);
+void LC_RadixSortF32(float *keys, uint32 *values, uint32 count);
+void LC_RadixSortU64(uint64 *keys, uint32 *values, uint32 count);
+// The same sorts with every thread of the job system counting and scattering its own chunk of the keys
+void LC_RadixSortU32Parallel(LC_JobSystem *system, uint32 *keys, uint32 *values, uint32 count);
+void LC_RadixSortI32Parallel(LC_JobSystem *system, int32 *keys, uint32 *values, uint32 count);
+void LC_RadixSortF32Parallel(LC_JobSystem *system, float *keys, uint32 *values, uint32 count);
+void LC_RadixSortU64Parallel(LC_JobSystem *system, uint64 *keys, uint32 *values, uint32 count);
+
+// Typed sorting and searching. LC_DEFINE_SORT(Sprite, LC_Sprites, a->depth < b->depth) defines LC_Sprites_Sort,
+// LC_Sprites_BinarySearch, LC_Sprites_LowerBound, LC_Sprites_UpperBound, LC_Sprites_PartialSort and
+// LC_Sprites_NthElement for arrays of Sprite. The last argument is an expression that is true when the element 'a'
+// points to orders before the one 'b' points to; it is compiled into the loops instead of being called through a
+// pointer like qsort's comparator. The sort is an introsort like LC_QuickSortIntegers and not stable.
+#define LC_DEFINE_SORT(type, name, ...) \
+static inline bool name##_IsLess(const type *a, const type *b) { \
+    return (__VA_ARGS__); \
+} \
+\
+static inline void name##_Swap(type *a, type *b) { \
+    const type temp = *a; \
+    *a = *b; \
+    *b = temp; \
+} \
+\
+static inline void name##_Sort3(type *a, type *b, type *c) { \
+    if (name##_IsLess(b, a)) name##_Swap(a, b); \
+    if (name##_IsLess(c, b)) name##_Swap(b, c); \
+    if (name##_IsLess(b, a)) name##_Swap(a, b); \
+} \
+\
+static inline void name##_InsertionSort(type *array, const size_t count) { \
+    for (size_t i = 1; i < count; i++) { \
+        if (!name##_IsLess(&array[i], &array[i - 1])) continue; \
+        const type value = array[i]; \
+        size_t j = i; \
+        do { \
+            array[j] = array[j - 1]; \
+            j--; \
+        } while (j > 0 && name##_IsLess(&value, &array[j - 1])); \
+        array[j] = value; \
+    } \
+} \
+\
+static inline void name##_SiftDown(type *array, size_t root, const size_t count) { \
+    const type value = array[root]; \
+    for (;;) { \
+        size_t child = 2 * root + 1; \
+        if (child >= count) break; \
+        if (child + 1 < count && name##_IsLess(&array[child], &array[child + 1])) child++; \
+        if (!name##_IsLess(&value, &array[child])) break; \
+        array[root] = array[child]; \
+        root = child; \
+    } \
+    array[root] = value; \
+} \
+\
+static inline void name##_MakeHeap(type *array, const size_t count) { \
+    for (size_t i = count / 2; i > 0; i--) name##_SiftDown(array, i - 1, count); \
+} \
+\
+static inline void name##_SortHeap(type *array, size_t count) { \
+    while (count > 1) { \
+        name##_Swap(&array[0], &array[--count]); \
+        name##_SiftDown(array, 0, count); \
+    } \
+} \
+\
+/* Leaves the median of three, or of three medians of three, at array[0] with an element on each side that stops the
+   unguarded partition loops */ \
+static inline void name##_ChoosePivot(type *array, const size_t count) { \
+    const size_t middle = count / 2; \
+    if (count > 128) { \
+        name##_Sort3(&array[0], &array[middle], &array[count - 1]); \
+        name##_Sort3(&array[1], &array[middle - 1], &array[count - 2]); \
+        name##_Sort3(&array[2], &array[middle + 1], &array[count - 3]); \
+        name##_Sort3(&array[middle - 1], &array[middle], &array[middle + 1]); \
+        name##_Swap(&array[0], &array[middle]); \
+    } else { \
+        name##_Sort3(&array[middle], &array[0], &array[count - 1]); \
+    } \
+} \
+\
+/* Smaller elements go left of the pivot, the rest right of it, returns where the pivot ends up */ \
+static inline size_t name##_PartitionRight(type *array, const size_t count) { \
+    const type pivot = array[0]; \
+    size_t first = 0; \
+    size_t last = count; \
+    while (name##_IsLess(&array[++first], &pivot)) {} \
+    if (first == 1) { \
+        while (first < last && !name##_IsLess(&array[--last], &pivot)) {} \
+    } else { \
+        while (!name##_IsLess(&array[--last], &pivot)) {} \
+    } \
+    while (first < last) { \
+        name##_Swap(&array[first], &array[last]); \
+        while (name##_IsLess(&array[++first], &pivot)) {} \
+        while (!name##_IsLess(&array[--last], &pivot)) {} \
+    } \
+    array[0] = array[first - 1]; \
+    array[first - 1] = pivot; \
+    return first - 1; \
+} \
+\
+/* For ranges without elements that order before the pivot: the ones equal to it go left and are done */ \
+static inline size_t name##_PartitionLeft(type *array, const size_t count) { \
+    const type pivot = array[0]; \
+    size_t first = 0; \
+    size_t last = count; \
+    while (name##_IsLess(&pivot, &array[--last])) {} \
+    if (last + 1 == count) { \
+        while (first < last && !name##_IsLess(&pivot, &array[++first])) {} \
+    } else { \
+        while (!name##_IsLess(&pivot, &array[++first])) {} \
+    } \
+    while (first < last) { \
+        name##_Swap(&array[first], &array[last]); \
+        while (name##_IsLess(&pivot, &array[--last])) {} \
+        while (!name##_IsLess(&pivot, &array[++first])) {} \
+    } \
+    array[0] = array[last]; \
+    array[last] = pivot; \
+    return last; \
+} \
+\
+static inline uint32 name##_DepthLimit(size_t count) { \
+    uint32 depthLimit = 0; \
+    for (; count > 1; count >>= 1) depthLimit += 2; \
+    return depthLimit; \
+} \
+\
+/* NOLINTNEXTLINE(misc-no-recursion) */ \
+static void name##_SortLoop(type *array, size_t count, uint32 depthLimit, bool isLeftmost) { \
+    for (;;) { \
+        if (count < 24) { \
+            name##_InsertionSort(array, count); \
+            return; \
+        } \
+        if (depthLimit-- == 0) { \
+            name##_MakeHeap(array, count); \
+            name##_SortHeap(array, count); \
+            return; \
+        } \
+        name##_ChoosePivot(array, count); \
+        if (!isLeftmost && !name##_IsLess(&array[-1], &array[0])) { \
+            const size_t equalEnd = name##_PartitionLeft(array, count) + 1; \
+            array += equalEnd; \
+            count -= equalEnd; \
+            continue; \
+        } \
+        const size_t pivot = name##_PartitionRight(array, count); \
+        if (pivot < count - pivot - 1) { \
+            name##_SortLoop(array, pivot, depthLimit, isLeftmost); \
+            array += pivot + 1; \
+            count -= pivot + 1; \
+            isLeftmost = false; \
+        } else { \
+            name##_SortLoop(array + pivot + 1, count - pivot - 1, depthLimit, false); \
+            count = pivot; \
+        } \
+    } \
+} \
+\
+static inline void name##_Sort(type *array, const size_t count) { \
+    if (count < 2) return; \
+    name##_SortLoop(array, count, name##_DepthLimit(count), true); \
+} \
+\
+/* Index of the first element that does not order before 'key', 'count' if there is none */ \
+static inline size_t name##_LowerBound(const type *array, size_t count, const type *key) { \
+    const type *first = array; \
+    while (count > 0) { \
+        const size_t half = count / 2; \
+        const bool isBefore = name##_IsLess(&first[half], key); \
+        first = isBefore ? first + half + 1 : first; \
+        count = isBefore ? count - half - 1 : half; \
+    } \
+    return (size_t) (first - array); \
+} \
+\
+/* Index of the first element that 'key' orders before, 'count' if there is none */ \
+static inline size_t name##_UpperBound(const type *array, size_t count, const type *key) { \
+    const type *first = array; \
+    while (count > 0) { \
+        const size_t half = count / 2; \
+        const bool isBefore = !name##_IsLess(key, &first[half]); \
+        first = isBefore ? first + half + 1 : first; \
+        count = isBefore ? count - half - 1 : half; \
+    } \
+    return (size_t) (first - array); \
+} \
+\
+/* Index of an element equivalent to 'key' in a sorted array, LC_NOT_FOUND if there is none */ \
+static inline size_t name##_BinarySearch(const type *array, const size_t count, const type *key) { \
+    const size_t index = name##_LowerBound(array, count, key); \
+    if (index == count || name##_IsLess(key, &array[index])) return LC_NOT_FOUND; \
+    return index; \
+} \
+\
+/* Moves the 'sortedCount' smallest elements to the front in order, the rest end up behind them in no order */ \
+static inline void name##_PartialSort(type *array, const size_t count, size_t sortedCount) { \
+    if (sortedCount > count) sortedCount = count; \
+    if (sortedCount == 0) return; \
+    name##_MakeHeap(array, sortedCount); \
+    for (size_t i = sortedCount; i < count; i++) { \
+        if (name##_IsLess(&array[i], &array[0])) { \
+            name##_Swap(&array[i], &array[0]); \
+            name##_SiftDown(array, 0, sortedCount); \
+        } \
+    } \
+    name##_SortHeap(array, sortedCount); \
+} \
+\
+/* Puts the element that a full sort would put at 'n' there, with no element after it ordering before the ones in
+   front of it */ \
+static inline void name##_NthElement(type *array, size_t count, size_t n) { \
+    if (n >= count) return; \
+    uint32 depthLimit = name##_DepthLimit(count); \
+    while (count >= 24) { \
+        if (depthLimit-- == 0) { \
+            name##_PartialSort(array, count, n + 1); \
+            return; \
+        } \
+        name##_ChoosePivot(array, count); \
+        const size_t pivot = name##_PartitionRight(array, count); \
+        if (pivot == n) return; \
+        if (n < pivot) { \
+            count = pivot; \
+        } else { \
+            array += pivot + 1; \
+            count -= pivot + 1; \
+            n -= pivot + 1; \
+        } \
+    } \
+    name##_InsertionSort(array, count); \
+}
 
 // ===================================================================================================================
 // Environment Information
@@ -10,7 +10,7 @@
 #include <stb_image.h>
 
 
-static constexpr GLuint TEXT_STARTING_BUFFER_SIZE = 3600; // 4(sizeof(float)) * 100(Vertices) * 9 (Number of float per vertex)
+static constexpr GLsizeiptr TEXT_STREAM_SEGMENT_SIZE = 64 * 1024; // About 450 glyphs of 4 vertices with 9 floats each
 
 // ==================================================================================================================
 // Video Errors
@@ -109,20 +109,44 @@ void LC_GL_SetUniformMat4(const GLuint programId, const char *name, const mat4 *
     GLCall(glUniformMatrix4fv(glGetUniformLocation(programId, name), 1, GL_FALSE, mat[0][0]));
 }
 
-bool LC_GL_InitializeShader(LC_Arena *arena, LC_GL_Shader *shader, char *errorLog) {
-    const TemporaryArenaMemory localArena = LC_Arena_BeginTemporaryMemory(arena);
+GLint LC_GL_GetUniformLocation(const LC_GL_Renderer *renderer, LC_GL_Shader *shader, const uint32 nameId) {
+    // The name is only looked up by the driver the first time, after that it is an array read
+    if (nameId < LC_GL_CACHED_UNIFORM_COUNT && shader->uniformLocations[nameId] != LC_GL_UNIFORM_NOT_CACHED) {
+        return shader->uniformLocations[nameId];
+    }
+    const char *name = LC_StringInterner_GetString(renderer->names, nameId).data;
+
+    GLint location;
+    GLCall(location = glGetUniformLocation(shader->programId, name));
+    if (nameId < LC_GL_CACHED_UNIFORM_COUNT) shader->uniformLocations[nameId] = location;
+    return location;
+}
 
+bool LC_GL_InitializeShader(LC_Arena *arena, LC_GL_Shader *shader, char *errorLog) {
+    // The shader sources only live until the program is linked, the caller's arena is passed as a conflict so the
+    // scratch memory can never be the memory the caller is using
+    const TemporaryArenaMemory localArena = LC_Scratch_Begin(&arena, 1);
+
+    // Both sources are read as one batch, so the second read doesn't wait for the first one to come back
+    const char *sourcePaths[2] = {shader->vertexShaderPath->data, shader->fragmentShaderPath->data};
+    LC_FileBatch sources;
+    LC_File_LoadAll(localArena.arena, sourcePaths, 2, &sources);
     char *vertexShaderSource = nullptr;
     char *fragmentShaderSource = nullptr;
-    LC_GetFileContentString(localArena.arena, shader->vertexShaderPath->data, &vertexShaderSource);
-    LC_GetFileContentString(localArena.arena, shader->fragmentShaderPath->data, &fragmentShaderSource);
+    if (sources.count == 2 && sources.requests[0].status == LC_FILE_REQUEST_LOADED) {
+        vertexShaderSource = (char *) sources.requests[0].data;
+    }
+    if (sources.count == 2 && sources.requests[1].status == LC_FILE_REQUEST_LOADED) {
+        fragmentShaderSource = (char *) sources.requests[1].data;
+    }
 
     if (!vertexShaderSource) {
+        LC_Scratch_End(localArena);
         snprintf(errorLog, 1024, "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: vertex-shader");
         return false;
     }
     if (!fragmentShaderSource) {
-        free(vertexShaderSource);
+        LC_Scratch_End(localArena);
         snprintf(errorLog, 1024, "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: fragment-shader");
         return false;
     }
@@ -131,13 +155,21 @@ bool LC_GL_InitializeShader(LC_Arena *arena, LC_GL_Shader *shader, char *errorLo
     const uint32 vertexShader = glCreateShader(GL_VERTEX_SHADER);
     GLCall(glShaderSource(vertexShader, 1, (char const* const *)&vertexShaderSource, nullptr));
     GLCall(glCompileShader(vertexShader));
-    if (!CheckCompileErrors(vertexShader, "VERTEX", errorLog)) return false;
+    if (!CheckCompileErrors(vertexShader, "VERTEX", errorLog)) {
+        LC_Scratch_End(localArena);
+        return false;
+    }
 
     // Fragment Shader
     const uint32 fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
     GLCall(glShaderSource(fragmentShader, 1, (char const* const *)&fragmentShaderSource, nullptr));
     GLCall(glCompileShader(fragmentShader));
-    if (!CheckCompileErrors(fragmentShader, "FRAGMENT", errorLog)) return false;
+    if (!CheckCompileErrors(fragmentShader, "FRAGMENT", errorLog)) {
+        LC_Scratch_End(localArena);
+        return false;
+    }
+    // the sources have been copied into the shader objects, the scratch memory can go back
+    LC_Scratch_End(localArena);
 
     // Shader Program
     shader->programId = glCreateProgram();
@@ -146,11 +178,14 @@ bool LC_GL_InitializeShader(LC_Arena *arena, LC_GL_Shader *shader, char *errorLo
     GLCall(glLinkProgram(shader->programId));
     if (!CheckCompileErrors(shader->programId, "PROGRAM", errorLog)) return false;
 
+    // Locations belong to the linked program, anything cached for a previous one is stale
+    for (uint32 i = 0; i < LC_GL_CACHED_UNIFORM_COUNT; i++) {
+        shader->uniformLocations[i] = LC_GL_UNIFORM_NOT_CACHED;
+    }
+
     GLCall(glDeleteShader(vertexShader));
     GLCall(glDeleteShader(fragmentShader));
 
-    LC_Arena_EndTemporary(localArena);
-
     return true;
 }
 
@@ -182,34 +217,39 @@ bool CheckCompileErrors(const GLuint programId, char *type, char *buffer) {
 
 bool LC_GL_InitializeTextRenderer(LC_Arena *arena, const LC_GL_Renderer *renderer, const char *fontName, const float fontSize,
                                   char *errorLog) {
-    constexpr size_t STARTING_ARENA_SIZE = 300 * 1024;
-    void *localArenaBuffer = malloc(STARTING_ARENA_SIZE);
-    LC_Arena localArena;
-    LC_Arena_Initialize(&localArena, localArenaBuffer, STARTING_ARENA_SIZE);
+    // The font file and the atlas bitmap are only needed until the texture is uploaded
+    const TemporaryArenaMemory scratch = LC_Scratch_Begin(&arena, 1);
+    LC_Arena *localArena = scratch.arena;
 
-    if (!LC_GL_InitializeShader(&localArena, renderer->gameText->fontShader, errorLog)) {
+    if (!LC_GL_InitializeShader(localArena, renderer->gameText->fontShader, errorLog)) {
         SDL_Log("%s", errorLog);
+        LC_Scratch_End(scratch);
         return false;
     }
     LC_GL_TextSettings *gameText = renderer->gameText;
 
-    size_t fontFileSize;
-    uchar *fontBuffer;
-    if (!LC_GetFileContentBinary(&localArena, fontName, &fontBuffer, &fontFileSize, errorLog)) {
+    // stb_truetype jumps around the font tables while packing, the mapped file is read in place without a copy
+    LC_FileView fontFile;
+    if (!LC_File_Map(&fontFile, fontName, LC_FILE_HINT_RANDOM | LC_FILE_HINT_WILL_NEED, errorLog)) {
         SDL_Log("%s", errorLog);
+        LC_Scratch_End(scratch);
         return false;
     }
+    const uchar *fontBuffer = fontFile.data;
 
-    const int32 fontCount = stbtt_GetNumberOfFonts(fontBuffer);
+    const int32 fontCount = fontFile.length > 0 ? stbtt_GetNumberOfFonts(fontBuffer) : -1;
     if (fontCount == -1) {
         snprintf(errorLog, 1024, "The font file doesn't correspond to valid font data");
+        LC_File_Unmap(&fontFile);
+        LC_Scratch_End(scratch);
         return false;
     }
 
     constexpr uint32 fontAtlasWidth = 512;
     constexpr uint32 fontAtlasHeight = 512;
 
-    uchar *fontAtlasBitmap = LC_Arena_Allocate(&localArena, fontAtlasWidth * fontAtlasHeight * sizeof(uchar));
+    // stbtt_PackBegin clears the bitmap itself
+    uchar *fontAtlasBitmap = LC_Arena_AllocateNoZero(localArena, fontAtlasWidth * fontAtlasHeight * sizeof(uchar));
     constexpr uint32 codePointOfFirstCharacter = 32;
     constexpr uint32 charsToIncludeInFontAtlas = 95;
 
@@ -233,11 +273,13 @@ bool LC_GL_InitializeTextRenderer(LC_Arena *arena, const LC_GL_Renderer *rendere
                             &gameText->alignedQuads[i], 0);
     }
 
+    stbtt_PackEnd(&context);
+    LC_File_Unmap(&fontFile);
+
     LC_GL_IsDSAAvailable(renderer) ? LC_GL_CreateTextureTextDSA(gameText, fontAtlasWidth, fontAtlasHeight, fontAtlasBitmap) :
         LC_GL_CreateTextureTextNonDSA(gameText, fontAtlasWidth, fontAtlasHeight, fontAtlasBitmap);
 
-    LC_Arena_FreeAll(&localArena);
-    free(localArenaBuffer);
+    LC_Scratch_End(scratch);
     return true;
 }
 
@@ -277,12 +319,10 @@ void LC_GL_CreateTextureTextNonDSA(LC_GL_TextSettings *gameText, const int32 fon
 }
 
 void LC_GL_SetupVaoAndVboTextDSA(LC_GL_TextSettings *gameText) {
-    GLCall(glCreateBuffers(1, &gameText->vbo));
-    GLCall(glNamedBufferStorage(gameText->vbo, TEXT_STARTING_BUFFER_SIZE, nullptr, GL_DYNAMIC_STORAGE_BIT));
-
     GLCall(glCreateVertexArrays(1, &gameText->vao));
     constexpr GLuint vaoBindingPoint = 0;
-    GLCall(glVertexArrayVertexBuffer(gameText->vao, vaoBindingPoint, gameText->vbo, 0, 9 * sizeof(float)));
+    GLCall(glVertexArrayVertexBuffer(gameText->vao, vaoBindingPoint, gameText->vertexStream.buffer, 0,
+                                     9 * sizeof(float)));
 
     constexpr uint8 positionIndex = 0;
     constexpr uint8 colorIndex = 1;
@@ -302,10 +342,8 @@ void LC_GL_SetupVaoAndVboTextDSA(LC_GL_TextSettings *gameText) {
 }
 
 void LC_GL_SetupVaoAndVboTextNonDSA(LC_GL_TextSettings *gameText) {
-    // Setting up the VAO and VBO
-    GLCall(glGenBuffers(1, &gameText->vbo));
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, gameText->vbo));
-    GLCall(glBufferData(GL_ARRAY_BUFFER, TEXT_STARTING_BUFFER_SIZE, nullptr, GL_DYNAMIC_DRAW));
+    // Setting up the VAO, the vertices come from the text vertex stream
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, gameText->vertexStream.buffer));
 
     GLCall(glGenVertexArrays(1, &gameText->vao));
     GLCall(glBindVertexArray(gameText->vao));
@@ -332,21 +370,30 @@ void LC_GL_SetupVaoAndVboTextNonDSA(LC_GL_TextSettings *gameText) {
 }
 
 void LC_GL_RenderText(const LC_GL_Renderer *renderer, LC_GL_Text *text) {
-    const uint64 totalCharacters = LC_GetStringLengthSkipSpaces((const char*)text->string, strlen(text->string));
+    const uint64 totalCharacters = LC_GetStringLengthSkipSpaces((const char*)text->string,
+                                                                  LC_CString_GetLength(text->string));
+    // Empty texts and texts of only spaces have no vertices, and an empty range can't be mapped
+    if (totalCharacters == 0) return;
     const GLuint fontShaderProgramId = renderer->gameText->fontShader->programId;
 
     // Each quad has 4 vertices
     const uint32 MAX_QUADS = totalCharacters;
     const GLint totalVertices = (int32)MAX_QUADS * 4;
     constexpr uint32 NUMBER_OF_FLOATS_PER_VERTEX = 9; // 3 for position, 4 for color, 2 for texture coordinates
-    const GLuint sizeOfBuffer = (int64)sizeof(float) * totalVertices * NUMBER_OF_FLOATS_PER_VERTEX;
-
-    ASSERT(sizeOfBuffer < TEXT_STARTING_BUFFER_SIZE,
-           "Current text buffer size is smaller than initial buffer allocated on the GPU!");
-
-    float buffer[sizeOfBuffer];
-
+    const GLsizeiptr sizeOfBuffer = (int64)sizeof(float) * totalVertices * NUMBER_OF_FLOATS_PER_VERTEX;
+
+    // The glyph vertices are written straight into the vertex stream
+    constexpr GLsizeiptr vertexStride = NUMBER_OF_FLOATS_PER_VERTEX * sizeof(float);
+    ASSERT(sizeOfBuffer + vertexStride - 1 <= TEXT_STREAM_SEGMENT_SIZE,
+           "The text doesn't fit into one segment of the text vertex stream!");
+    LC_GL_StreamBuffer *vertexStream = &renderer->gameText->vertexStream;
+    GLintptr offset;
+    GLsizeiptr mappedSize;
+    float *buffer = LC_GL_StreamBuffer_Map(vertexStream, sizeOfBuffer, sizeOfBuffer, vertexStride, &offset, &mappedSize);
+    if (buffer == nullptr) return;
     LC_GL_InsertTextBytesIntoBuffer(buffer, renderer->gameText, text);
+    LC_GL_StreamBuffer_Unmap(vertexStream, sizeOfBuffer);
+    const GLint firstVertex = (GLint)(offset / vertexStride);
     
     GLCall(glEnable(GL_CULL_FACE));
     GLCall(glEnable(GL_BLEND));
@@ -354,8 +401,8 @@ void LC_GL_RenderText(const LC_GL_Renderer *renderer, LC_GL_Text *text) {
 
     GLCall(glUseProgram(fontShaderProgramId));
 
-    LC_GL_IsDSAAvailable(renderer) ? LC_GL_RenderTextDSA(renderer, totalVertices, sizeOfBuffer, buffer) :
-        LC_GL_RenderTextNonDSA(renderer, totalVertices, sizeOfBuffer, buffer);
+    LC_GL_IsDSAAvailable(renderer) ? LC_GL_RenderTextDSA(renderer, firstVertex, totalVertices) :
+        LC_GL_RenderTextNonDSA(renderer, firstVertex, totalVertices);
 
     GLCall(glDisable(GL_CULL_FACE));
     GLCall(glDisable(GL_BLEND));
@@ -363,20 +410,19 @@ void LC_GL_RenderText(const LC_GL_Renderer *renderer, LC_GL_Text *text) {
     GLCall(glUseProgram(0));
 }
 
-void LC_GL_RenderTextDSA(const LC_GL_Renderer *renderer, const GLint totalVertices, const GLuint sizeOfBuffer, const float *buffer) {
-    const GLuint fontShaderProgramId = renderer->gameText->fontShader->programId;
+void LC_GL_RenderTextDSA(const LC_GL_Renderer *renderer, const GLint firstVertex, const GLint totalVertices) {
+    LC_GL_Shader *fontShader = renderer->gameText->fontShader;
 
-    LC_GL_SetUniformInt(fontShaderProgramId, "fontAtlasTexture", 0);
-    LC_GL_SetUniformMat4(fontShaderProgramId, "viewProjectionMatrix",
-                         &renderer->viewProjectionMatrix);
+    GLCall(glUniform1i(LC_GL_GetUniformLocation(renderer, fontShader, renderer->uniformIds.fontAtlasTexture), 0));
+    GLCall(glUniformMatrix4fv(LC_GL_GetUniformLocation(renderer, fontShader, renderer->uniformIds.viewProjectionMatrix),
+                              1, GL_FALSE, renderer->viewProjectionMatrix[0]));
 
     // Bind the Texture Unit
     GLCall(glBindTextureUnit(0, renderer->gameText->fontAtlasTextureId));
 
     // Render here
     GLCall(glBindVertexArray(renderer->gameText->vao));
-    GLCall(glNamedBufferSubData(renderer->gameText->vbo, 0, sizeOfBuffer, buffer));
-    GLCall(glDrawArrays(GL_TRIANGLE_STRIP, 0, totalVertices));
+    GLCall(glDrawArrays(GL_TRIANGLE_STRIP, firstVertex, totalVertices));
 
     // Unbind the Texture Unit
     GLCall(glBindTextureUnit(0, 0));
@@ -385,24 +431,21 @@ void LC_GL_RenderTextDSA(const LC_GL_Renderer *renderer, const GLint totalVertic
     GLCall(glBindVertexArray(0));
 }
 
-void LC_GL_RenderTextNonDSA(const LC_GL_Renderer *renderer, const GLint totalVertices, const GLuint sizeOfBuffer, const float *buffer) {
-    const GLuint fontShaderProgramId = renderer->gameText->fontShader->programId;
+void LC_GL_RenderTextNonDSA(const LC_GL_Renderer *renderer, const GLint firstVertex, const GLint totalVertices) {
+    LC_GL_Shader *fontShader = renderer->gameText->fontShader;
 
     // Bind the Texture
     GLCall(glBindTexture(GL_TEXTURE_2D, renderer->gameText->fontAtlasTextureId));
     GLCall(glActiveTexture(GL_TEXTURE0));
 
-    LC_GL_SetUniformInt(fontShaderProgramId, "fontAtlasTexture", 0);
-    LC_GL_SetUniformMat4(fontShaderProgramId, "viewProjectionMatrix",
-                         &renderer->viewProjectionMatrix);
+    GLCall(glUniform1i(LC_GL_GetUniformLocation(renderer, fontShader, renderer->uniformIds.fontAtlasTexture), 0));
+    GLCall(glUniformMatrix4fv(LC_GL_GetUniformLocation(renderer, fontShader, renderer->uniformIds.viewProjectionMatrix),
+                              1, GL_FALSE, renderer->viewProjectionMatrix[0]));
     // Render here
     GLCall(glBindVertexArray(renderer->gameText->vao));
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, renderer->gameText->vbo));
-    GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, sizeOfBuffer, buffer));
-    GLCall(glDrawArrays(GL_TRIANGLE_STRIP, 0, totalVertices));
+    GLCall(glDrawArrays(GL_TRIANGLE_STRIP, firstVertex, totalVertices));
 
-    // Unbind VAO and VBO
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    // Unbind VAO
     GLCall(glBindVertexArray(0));
 }
 
@@ -503,13 +546,627 @@ void LC_GL_InsertTextBytesIntoBuffer(float *buffer, const LC_GL_TextSettings *ga
     text->height = textHeight;
 }
 
-void LC_GL_DeleteTextRenderer(const LC_GL_TextSettings *gameText) {
+void LC_GL_DeleteTextRenderer(LC_GL_TextSettings *gameText) {
     GLCall(glDeleteVertexArrays(1, &gameText->vao));
-    GLCall(glDeleteBuffers(1, &gameText->vbo));
+    LC_GL_StreamBuffer_Destroy(&gameText->vertexStream);
     GLCall(glDeleteTextures(1, &gameText->fontAtlasTextureId));
     GLCall(glDeleteProgram(gameText->fontShader->programId));
 }
 
+// ==================================================================================================================
+// Streaming Buffers
+// ==================================================================================================================
+
+bool LC_GL_IsBufferStorageAvailable(const LC_GL_Renderer *renderer) {
+    if (renderer->glMajorVersion < 4) return false;
+    if (renderer->glMajorVersion == 4 && renderer->glMinorVersion < 4) return false;
+
+    return true;
+}
+
+void LC_GL_StreamBuffer_Initialize(LC_GL_StreamBuffer *stream, const GLsizeiptr segmentSize,
+                                   const bool usePersistentMapping) {
+    stream->segmentSize = segmentSize;
+    stream->size = segmentSize * LC_GL_STREAM_BUFFER_SEGMENTS;
+    stream->isPersistent = usePersistentMapping;
+    stream->mapped = nullptr;
+    stream->segment = 0;
+    stream->offset = 0;
+    stream->mappedOffset = 0;
+    for (uint32 i = 0; i < LC_GL_STREAM_BUFFER_SEGMENTS; i++) stream->fences[i] = nullptr;
+
+    GLCall(glGenBuffers(1, &stream->buffer));
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, stream->buffer));
+    if (stream->isPersistent) {
+        // Mapped once for the lifetime of the buffer, coherent so the writes need no flush before drawing
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLCall(glBufferStorage(GL_ARRAY_BUFFER, stream->size, nullptr, flags));
+        GLCall(stream->mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, stream->size, flags));
+        if (stream->mapped == nullptr) {
+            SDL_Log("Persistent mapping of a stream buffer failed, falling back to orphaning");
+            // The storage of the buffer is immutable now, so it is replaced by a new one
+            GLCall(glDeleteBuffers(1, &stream->buffer));
+            GLCall(glGenBuffers(1, &stream->buffer));
+            GLCall(glBindBuffer(GL_ARRAY_BUFFER, stream->buffer));
+            stream->isPersistent = false;
+        }
+    }
+    if (!stream->isPersistent) {
+        GLCall(glBufferData(GL_ARRAY_BUFFER, stream->size, nullptr, GL_STREAM_DRAW));
+    }
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
+
+// Offsets are aligned from the start of the buffer, the draw calls turn them into vertex indices by dividing them
+static inline GLintptr LC_GL_StreamBuffer_AlignOffset(const GLintptr offset, const GLsizeiptr alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// Waits until the GPU is done with the commands that read the segment the last time around
+static void LC_GL_StreamBuffer_WaitForSegment(LC_GL_StreamBuffer *stream, const uint32 segment) {
+    GLsync fence = stream->fences[segment];
+    if (fence == nullptr) return;
+
+    constexpr GLuint64 oneMillisecond = 1000000;
+    GLenum result;
+    GLCall(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+    while (result == GL_TIMEOUT_EXPIRED) {
+        GLCall(result = glClientWaitSync(fence, 0, oneMillisecond));
+    }
+    GLCall(glDeleteSync(fence));
+    stream->fences[segment] = nullptr;
+}
+
+void* LC_GL_StreamBuffer_Map(LC_GL_StreamBuffer *stream, const GLsizeiptr minimumSize, const GLsizeiptr maximumSize,
+                             const GLsizeiptr alignment, GLintptr *offset, GLsizeiptr *size) {
+    ASSERT(minimumSize > 0 && minimumSize <= maximumSize, "A mapped range of a stream buffer can't be empty!");
+    // Aligning the start of a segment may skip up to 'alignment' - 1 of its bytes
+    ASSERT(minimumSize + alignment - 1 <= stream->segmentSize,
+           "The mapped range is bigger than a segment of the stream buffer!");
+
+    if (stream->isPersistent) {
+        // A range never crosses into the next segment, that one may still be in use by the GPU
+        const GLintptr segmentStart = (GLintptr)stream->segment * stream->segmentSize;
+        const GLintptr segmentEnd = segmentStart + stream->segmentSize;
+        GLintptr start = LC_GL_StreamBuffer_AlignOffset(stream->offset, alignment);
+        if (segmentEnd - start < minimumSize) {
+            // Everything drawn from this segment is behind the fence, the next one is reused once its fence signals
+            GLCall(stream->fences[stream->segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+            stream->segment = (stream->segment + 1) % LC_GL_STREAM_BUFFER_SEGMENTS;
+            LC_GL_StreamBuffer_WaitForSegment(stream, stream->segment);
+            start = LC_GL_StreamBuffer_AlignOffset((GLintptr)stream->segment * stream->segmentSize, alignment);
+        }
+
+        const GLsizeiptr available = (GLintptr)(stream->segment + 1) * stream->segmentSize - start;
+        stream->mappedOffset = start;
+        *offset = start;
+        *size = available < maximumSize ? available : maximumSize;
+        return stream->mapped + start;
+    }
+
+    GLintptr start = LC_GL_StreamBuffer_AlignOffset(stream->offset, alignment);
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, stream->buffer));
+    if (stream->size <= start || stream->size - start < minimumSize) {
+        // Orphaning: the driver hands out new storage while the GPU keeps reading the old one
+        GLCall(glBufferData(GL_ARRAY_BUFFER, stream->size, nullptr, GL_STREAM_DRAW));
+        start = 0;
+    }
+
+    const GLsizeiptr available = stream->size - start;
+    stream->mappedOffset = start;
+    *offset = start;
+    *size = available < maximumSize ? available : maximumSize;
+    // Nothing drawn so far reads the range behind the offset, so the map doesn't wait for the GPU
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+        GL_MAP_FLUSH_EXPLICIT_BIT;
+    void *memory;
+    GLCall(memory = glMapBufferRange(GL_ARRAY_BUFFER, start, *size, flags));
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    return memory;
+}
+
+void LC_GL_StreamBuffer_Unmap(LC_GL_StreamBuffer *stream, const GLsizeiptr usedSize) {
+    if (!stream->isPersistent) {
+        GLCall(glBindBuffer(GL_ARRAY_BUFFER, stream->buffer));
+        if (usedSize > 0) GLCall(glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, usedSize));
+        GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+        GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    }
+    stream->offset = stream->mappedOffset + usedSize;
+}
+
+void LC_GL_StreamBuffer_Destroy(LC_GL_StreamBuffer *stream) {
+    if (stream->isPersistent && stream->mapped != nullptr) {
+        GLCall(glBindBuffer(GL_ARRAY_BUFFER, stream->buffer));
+        GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+        GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        stream->mapped = nullptr;
+    }
+    for (uint32 i = 0; i < LC_GL_STREAM_BUFFER_SEGMENTS; i++) {
+        if (stream->fences[i] != nullptr) GLCall(glDeleteSync(stream->fences[i]));
+        stream->fences[i] = nullptr;
+    }
+    GLCall(glDeleteBuffers(1, &stream->buffer));
+}
+
+// ==================================================================================================================
+// Batched 2D Rendering
+// ==================================================================================================================
+
+bool LC_GL_SetupQuadBatch(LC_Arena *arena, LC_GL_Renderer *renderer, char *errorLog) {
+    LC_GL_QuadBatch *batch = renderer->quadBatch;
+    if (!LC_GL_InitializeShader(arena, batch->shader, errorLog)) return false;
+
+    batch->vertexCapacity = LC_GL_BATCH_MAX_QUADS * 4;
+    batch->vertexCount = 0;
+    batch->vertices = nullptr;
+    batch->verticesOffset = 0;
+    batch->mappedVertexCapacity = 0;
+    batch->currentShader = batch->shader;
+    batch->currentPrimitive = GL_TRIANGLES;
+    batch->isInFrame = false;
+
+    // Every quad uses the same two triangles as the default rectangle, only offset to its own 4 vertices
+    const TemporaryArenaMemory scratch = LC_Scratch_Begin(&arena, 1);
+    const GLsizeiptr sizeOfIndices = LC_GL_BATCH_MAX_QUADS * 6 * sizeof(uint32);
+    uint32 *indices = LC_Arena_AllocateNoZero(scratch.arena, sizeOfIndices);
+    for (uint32 quad = 0; quad < LC_GL_BATCH_MAX_QUADS; quad++) {
+        const uint32 firstVertex = quad * 4;
+        indices[quad * 6 + 0] = firstVertex + 0;
+        indices[quad * 6 + 1] = firstVertex + 1;
+        indices[quad * 6 + 2] = firstVertex + 3;
+        indices[quad * 6 + 3] = firstVertex + 1;
+        indices[quad * 6 + 4] = firstVertex + 2;
+        indices[quad * 6 + 5] = firstVertex + 3;
+    }
+
+    // The vertices are written straight into the stream, so the batch itself has no vertex array on the CPU
+    LC_GL_StreamBuffer_Initialize(&batch->vertexStream, batch->vertexCapacity * sizeof(LC_GL_BatchVertex),
+                                  LC_GL_IsBufferStorageAvailable(renderer));
+    LC_GL_IsDSAAvailable(renderer) ? LC_GL_SetupQuadBatchDSA(batch, indices, sizeOfIndices) :
+        LC_GL_SetupQuadBatchNonDSA(batch, indices, sizeOfIndices);
+    batch->currentTextureId = batch->whiteTextureId;
+    LC_Scratch_End(scratch);
+    return true;
+}
+
+void LC_GL_SetupQuadBatchDSA(LC_GL_QuadBatch *batch, const uint32 *indices, const GLsizeiptr sizeOfIndices) {
+    GLCall(glCreateBuffers(1, &batch->ebo));
+    GLCall(glNamedBufferStorage(batch->ebo, sizeOfIndices, indices, 0));
+
+    GLCall(glCreateVertexArrays(1, &batch->vao));
+    constexpr GLuint vaoBindingPoint = 0;
+    GLCall(glVertexArrayVertexBuffer(batch->vao, vaoBindingPoint, batch->vertexStream.buffer, 0,
+                                     sizeof(LC_GL_BatchVertex)));
+    GLCall(glVertexArrayElementBuffer(batch->vao, batch->ebo));
+
+    constexpr uint8 positionIndex = 0;
+    constexpr uint8 colorIndex = 1;
+    constexpr uint8 texCoordIndex = 2;
+
+    GLCall(glEnableVertexArrayAttrib(batch->vao, positionIndex));
+    GLCall(glEnableVertexArrayAttrib(batch->vao, colorIndex));
+    GLCall(glEnableVertexArrayAttrib(batch->vao, texCoordIndex));
+
+    GLCall(glVertexArrayAttribFormat(batch->vao, positionIndex, 2, GL_FLOAT, GL_FALSE, offsetof(LC_GL_BatchVertex, x)));
+    GLCall(glVertexArrayAttribFormat(batch->vao, colorIndex, 4, GL_FLOAT, GL_FALSE, offsetof(LC_GL_BatchVertex, r)));
+    GLCall(glVertexArrayAttribFormat(batch->vao, texCoordIndex, 2, GL_FLOAT, GL_FALSE, offsetof(LC_GL_BatchVertex, u)));
+
+    GLCall(glVertexArrayAttribBinding(batch->vao, positionIndex, vaoBindingPoint));
+    GLCall(glVertexArrayAttribBinding(batch->vao, colorIndex, vaoBindingPoint));
+    GLCall(glVertexArrayAttribBinding(batch->vao, texCoordIndex, vaoBindingPoint));
+
+    constexpr uint32 whitePixel = 0xFFFFFFFF;
+    GLCall(glCreateTextures(GL_TEXTURE_2D, 1, &batch->whiteTextureId));
+    GLCall(glTextureStorage2D(batch->whiteTextureId, 1, GL_RGBA8, 1, 1));
+    GLCall(glTextureSubImage2D(batch->whiteTextureId, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, &whitePixel));
+}
+
+void LC_GL_SetupQuadBatchNonDSA(LC_GL_QuadBatch *batch, const uint32 *indices, const GLsizeiptr sizeOfIndices) {
+    GLCall(glGenVertexArrays(1, &batch->vao));
+    GLCall(glGenBuffers(1, &batch->ebo));
+    GLCall(glBindVertexArray(batch->vao));
+
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, batch->vertexStream.buffer));
+
+    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->ebo));
+    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeOfIndices, indices, GL_STATIC_DRAW));
+
+    constexpr uint8 positionIndex = 0;
+    constexpr uint8 colorIndex = 1;
+    constexpr uint8 texCoordIndex = 2;
+
+    GLCall(glVertexAttribPointer(positionIndex, 2, GL_FLOAT, GL_FALSE, sizeof(LC_GL_BatchVertex),
+                                 (void *)offsetof(LC_GL_BatchVertex, x)));
+    GLCall(glEnableVertexAttribArray(positionIndex));
+    GLCall(glVertexAttribPointer(colorIndex, 4, GL_FLOAT, GL_FALSE, sizeof(LC_GL_BatchVertex),
+                                 (void *)offsetof(LC_GL_BatchVertex, r)));
+    GLCall(glEnableVertexAttribArray(colorIndex));
+    GLCall(glVertexAttribPointer(texCoordIndex, 2, GL_FLOAT, GL_FALSE, sizeof(LC_GL_BatchVertex),
+                                 (void *)offsetof(LC_GL_BatchVertex, u)));
+    GLCall(glEnableVertexAttribArray(texCoordIndex));
+
+    // The element buffer binding is part of the VAO, so the VAO is unbound first
+    GLCall(glBindVertexArray(0));
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+
+    constexpr uint32 whitePixel = 0xFFFFFFFF;
+    GLCall(glGenTextures(1, &batch->whiteTextureId));
+    GLCall(glBindTexture(GL_TEXTURE_2D, batch->whiteTextureId));
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &whitePixel));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
+static void LC_GL_Batch_UseShader(const LC_GL_Renderer *renderer, LC_GL_Shader *shader) {
+    GLCall(glUseProgram(shader->programId));
+    GLCall(glUniform1i(LC_GL_GetUniformLocation(renderer, shader, renderer->uniformIds.spriteTexture), 0));
+    GLCall(glUniformMatrix4fv(LC_GL_GetUniformLocation(renderer, shader, renderer->uniformIds.viewProjectionMatrix),
+                              1, GL_FALSE, renderer->viewProjectionMatrix[0]));
+}
+
+void LC_GL_BeginFrame(const LC_GL_Renderer *renderer) {
+    LC_GL_QuadBatch *batch = renderer->quadBatch;
+    batch->isInFrame = true;
+    batch->drawCallCount = 0;
+    batch->quadCount = 0;
+    batch->currentShader = batch->shader;
+    batch->currentTextureId = batch->whiteTextureId;
+    batch->currentPrimitive = GL_TRIANGLES;
+    renderer->rectInstances->currentTextureId = batch->whiteTextureId;
+
+    // The state is set once for the whole frame instead of once per rectangle
+    GLCall(glEnable(GL_BLEND));
+    GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+    LC_GL_Batch_UseShader(renderer, renderer->rectInstances->shader);
+    LC_GL_Batch_UseShader(renderer, batch->shader);
+    GLCall(glBindVertexArray(batch->vao));
+}
+
+void LC_GL_EndFrame(const LC_GL_Renderer *renderer) {
+    LC_GL_Batch_Flush(renderer);
+    LC_GL_Instanced_Flush(renderer);
+    renderer->quadBatch->isInFrame = false;
+
+    GLCall(glBindVertexArray(0));
+    GLCall(glUseProgram(0));
+    GLCall(glDisable(GL_BLEND));
+}
+
+void LC_GL_Batch_Flush(const LC_GL_Renderer *renderer) {
+    LC_GL_QuadBatch *batch = renderer->quadBatch;
+    if (batch->vertices == nullptr) return;
+
+    LC_GL_StreamBuffer_Unmap(&batch->vertexStream, batch->vertexCount * sizeof(LC_GL_BatchVertex));
+    batch->vertices = nullptr;
+    if (batch->vertexCount == 0) return;
+
+    // Instanced rectangles may have been drawn since the last flush, which binds their program and VAO
+    GLCall(glUseProgram(batch->currentShader->programId));
+    GLCall(glBindVertexArray(batch->vao));
+    if (LC_GL_IsDSAAvailable(renderer)) {
+        GLCall(glBindTextureUnit(0, batch->currentTextureId));
+    } else {
+        GLCall(glActiveTexture(GL_TEXTURE0));
+        GLCall(glBindTexture(GL_TEXTURE_2D, batch->currentTextureId));
+    }
+
+    // The indices of every batch start at 0, the base vertex moves them to where the vertices were written
+    const GLint baseVertex = (GLint)(batch->verticesOffset / (GLintptr)sizeof(LC_GL_BatchVertex));
+    if (batch->currentPrimitive == GL_TRIANGLES) {
+        GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)(batch->vertexCount / 4 * 6), GL_UNSIGNED_INT, nullptr,
+                                        baseVertex));
+    } else {
+        GLCall(glDrawArrays(GL_LINES, baseVertex, (GLsizei)batch->vertexCount));
+    }
+    batch->drawCallCount++;
+    batch->vertexCount = 0;
+}
+
+void LC_GL_Batch_SetShader(const LC_GL_Renderer *renderer, LC_GL_Shader *shader) {
+    LC_GL_QuadBatch *batch = renderer->quadBatch;
+    if (shader == nullptr) shader = batch->shader;
+    if (shader == batch->currentShader) return;
+
+    LC_GL_Batch_Flush(renderer);
+    batch->currentShader = shader;
+    LC_GL_Batch_UseShader(renderer, shader);
+}
+
+// Room for 'vertexCount' more vertices drawn as 'primitive' with 'textureId', flushing what doesn't fit in with them
+static LC_GL_BatchVertex* LC_GL_Batch_Reserve(const LC_GL_Renderer *renderer, const GLenum primitive,
+                                              const GLuint textureId, const uint32 vertexCount) {
+    LC_GL_QuadBatch *batch = renderer->quadBatch;
+    // Instanced rectangles drawn before this one have to reach the screen before it
+    if (renderer->rectInstances->instances != nullptr) LC_GL_Instanced_Flush(renderer);
+    if (batch->currentPrimitive != primitive || batch->currentTextureId != textureId ||
+        (batch->vertices != nullptr && batch->vertexCount + vertexCount > batch->mappedVertexCapacity)) {
+        LC_GL_Batch_Flush(renderer);
+        batch->currentPrimitive = primitive;
+        batch->currentTextureId = textureId;
+    }
+    if (batch->vertices == nullptr) {
+        // Maps as much of the stream as is left, at least room for a wireframe rectangle
+        constexpr GLsizeiptr vertexSize = sizeof(LC_GL_BatchVertex);
+        GLsizeiptr mappedSize;
+        batch->vertices = LC_GL_StreamBuffer_Map(&batch->vertexStream, 8 * vertexSize,
+                                                 batch->vertexCapacity * vertexSize, vertexSize,
+                                                 &batch->verticesOffset, &mappedSize);
+        batch->mappedVertexCapacity = (uint32)(mappedSize / vertexSize);
+        batch->vertexCount = 0;
+    }
+
+    LC_GL_BatchVertex *vertices = &batch->vertices[batch->vertexCount];
+    batch->vertexCount += vertexCount;
+    batch->quadCount++;
+    return vertices;
+}
+
+static inline void LC_GL_Batch_SetVertex(LC_GL_BatchVertex *vertex, const float x, const float y, const LC_Color *color,
+                                         const float u, const float v) {
+    vertex->x = x;
+    vertex->y = y;
+    vertex->r = color->r;
+    vertex->g = color->g;
+    vertex->b = color->b;
+    vertex->a = color->a;
+    vertex->u = u;
+    vertex->v = v;
+}
+
+void LC_GL_Batch_DrawRect(const LC_GL_Renderer *renderer, const LC_FRect *rect, const LC_Color *color,
+                          const bool isWireframe) {
+    const GLuint whiteTextureId = renderer->quadBatch->whiteTextureId;
+    const float left = rect->x;
+    const float top = rect->y;
+    const float right = rect->x + rect->w;
+    const float bottom = rect->y + rect->h;
+
+    if (isWireframe) {
+        // Four separate lines, a line loop would connect to the next rectangle in the batch
+        LC_GL_BatchVertex *vertices = LC_GL_Batch_Reserve(renderer, GL_LINES, whiteTextureId, 8);
+        LC_GL_Batch_SetVertex(&vertices[0], left, top, color, 0.0f, 0.0f);
+        LC_GL_Batch_SetVertex(&vertices[1], right, top, color, 0.0f, 0.0f);
+        LC_GL_Batch_SetVertex(&vertices[2], right, top, color, 0.0f, 0.0f);
+        LC_GL_Batch_SetVertex(&vertices[3], right, bottom, color, 0.0f, 0.0f);
+        LC_GL_Batch_SetVertex(&vertices[4], right, bottom, color, 0.0f, 0.0f);
+        LC_GL_Batch_SetVertex(&vertices[5], left, bottom, color, 0.0f, 0.0f);
+        LC_GL_Batch_SetVertex(&vertices[6], left, bottom, color, 0.0f, 0.0f);
+        LC_GL_Batch_SetVertex(&vertices[7], left, top, color, 0.0f, 0.0f);
+        return;
+    }
+
+    // Same vertex order as the default rectangle: top right, bottom right, bottom left, top left
+    LC_GL_BatchVertex *vertices = LC_GL_Batch_Reserve(renderer, GL_TRIANGLES, whiteTextureId, 4);
+    LC_GL_Batch_SetVertex(&vertices[0], right, top, color, 0.0f, 0.0f);
+    LC_GL_Batch_SetVertex(&vertices[1], right, bottom, color, 0.0f, 0.0f);
+    LC_GL_Batch_SetVertex(&vertices[2], left, bottom, color, 0.0f, 0.0f);
+    LC_GL_Batch_SetVertex(&vertices[3], left, top, color, 0.0f, 0.0f);
+}
+
+void LC_GL_Batch_DrawTexturedRect(const LC_GL_Renderer *renderer, const LC_FRect *rect, const GLuint textureId,
+                                  const LC_FRect *textureRect, const LC_Color *tint) {
+    static const LC_FRect wholeTexture = {0.0f, 0.0f, 1.0f, 1.0f};
+    static const LC_Color white = {255.0f, 255.0f, 255.0f, 1.0f};
+    if (textureRect == nullptr) textureRect = &wholeTexture;
+    if (tint == nullptr) tint = &white;
+
+    const float left = rect->x;
+    const float top = rect->y;
+    const float right = rect->x + rect->w;
+    const float bottom = rect->y + rect->h;
+    const float u0 = textureRect->x;
+    const float v0 = textureRect->y;
+    const float u1 = textureRect->x + textureRect->w;
+    const float v1 = textureRect->y + textureRect->h;
+
+    LC_GL_BatchVertex *vertices = LC_GL_Batch_Reserve(renderer, GL_TRIANGLES, textureId, 4);
+    LC_GL_Batch_SetVertex(&vertices[0], right, top, tint, u1, v0);
+    LC_GL_Batch_SetVertex(&vertices[1], right, bottom, tint, u1, v1);
+    LC_GL_Batch_SetVertex(&vertices[2], left, bottom, tint, u0, v1);
+    LC_GL_Batch_SetVertex(&vertices[3], left, top, tint, u0, v0);
+}
+
+void LC_GL_DeleteQuadBatch(LC_GL_QuadBatch *batch) {
+    GLCall(glDeleteVertexArrays(1, &batch->vao));
+    LC_GL_StreamBuffer_Destroy(&batch->vertexStream);
+    GLCall(glDeleteBuffers(1, &batch->ebo));
+    GLCall(glDeleteTextures(1, &batch->whiteTextureId));
+    GLCall(glDeleteProgram(batch->shader->programId));
+}
+
+void LC_GL_SetupRectInstancesDSA(LC_GL_Renderer *renderer) {
+    LC_GL_RectInstances *rectInstances = renderer->rectInstances;
+    LC_GL_StreamBuffer_Initialize(&rectInstances->instanceStream, rectInstances->capacity * sizeof(LC_GL_RectInstance),
+                                  LC_GL_IsBufferStorageAvailable(renderer));
+
+    // Binding 0 is the unit quad of the default rectangle, binding 1 advances once per rectangle
+    GLCall(glCreateVertexArrays(1, &rectInstances->vao));
+    constexpr GLuint quadBindingPoint = 0;
+    constexpr GLuint instanceBindingPoint = 1;
+    GLCall(glVertexArrayVertexBuffer(rectInstances->vao, quadBindingPoint, renderer->defaultVertexBufferObject, 0,
+                                     2 * sizeof(float)));
+    GLCall(glVertexArrayVertexBuffer(rectInstances->vao, instanceBindingPoint, rectInstances->instanceStream.buffer, 0,
+                                     sizeof(LC_GL_RectInstance)));
+    GLCall(glVertexArrayBindingDivisor(rectInstances->vao, instanceBindingPoint, 1));
+    GLCall(glVertexArrayElementBuffer(rectInstances->vao, renderer->defaultElementBufferObject));
+
+    constexpr uint8 positionIndex = 0;
+    constexpr uint8 rectIndex = 1;
+    constexpr uint8 rotationIndex = 2;
+    constexpr uint8 colorIndex = 3;
+    constexpr uint8 textureRectIndex = 4;
+
+    GLCall(glEnableVertexArrayAttrib(rectInstances->vao, positionIndex));
+    GLCall(glEnableVertexArrayAttrib(rectInstances->vao, rectIndex));
+    GLCall(glEnableVertexArrayAttrib(rectInstances->vao, rotationIndex));
+    GLCall(glEnableVertexArrayAttrib(rectInstances->vao, colorIndex));
+    GLCall(glEnableVertexArrayAttrib(rectInstances->vao, textureRectIndex));
+
+    GLCall(glVertexArrayAttribFormat(rectInstances->vao, positionIndex, 2, GL_FLOAT, GL_FALSE, 0));
+    GLCall(glVertexArrayAttribFormat(rectInstances->vao, rectIndex, 4, GL_FLOAT, GL_FALSE,
+                                     offsetof(LC_GL_RectInstance, x)));
+    GLCall(glVertexArrayAttribFormat(rectInstances->vao, rotationIndex, 1, GL_FLOAT, GL_FALSE,
+                                     offsetof(LC_GL_RectInstance, rotation)));
+    GLCall(glVertexArrayAttribFormat(rectInstances->vao, colorIndex, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+                                     offsetof(LC_GL_RectInstance, color)));
+    GLCall(glVertexArrayAttribFormat(rectInstances->vao, textureRectIndex, 4, GL_UNSIGNED_SHORT, GL_TRUE,
+                                     offsetof(LC_GL_RectInstance, textureRect)));
+
+    GLCall(glVertexArrayAttribBinding(rectInstances->vao, positionIndex, quadBindingPoint));
+    GLCall(glVertexArrayAttribBinding(rectInstances->vao, rectIndex, instanceBindingPoint));
+    GLCall(glVertexArrayAttribBinding(rectInstances->vao, rotationIndex, instanceBindingPoint));
+    GLCall(glVertexArrayAttribBinding(rectInstances->vao, colorIndex, instanceBindingPoint));
+    GLCall(glVertexArrayAttribBinding(rectInstances->vao, textureRectIndex, instanceBindingPoint));
+}
+
+// Without separate vertex bindings the instance attributes are specified again to draw from another offset
+static void LC_GL_SetInstanceAttributePointers(const LC_GL_RectInstances *rectInstances, const GLintptr offset) {
+    constexpr uint8 rectIndex = 1;
+    constexpr uint8 rotationIndex = 2;
+    constexpr uint8 colorIndex = 3;
+    constexpr uint8 textureRectIndex = 4;
+
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, rectInstances->instanceStream.buffer));
+    GLCall(glVertexAttribPointer(rectIndex, 4, GL_FLOAT, GL_FALSE, sizeof(LC_GL_RectInstance),
+                                 (void *)(offset + offsetof(LC_GL_RectInstance, x))));
+    GLCall(glVertexAttribPointer(rotationIndex, 1, GL_FLOAT, GL_FALSE, sizeof(LC_GL_RectInstance),
+                                 (void *)(offset + offsetof(LC_GL_RectInstance, rotation))));
+    GLCall(glVertexAttribPointer(colorIndex, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(LC_GL_RectInstance),
+                                 (void *)(offset + offsetof(LC_GL_RectInstance, color))));
+    GLCall(glVertexAttribPointer(textureRectIndex, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(LC_GL_RectInstance),
+                                 (void *)(offset + offsetof(LC_GL_RectInstance, textureRect))));
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
+
+void LC_GL_SetupRectInstancesNonDSA(LC_GL_Renderer *renderer) {
+    LC_GL_RectInstances *rectInstances = renderer->rectInstances;
+    LC_GL_StreamBuffer_Initialize(&rectInstances->instanceStream, rectInstances->capacity * sizeof(LC_GL_RectInstance),
+                                  LC_GL_IsBufferStorageAvailable(renderer));
+    GLCall(glGenVertexArrays(1, &rectInstances->vao));
+    GLCall(glBindVertexArray(rectInstances->vao));
+
+    constexpr uint8 positionIndex = 0;
+    constexpr uint8 rectIndex = 1;
+    constexpr uint8 rotationIndex = 2;
+    constexpr uint8 colorIndex = 3;
+    constexpr uint8 textureRectIndex = 4;
+
+    // The unit quad of the default rectangle
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, renderer->defaultVertexBufferObject));
+    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderer->defaultElementBufferObject));
+    GLCall(glVertexAttribPointer(positionIndex, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr));
+    GLCall(glEnableVertexAttribArray(positionIndex));
+
+    // One rectangle per instance
+    LC_GL_SetInstanceAttributePointers(rectInstances, 0);
+    const uint8 instanceAttributes[] = {rectIndex, rotationIndex, colorIndex, textureRectIndex};
+    for (size_t i = 0; i < sizeof(instanceAttributes); i++) {
+        GLCall(glEnableVertexAttribArray(instanceAttributes[i]));
+        GLCall(glVertexAttribDivisor(instanceAttributes[i], 1));
+    }
+
+    GLCall(glBindVertexArray(0));
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+}
+
+void LC_GL_Instanced_Flush(const LC_GL_Renderer *renderer) {
+    LC_GL_RectInstances *rectInstances = renderer->rectInstances;
+    if (rectInstances->instances == nullptr) return;
+
+    LC_GL_StreamBuffer_Unmap(&rectInstances->instanceStream, rectInstances->count * sizeof(LC_GL_RectInstance));
+    rectInstances->instances = nullptr;
+    if (rectInstances->count == 0) return;
+
+    // The instances start where they were written in the stream
+    GLCall(glUseProgram(rectInstances->shader->programId));
+    GLCall(glBindVertexArray(rectInstances->vao));
+    if (LC_GL_IsDSAAvailable(renderer)) {
+        constexpr GLuint instanceBindingPoint = 1;
+        GLCall(glVertexArrayVertexBuffer(rectInstances->vao, instanceBindingPoint, rectInstances->instanceStream.buffer,
+                                         rectInstances->instancesOffset, sizeof(LC_GL_RectInstance)));
+        GLCall(glBindTextureUnit(0, rectInstances->currentTextureId));
+    } else {
+        LC_GL_SetInstanceAttributePointers(rectInstances, rectInstances->instancesOffset);
+        GLCall(glActiveTexture(GL_TEXTURE0));
+        GLCall(glBindTexture(GL_TEXTURE_2D, rectInstances->currentTextureId));
+    }
+    GLCall(glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, (GLsizei)rectInstances->count));
+
+    renderer->quadBatch->drawCallCount++;
+    rectInstances->count = 0;
+}
+
+static LC_GL_RectInstance* LC_GL_Instanced_Reserve(const LC_GL_Renderer *renderer, const GLuint textureId) {
+    LC_GL_RectInstances *rectInstances = renderer->rectInstances;
+    // Batched quads drawn before this one have to reach the screen before it
+    if (renderer->quadBatch->vertices != nullptr) LC_GL_Batch_Flush(renderer);
+    if (rectInstances->currentTextureId != textureId ||
+        (rectInstances->instances != nullptr && rectInstances->count == rectInstances->mappedCapacity)) {
+        LC_GL_Instanced_Flush(renderer);
+        rectInstances->currentTextureId = textureId;
+    }
+    if (rectInstances->instances == nullptr) {
+        constexpr GLsizeiptr instanceSize = sizeof(LC_GL_RectInstance);
+        GLsizeiptr mappedSize;
+        rectInstances->instances = LC_GL_StreamBuffer_Map(&rectInstances->instanceStream, instanceSize,
+                                                          rectInstances->capacity * instanceSize, instanceSize,
+                                                          &rectInstances->instancesOffset, &mappedSize);
+        rectInstances->mappedCapacity = (uint32)(mappedSize / instanceSize);
+        rectInstances->count = 0;
+    }
+
+    renderer->quadBatch->quadCount++;
+    return &rectInstances->instances[rectInstances->count++];
+}
+
+static inline void LC_GL_Instanced_SetRect(LC_GL_RectInstance *instance, const LC_FRect *rect, const LC_Color *color,
+                                           const float rotation) {
+    instance->x = rect->x;
+    instance->y = rect->y;
+    instance->w = rect->w;
+    instance->h = rect->h;
+    instance->rotation = rotation;
+    instance->color[0] = (uint8)color->r;
+    instance->color[1] = (uint8)color->g;
+    instance->color[2] = (uint8)color->b;
+    instance->color[3] = (uint8)(color->a * 255.0f);
+}
+
+void LC_GL_Instanced_DrawRect(const LC_GL_Renderer *renderer, const LC_FRect *rect, const LC_Color *color,
+                              const float rotation) {
+    LC_GL_RectInstance *instance = LC_GL_Instanced_Reserve(renderer, renderer->quadBatch->whiteTextureId);
+    LC_GL_Instanced_SetRect(instance, rect, color, rotation);
+    instance->textureRect[0] = 0;
+    instance->textureRect[1] = 0;
+    instance->textureRect[2] = UINT16_MAX;
+    instance->textureRect[3] = UINT16_MAX;
+}
+
+void LC_GL_Instanced_DrawTexturedRect(const LC_GL_Renderer *renderer, const LC_FRect *rect, const GLuint textureId,
+                                      const LC_FRect *textureRect, const LC_Color *tint, const float rotation) {
+    static const LC_FRect wholeTexture = {0.0f, 0.0f, 1.0f, 1.0f};
+    static const LC_Color white = {255.0f, 255.0f, 255.0f, 1.0f};
+    if (textureRect == nullptr) textureRect = &wholeTexture;
+    if (tint == nullptr) tint = &white;
+
+    LC_GL_RectInstance *instance = LC_GL_Instanced_Reserve(renderer, textureId);
+    LC_GL_Instanced_SetRect(instance, rect, tint, rotation);
+    instance->textureRect[0] = (uint16)(textureRect->x * UINT16_MAX + 0.5f);
+    instance->textureRect[1] = (uint16)(textureRect->y * UINT16_MAX + 0.5f);
+    instance->textureRect[2] = (uint16)((textureRect->x + textureRect->w) * UINT16_MAX + 0.5f);
+    instance->textureRect[3] = (uint16)((textureRect->y + textureRect->h) * UINT16_MAX + 0.5f);
+}
+
+void LC_GL_DeleteRectInstances(LC_GL_RectInstances *rectInstances) {
+    GLCall(glDeleteVertexArrays(1, &rectInstances->vao));
+    LC_GL_StreamBuffer_Destroy(&rectInstances->instanceStream);
+    GLCall(glDeleteProgram(rectInstances->shader->programId));
+}
+
 // ==================================================================================================================
 // Video Core
 // ==================================================================================================================
@@ -557,6 +1214,24 @@ void LC_GL_InitializeRenderer(LC_Arena *arena, LC_GL_Renderer *renderer, const i
     renderer->gameText->fontShader = LC_Arena_Allocate(arena, sizeof(LC_GL_Shader));
     renderer->gameText->fontShader->vertexShaderPath = LC_Arena_Allocate(arena, sizeof(LC_String));
     renderer->gameText->fontShader->fragmentShaderPath = LC_Arena_Allocate(arena, sizeof(LC_String));
+    renderer->quadBatch = LC_Arena_Allocate(arena, sizeof(LC_GL_QuadBatch));
+    renderer->quadBatch->shader = LC_Arena_Allocate(arena, sizeof(LC_GL_Shader));
+    renderer->quadBatch->shader->vertexShaderPath = LC_Arena_Allocate(arena, sizeof(LC_String));
+    renderer->quadBatch->shader->fragmentShaderPath = LC_Arena_Allocate(arena, sizeof(LC_String));
+    renderer->rectInstances = LC_Arena_Allocate(arena, sizeof(LC_GL_RectInstances));
+    renderer->rectInstances->shader = LC_Arena_Allocate(arena, sizeof(LC_GL_Shader));
+    renderer->rectInstances->shader->vertexShaderPath = LC_Arena_Allocate(arena, sizeof(LC_String));
+    renderer->rectInstances->shader->fragmentShaderPath = LC_Arena_Allocate(arena, sizeof(LC_String));
+    renderer->rectRenderMode = LC_GL_RECT_MODE_BATCHED;
+
+    // Uniforms are looked up by interned name, the IDs of the built in ones index the shaders' location caches
+    renderer->names = LC_Arena_Allocate(arena, sizeof(LC_StringInterner));
+    LC_StringInterner_Initialize(renderer->names, arena, false);
+    renderer->uniformIds.model = LC_StringInterner_InternCString(renderer->names, "model");
+    renderer->uniformIds.color = LC_StringInterner_InternCString(renderer->names, "aColor");
+    renderer->uniformIds.viewProjectionMatrix = LC_StringInterner_InternCString(renderer->names, "viewProjectionMatrix");
+    renderer->uniformIds.fontAtlasTexture = LC_StringInterner_InternCString(renderer->names, "fontAtlasTexture");
+    renderer->uniformIds.spriteTexture = LC_StringInterner_InternCString(renderer->names, "spriteTexture");
 }
 
 int32 LC_GL_InitializeVideo(LC_Arena *arena, LC_GL_Renderer *renderer, const char *title, const char *fontName,
@@ -617,8 +1292,27 @@ int32 LC_GL_InitializeVideo(LC_Arena *arena, LC_GL_Renderer *renderer, const cha
     LC_GL_IsDSAAvailable(renderer) ? 
         LC_String_InitializeByCopy(arena, renderer->defaultShader->fragmentShaderPath, "shaders/default.frag") : 
         LC_String_InitializeByCopy(arena, renderer->defaultShader->fragmentShaderPath, "shaders/default330.frag");
+    // Instanced rectangles shade like the batch, only the vertex stage differs
+    LC_GL_IsDSAAvailable(renderer) ?
+        LC_String_InitializeByCopy(arena, renderer->rectInstances->shader->vertexShaderPath,
+                                   "shaders/defaultInstanced.vert") :
+        LC_String_InitializeByCopy(arena, renderer->rectInstances->shader->vertexShaderPath,
+                                   "shaders/defaultInstanced330.vert");
+    LC_GL_IsDSAAvailable(renderer) ?
+        LC_String_InitializeByCopy(arena, renderer->rectInstances->shader->fragmentShaderPath, "shaders/batch.frag") :
+        LC_String_InitializeByCopy(arena, renderer->rectInstances->shader->fragmentShaderPath, "shaders/batch330.frag");
     LC_GL_SetupDefaultRectRenderer(arena, renderer, errorLog);
 
+    LC_GL_IsDSAAvailable(renderer) ?
+        LC_String_InitializeByCopy(arena, renderer->quadBatch->shader->vertexShaderPath, "shaders/batch.vert") :
+        LC_String_InitializeByCopy(arena, renderer->quadBatch->shader->vertexShaderPath, "shaders/batch330.vert");
+    LC_GL_IsDSAAvailable(renderer) ?
+        LC_String_InitializeByCopy(arena, renderer->quadBatch->shader->fragmentShaderPath, "shaders/batch.frag") :
+        LC_String_InitializeByCopy(arena, renderer->quadBatch->shader->fragmentShaderPath, "shaders/batch330.frag");
+    if (!LC_GL_SetupQuadBatch(arena, renderer, errorLog)) {
+        SDL_Log("%s", errorLog);
+    }
+
     LC_GL_IsDSAAvailable(renderer) ?
         LC_String_InitializeByCopy(arena, renderer->gameText->fontShader->vertexShaderPath, "shaders/text.vert") : 
         LC_String_InitializeByCopy(arena, renderer->gameText->fontShader->vertexShaderPath, "shaders/text330.vert");
@@ -627,6 +1321,8 @@ int32 LC_GL_InitializeVideo(LC_Arena *arena, LC_GL_Renderer *renderer, const cha
         LC_String_InitializeByCopy(arena, renderer->gameText->fontShader->fragmentShaderPath, "shaders/text330.frag");
     LC_GL_InitializeTextRenderer(arena, renderer, fontName, 48.0f, errorLog);
 
+    LC_GL_StreamBuffer_Initialize(&renderer->gameText->vertexStream, TEXT_STREAM_SEGMENT_SIZE,
+                                  LC_GL_IsBufferStorageAvailable(renderer));
     LC_GL_IsDSAAvailable(renderer) ? LC_GL_SetupVaoAndVboTextDSA(renderer->gameText) :
         LC_GL_SetupVaoAndVboTextNonDSA(renderer->gameText);
 
@@ -657,10 +1353,20 @@ void LC_GL_SetupDefaultRectRenderer(LC_Arena *arena, LC_GL_Renderer *renderer, c
     if (!LC_GL_InitializeShader(arena, renderer->defaultShader, errorLog)) {
         SDL_Log("%s", errorLog);
     }
+    if (!LC_GL_InitializeShader(arena, renderer->rectInstances->shader, errorLog)) {
+        SDL_Log("%s", errorLog);
+    }
+    LC_GL_RectInstances *rectInstances = renderer->rectInstances;
+    rectInstances->capacity = LC_GL_INSTANCED_MAX_RECTS;
+    rectInstances->count = 0;
+    rectInstances->instances = nullptr;
+    rectInstances->instancesOffset = 0;
+    rectInstances->mappedCapacity = 0;
 
     glUseProgram(renderer->defaultShader->programId);
-    LC_GL_SetUniformMat4(renderer->defaultShader->programId, "viewProjectionMatrix",
-                         &renderer->viewProjectionMatrix);
+    GLCall(glUniformMatrix4fv(LC_GL_GetUniformLocation(renderer, renderer->defaultShader,
+                                                       renderer->uniformIds.viewProjectionMatrix),
+                              1, GL_FALSE, renderer->viewProjectionMatrix[0]));
 
     // Setup VAO, VBO, EBO
     constexpr float vertices[] = {
@@ -702,6 +1408,7 @@ void LC_GL_SetupDefaultRectRenderer(LC_Arena *arena, LC_GL_Renderer *renderer, c
         GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
         GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
 
+        LC_GL_SetupRectInstancesNonDSA(renderer);
         return;
     }
 
@@ -724,6 +1431,8 @@ void LC_GL_SetupDefaultRectRenderer(LC_Arena *arena, LC_GL_Renderer *renderer, c
     GLCall(glVertexArrayAttribFormat(renderer->defaultVertexArrayObject, positionIndex, 2, GL_FLOAT, GL_FALSE, 0));
 
     GLCall(glVertexArrayAttribBinding(renderer->defaultVertexArrayObject, positionIndex, vaoBindingPoint));
+
+    LC_GL_SetupRectInstancesDSA(renderer);
 }
 
 void LC_GL_ClearBackground(const LC_Color color) {
@@ -733,21 +1442,32 @@ void LC_GL_ClearBackground(const LC_Color color) {
 
 void LC_GL_RenderRectangle(const LC_GL_Renderer *renderer, const LC_FRect *rect, const LC_Color *color,
                            const bool isWireframe) {
+    // Between LC_GL_BeginFrame and LC_GL_EndFrame the rectangle joins the batch instead of being drawn on its own
+    if (renderer->quadBatch->isInFrame) {
+        if (renderer->rectRenderMode == LC_GL_RECT_MODE_INSTANCED && !isWireframe) {
+            LC_GL_Instanced_DrawRect(renderer, rect, color, 0.0f);
+        } else {
+            LC_GL_Batch_DrawRect(renderer, rect, color, isWireframe);
+        }
+        return;
+    }
+
     const vec4 aColor = { color->r, color->g, color->b, color->a };
     mat4 model = GLM_MAT4_IDENTITY_INIT;
     vec3 translate = { rect->x, rect->y, 0.0f };
     glm_translate(model, translate);
     vec3 scale = { rect->w, rect->h, 1.0f };
     glm_scale(model, scale);
-    const GLuint defaultShaderProgramId = renderer->defaultShader->programId;
+    LC_GL_Shader *defaultShader = renderer->defaultShader;
 
     // Setup Before Render
     GLCall(glEnable(GL_BLEND));
     GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
 
-    GLCall(glUseProgram(defaultShaderProgramId));
-    LC_GL_SetUniformVec4(defaultShaderProgramId, "aColor", aColor);
-    LC_GL_SetUniformMat4(defaultShaderProgramId, "model", &model);
+    GLCall(glUseProgram(defaultShader->programId));
+    GLCall(glUniform4fv(LC_GL_GetUniformLocation(renderer, defaultShader, renderer->uniformIds.color), 1, aColor));
+    GLCall(glUniformMatrix4fv(LC_GL_GetUniformLocation(renderer, defaultShader, renderer->uniformIds.model),
+                              1, GL_FALSE, model[0]));
     GLCall(glBindVertexArray(renderer->defaultVertexArrayObject));
 
     // Render
@@ -769,6 +1489,9 @@ bool LC_GL_SwapBuffer(SDL_Window *window, char *errorLog) {
 
 void LC_GL_FreeResources(const LC_GL_Renderer *renderer) {
     LC_GL_DeleteTextRenderer(renderer->gameText);
+    LC_GL_DeleteQuadBatch(renderer->quadBatch);
+    LC_GL_DeleteRectInstances(renderer->rectInstances);
+    LC_StringInterner_Destroy(renderer->names);
     GLCall(glDeleteBuffers(1, &renderer->defaultVertexBufferObject));
     GLCall(glDeleteBuffers(1, &renderer->defaultElementBufferObject));
     GLCall(glDeleteVertexArrays(1, &renderer->defaultVertexArrayObject));
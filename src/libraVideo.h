@@ -18,6 +18,27 @@ do { \
     LC_GL_ASSERT(GLLogCall(#x, __FILE__, __LINE__)) \
 } while(0)
 
+// Uniform names with an interned ID below this have their location cached in every shader
+#ifndef LC_GL_CACHED_UNIFORM_COUNT
+#define LC_GL_CACHED_UNIFORM_COUNT 16
+#endif
+#define LC_GL_UNIFORM_NOT_CACHED (-2)
+
+// Segments of a streaming vertex buffer, the GPU can read from the others while one is written
+#ifndef LC_GL_STREAM_BUFFER_SEGMENTS
+#define LC_GL_STREAM_BUFFER_SEGMENTS 3
+#endif
+
+// Quads the batch renderer collects before it has to flush, a wireframe rectangle takes the room of two
+#ifndef LC_GL_BATCH_MAX_QUADS
+#define LC_GL_BATCH_MAX_QUADS 8192
+#endif
+
+// Rectangles the instanced renderer collects before it has to flush
+#ifndef LC_GL_INSTANCED_MAX_RECTS
+#define LC_GL_INSTANCED_MAX_RECTS 65536
+#endif
+
 // =============================================STRUCTS==============================================================
 
 // SHADER
@@ -25,8 +46,33 @@ typedef struct shader_gl {
     GLuint programId;
     LC_String *vertexShaderPath;
     LC_String *fragmentShaderPath;
+    GLint uniformLocations[LC_GL_CACHED_UNIFORM_COUNT];
 } LC_GL_Shader;
 
+// Interned IDs of the uniform names the built in shaders use
+typedef struct {
+    uint32 model;
+    uint32 color;
+    uint32 viewProjectionMatrix;
+    uint32 fontAtlasTexture;
+    uint32 spriteTexture;
+} LC_GL_UniformIds;
+
+// STREAMING BUFFERS
+// Dynamic vertex data is written straight into the buffer: persistently mapped ring segments guarded by fences on
+// GL 4.4+, ranges mapped without synchronization and orphaned buffers on GL 3.3
+typedef struct streamBuffer_gl {
+    GLuint buffer;
+    GLsizeiptr segmentSize;
+    GLsizeiptr size;
+    bool isPersistent;
+    uchar *mapped;
+    GLsync fences[LC_GL_STREAM_BUFFER_SEGMENTS];
+    uint32 segment;
+    GLintptr offset;
+    GLintptr mappedOffset;
+} LC_GL_StreamBuffer;
+
 // TEXT RENDERING
 typedef struct text {
     char *string;
@@ -39,7 +85,7 @@ typedef struct text {
 
 typedef struct textSettings {
     GLuint vao;
-    GLuint vbo;
+    LC_GL_StreamBuffer vertexStream;
     GLuint fontAtlasTextureId;
     LC_GL_Shader *fontShader;
     char *fontName;
@@ -50,6 +96,70 @@ typedef struct textSettings {
     stbtt_aligned_quad *alignedQuads;
 } LC_GL_TextSettings;
 
+// BATCHED 2D RENDERING
+typedef struct {
+    float x;
+    float y;
+    float r;    // Color like LC_Color, rgb between 0.0f and 255.0f
+    float g;
+    float b;
+    float a;
+    float u;
+    float v;
+} LC_GL_BatchVertex;
+
+typedef struct quadBatch_gl {
+    GLuint vao;
+    LC_GL_StreamBuffer vertexStream;
+    GLuint ebo;
+    // Solid quads sample this 1x1 white texture, so they share batches with textured ones
+    GLuint whiteTextureId;
+    LC_GL_Shader *shader;
+    LC_GL_Shader *currentShader;
+    GLuint currentTextureId;
+    GLenum currentPrimitive;
+    // Points into the mapped vertex stream while the batch has room reserved there, NULL otherwise
+    LC_GL_BatchVertex *vertices;
+    GLintptr verticesOffset;
+    uint32 mappedVertexCapacity;
+    uint32 vertexCount;
+    uint32 vertexCapacity;
+    bool isInFrame;
+    // Statistics of the current frame
+    uint32 drawCallCount;
+    uint32 quadCount;
+} LC_GL_QuadBatch;
+
+// INSTANCED RECTANGLES
+// 32 bytes per rectangle, the unit quad of the default rectangle renderer is expanded on the GPU
+typedef struct {
+    float x;
+    float y;
+    float w;
+    float h;
+    float rotation;         // Radians, around the center of the rectangle
+    uint8 color[4];         // LC_Color with the alpha scaled to 0 - 255
+    uint16 textureRect[4];  // u0, v0, u1, v1 scaled to 0 - 65535
+} LC_GL_RectInstance;
+
+typedef enum {
+    LC_GL_RECT_MODE_BATCHED,
+    LC_GL_RECT_MODE_INSTANCED
+} LC_GL_RectRenderMode;
+
+typedef struct rectInstances_gl {
+    GLuint vao;
+    LC_GL_StreamBuffer instanceStream;
+    LC_GL_Shader *shader;
+    GLuint currentTextureId;
+    // Points into the mapped instance stream while room is reserved there, NULL otherwise
+    LC_GL_RectInstance *instances;
+    GLintptr instancesOffset;
+    uint32 mappedCapacity;
+    uint32 count;
+    uint32 capacity;
+} LC_GL_RectInstances;
+
 // GAME CORE
 typedef struct color {
     float r;    // Value between 0.0f and 255.0f
@@ -82,8 +192,14 @@ typedef struct renderer_gl {
     GLuint defaultVertexBufferObject;
     GLuint defaultElementBufferObject;
     LC_GL_TextSettings *gameText;
+    LC_GL_QuadBatch *quadBatch;
+    LC_GL_RectInstances *rectInstances;
+    // How LC_GL_RenderRectangle draws filled rectangles inside a frame
+    LC_GL_RectRenderMode rectRenderMode;
     GLint glMajorVersion;
     GLint glMinorVersion;
+    LC_StringInterner *names;
+    LC_GL_UniformIds uniformIds;
 } LC_GL_Renderer;
 
 // ==================================================================================================================
@@ -106,6 +222,8 @@ void LC_GL_SetUniformMat2(GLuint programId, const char *name, const mat2 *mat);
 void LC_GL_SetUniformMat3(GLuint programId, const char *name, const mat3 *mat);
 void LC_GL_SetUniformMat4(GLuint programId, const char *name, const mat4 *mat);
 
+GLint LC_GL_GetUniformLocation(const LC_GL_Renderer *renderer, LC_GL_Shader *shader, uint32 nameId);
+
 bool CheckCompileErrors(GLuint programId, char *type, char *buffer);
 
 // ==================================================================================================================
@@ -121,12 +239,61 @@ void LC_GL_CreateTextureTextNonDSA(LC_GL_TextSettings *gameText, int32 fontAtlas
 void LC_GL_SetupVaoAndVboTextDSA(LC_GL_TextSettings *gameText);
 void LC_GL_SetupVaoAndVboTextNonDSA(LC_GL_TextSettings *gameText);
 void LC_GL_RenderText(const LC_GL_Renderer *renderer, LC_GL_Text *text);
-void LC_GL_RenderTextDSA(const LC_GL_Renderer *renderer, GLint totalVertices, GLuint sizeOfBuffer, const float *buffer);
-void LC_GL_RenderTextNonDSA(const LC_GL_Renderer *renderer, GLint totalVertices, GLuint sizeOfBuffer, const float *buffer);
+void LC_GL_RenderTextDSA(const LC_GL_Renderer *renderer, GLint firstVertex, GLint totalVertices);
+void LC_GL_RenderTextNonDSA(const LC_GL_Renderer *renderer, GLint firstVertex, GLint totalVertices);
 void LC_GL_InsertTextBytesIntoBuffer(float *buffer, const LC_GL_TextSettings *gameText, LC_GL_Text *text);
 
 // ==================================================================================================================
 
+// =============================================Streaming Buffers====================================================
+
+bool LC_GL_IsBufferStorageAvailable(const LC_GL_Renderer *renderer);
+void LC_GL_StreamBuffer_Initialize(LC_GL_StreamBuffer *stream, GLsizeiptr segmentSize, bool usePersistentMapping);
+// Returns write only memory for at least 'minimumSize' (above 0) and at most 'maximumSize' bytes, '*size' is set to
+// how many. '*offset' is where it starts in the buffer, a multiple of 'alignment' (the stride of the vertices written
+// there). Nothing the GPU may still read is handed out again.
+void* LC_GL_StreamBuffer_Map(LC_GL_StreamBuffer *stream, GLsizeiptr minimumSize, GLsizeiptr maximumSize,
+                             GLsizeiptr alignment, GLintptr *offset, GLsizeiptr *size);
+// Ends the write, 'usedSize' bytes of the mapped range are kept and can be drawn from
+void LC_GL_StreamBuffer_Unmap(LC_GL_StreamBuffer *stream, GLsizeiptr usedSize);
+void LC_GL_StreamBuffer_Destroy(LC_GL_StreamBuffer *stream);
+
+// ==================================================================================================================
+
+// =============================================Batched 2D Rendering=================================================
+
+// Rectangles drawn between LC_GL_BeginFrame and LC_GL_EndFrame are collected into one vertex buffer and drawn with
+// one call per batch. A batch is flushed when the texture, the shader or the primitive (filled or wireframe) changes
+// and when it is full. LC_GL_RenderRectangle goes through the batch as well while a frame is open.
+bool LC_GL_SetupQuadBatch(LC_Arena *arena, LC_GL_Renderer *renderer, char *errorLog);
+void LC_GL_SetupQuadBatchDSA(LC_GL_QuadBatch *batch, const uint32 *indices, GLsizeiptr sizeOfIndices);
+void LC_GL_SetupQuadBatchNonDSA(LC_GL_QuadBatch *batch, const uint32 *indices, GLsizeiptr sizeOfIndices);
+void LC_GL_BeginFrame(const LC_GL_Renderer *renderer);
+void LC_GL_EndFrame(const LC_GL_Renderer *renderer);
+void LC_GL_Batch_DrawRect(const LC_GL_Renderer *renderer, const LC_FRect *rect, const LC_Color *color, bool isWireframe);
+// 'textureRect' is in normalized texture coordinates, NULL draws the whole texture. A NULL tint draws it unchanged.
+void LC_GL_Batch_DrawTexturedRect(const LC_GL_Renderer *renderer, const LC_FRect *rect, GLuint textureId,
+                                  const LC_FRect *textureRect, const LC_Color *tint);
+// Draws with a custom shader until the next call, NULL goes back to the default one. The shader takes the vertex
+// layout of LC_GL_BatchVertex and the viewProjectionMatrix and spriteTexture uniforms.
+void LC_GL_Batch_SetShader(const LC_GL_Renderer *renderer, LC_GL_Shader *shader);
+void LC_GL_Batch_Flush(const LC_GL_Renderer *renderer);
+void LC_GL_DeleteQuadBatch(LC_GL_QuadBatch *batch);
+
+// Instanced rectangles reuse the unit quad of LC_GL_SetupDefaultRectRenderer and draw up to LC_GL_INSTANCED_MAX_RECTS
+// of them with one glDrawElementsInstanced. They are flushed on texture changes like the batch, drawing with the batch
+// and with instances in the same frame keeps the order they were drawn in.
+void LC_GL_SetupRectInstancesDSA(LC_GL_Renderer *renderer);
+void LC_GL_SetupRectInstancesNonDSA(LC_GL_Renderer *renderer);
+void LC_GL_Instanced_DrawRect(const LC_GL_Renderer *renderer, const LC_FRect *rect, const LC_Color *color,
+                              float rotation);
+void LC_GL_Instanced_DrawTexturedRect(const LC_GL_Renderer *renderer, const LC_FRect *rect, GLuint textureId,
+                                      const LC_FRect *textureRect, const LC_Color *tint, float rotation);
+void LC_GL_Instanced_Flush(const LC_GL_Renderer *renderer);
+void LC_GL_DeleteRectInstances(LC_GL_RectInstances *rectInstances);
+
+// ==================================================================================================================
+
 // =============================================Video Core============================================================
 
 void LC_Color_Initialize(float red, float green, float blue, float alpha, LC_Color *color);
@@ -2,15 +2,337 @@
 // Created by Fraz Mahmud on 6/1/2025.
 //
 #ifdef __linux__
+// CPU sets and pthread_setaffinity_np are GNU extensions
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
 #include <unistd.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 
 
 #include <linux/libraC-linux.h>
 
 #include <libraC.h>
+#include <libraCore.h>
 
 void LC_Linux_GetCurrentWorkingDirectory(char* buffer, const size_t size) {
     getcwd(buffer, (int32)size);
 }
 
+void* LC_Linux_MapMemory(const size_t size) {
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return NULL;
+    return memory;
+}
+
+void LC_Linux_UnmapMemory(void *memory, const size_t size) {
+    munmap(memory, size);
+}
+
+void* LC_Linux_ReserveMemory(const size_t size) {
+    // Reserved pages are inaccessible and do not count against resident memory until they are committed
+    void *memory = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (memory == MAP_FAILED) return NULL;
+    return memory;
+}
+
+bool LC_Linux_CommitMemory(void *memory, const size_t size) {
+    return mprotect(memory, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void LC_Linux_DecommitMemory(void *memory, const size_t size) {
+    // Hand the physical pages back to the kernel, the address range itself stays reserved
+    madvise(memory, size, MADV_DONTNEED);
+    mprotect(memory, size, PROT_NONE);
+}
+
+// Pipes, character devices and files in /proc report no usable size and can't be mapped, they are read in one pass
+// into a buffer that doubles whenever it fills up. Nothing is kept for an empty file.
+static bool LC_Linux_ReadWholeFile(const int32 fileDescriptor, size_t capacity, void **data, size_t *length) {
+    if (capacity < 64 * 1024) capacity = 64 * 1024;
+    uchar *buffer = malloc(capacity);
+    if (buffer == NULL) return false;
+
+    size_t used = 0;
+    for (;;) {
+        if (used == capacity) {
+            uchar *grown = realloc(buffer, capacity * 2);
+            if (grown == NULL) {
+                free(buffer);
+                return false;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
+        const ssize_t bytesRead = read(fileDescriptor, buffer + used, capacity - used);
+        if (bytesRead < 0 && errno == EINTR) continue;
+        if (bytesRead < 0) {
+            free(buffer);
+            return false;
+        }
+        if (bytesRead == 0) break;
+        used += (size_t) bytesRead;
+    }
+    if (used == 0) {
+        free(buffer);
+        buffer = NULL;
+    }
+
+    *data = buffer;
+    *length = used;
+    return true;
+}
+
+bool LC_Linux_MapFile(const char *filePath, const uint32_t hints, void **data, size_t *length, bool *isMapped) {
+    *data = NULL;
+    *length = 0;
+    *isMapped = false;
+
+    const int32 fileDescriptor = open(filePath, O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor < 0) return false;
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0) {
+        close(fileDescriptor);
+        return false;
+    }
+
+    // Files in /proc claim to be empty regular files, so a zero size is not trusted either
+    if (!S_ISREG(fileStatus.st_mode) || fileStatus.st_size == 0) {
+        const bool success = LC_Linux_ReadWholeFile(fileDescriptor, 0, data, length);
+        close(fileDescriptor);
+        return success;
+    }
+
+    const size_t fileSize = (size_t) fileStatus.st_size;
+    void *memory = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (memory == MAP_FAILED) {
+        const bool success = LC_Linux_ReadWholeFile(fileDescriptor, fileSize, data, length);
+        close(fileDescriptor);
+        return success;
+    }
+    // The mapping keeps its own reference to the file
+    close(fileDescriptor);
+
+    if (hints & LC_FILE_HINT_SEQUENTIAL) madvise(memory, fileSize, MADV_SEQUENTIAL);
+    if (hints & LC_FILE_HINT_RANDOM) madvise(memory, fileSize, MADV_RANDOM);
+    if (hints & LC_FILE_HINT_WILL_NEED) madvise(memory, fileSize, MADV_WILLNEED);
+
+    *data = memory;
+    *length = fileSize;
+    *isMapped = true;
+    return true;
+}
+
+void LC_Linux_UnmapFile(void *data, const size_t length, const bool isMapped) {
+    if (isMapped) munmap(data, length);
+    else free(data);
+}
+
+bool LC_Linux_PinCurrentThread(const uint32_t core) {
+    if (core >= CPU_SETSIZE) return false;
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+}
+
+bool LC_Linux_OpenFileForReading(const char *filePath, int32_t *fileDescriptor, uint64_t *size) {
+    *fileDescriptor = open(filePath, O_RDONLY | O_CLOEXEC);
+    if (*fileDescriptor < 0) return false;
+
+    struct stat fileStatus;
+    if (fstat(*fileDescriptor, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode)) {
+        close(*fileDescriptor);
+        *fileDescriptor = -1;
+        return false;
+    }
+    *size = (uint64_t) fileStatus.st_size;
+    return true;
+}
+
+void LC_Linux_CloseFile(const int32_t fileDescriptor) {
+    close(fileDescriptor);
+}
+
+// The ring heads and tails are shared with the kernel. The submission tail and completion head are only written by
+// this side, the other two are written by the kernel and read with acquire ordering.
+struct linuxIoRing {
+    int32 fileDescriptor;
+    uint32 *submissionHead;
+    uint32 *submissionTail;
+    uint32 submissionMask;
+    uint32 *submissionArray;
+    struct io_uring_sqe *submissionEntries;
+    uint32 submissionEntryCount;
+    uint32 queuedCount;
+    uint32 *completionHead;
+    uint32 *completionTail;
+    uint32 completionMask;
+    struct io_uring_cqe *completionEntries;
+    void *submissionRing;
+    size_t submissionRingSize;
+    void *completionRing;
+    size_t completionRingSize;
+};
+
+#if defined(__NR_io_uring_setup) && defined(IORING_FEAT_RW_CUR_POS)
+static void LC_Linux_IoRing_Unmap(LC_Linux_IoRing *ring) {
+    if (ring->submissionEntries != NULL && ring->submissionEntries != MAP_FAILED) {
+        munmap(ring->submissionEntries, ring->submissionEntryCount * sizeof(struct io_uring_sqe));
+    }
+    if (ring->completionRing != ring->submissionRing && ring->completionRing != NULL &&
+        ring->completionRing != MAP_FAILED) {
+        munmap(ring->completionRing, ring->completionRingSize);
+    }
+    if (ring->submissionRing != NULL && ring->submissionRing != MAP_FAILED) {
+        munmap(ring->submissionRing, ring->submissionRingSize);
+    }
+}
+
+LC_Linux_IoRing* LC_Linux_IoRing_Create(const uint32_t entryCount) {
+    struct io_uring_params parameters;
+    memset(&parameters, 0, sizeof(parameters));
+    const int32 fileDescriptor = (int32) syscall(__NR_io_uring_setup, entryCount, &parameters);
+    if (fileDescriptor < 0) return NULL;
+    // Reading the file position was added together with IORING_OP_READ, older kernels only have the vectored reads
+    if (!(parameters.features & IORING_FEAT_RW_CUR_POS)) {
+        close(fileDescriptor);
+        return NULL;
+    }
+
+    LC_Linux_IoRing *ring = calloc(1, sizeof(LC_Linux_IoRing));
+    if (ring == NULL) {
+        close(fileDescriptor);
+        return NULL;
+    }
+    ring->fileDescriptor = fileDescriptor;
+    ring->submissionEntryCount = parameters.sq_entries;
+    ring->submissionRingSize = parameters.sq_off.array + parameters.sq_entries * sizeof(uint32);
+    ring->completionRingSize = parameters.cq_off.cqes + parameters.cq_entries * sizeof(struct io_uring_cqe);
+
+    // Since 5.4 both rings live in one mapping
+    const bool isSingleMapping = parameters.features & IORING_FEAT_SINGLE_MMAP;
+    if (isSingleMapping && ring->completionRingSize > ring->submissionRingSize) {
+        ring->submissionRingSize = ring->completionRingSize;
+    }
+    ring->submissionRing = mmap(NULL, ring->submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                fileDescriptor, IORING_OFF_SQ_RING);
+    ring->completionRing = isSingleMapping
+                               ? ring->submissionRing
+                               : mmap(NULL, ring->completionRingSize, PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_POPULATE, fileDescriptor, IORING_OFF_CQ_RING);
+    ring->submissionEntries = mmap(NULL, parameters.sq_entries * sizeof(struct io_uring_sqe), PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, fileDescriptor, IORING_OFF_SQES);
+    if (ring->submissionRing == MAP_FAILED || ring->completionRing == MAP_FAILED ||
+        ring->submissionEntries == MAP_FAILED) {
+        LC_Linux_IoRing_Unmap(ring);
+        close(fileDescriptor);
+        free(ring);
+        return NULL;
+    }
+
+    uchar *submission = ring->submissionRing;
+    ring->submissionHead = (uint32 *) (submission + parameters.sq_off.head);
+    ring->submissionTail = (uint32 *) (submission + parameters.sq_off.tail);
+    ring->submissionMask = *(uint32 *) (submission + parameters.sq_off.ring_mask);
+    ring->submissionArray = (uint32 *) (submission + parameters.sq_off.array);
+
+    uchar *completion = ring->completionRing;
+    ring->completionHead = (uint32 *) (completion + parameters.cq_off.head);
+    ring->completionTail = (uint32 *) (completion + parameters.cq_off.tail);
+    ring->completionMask = *(uint32 *) (completion + parameters.cq_off.ring_mask);
+    ring->completionEntries = (struct io_uring_cqe *) (completion + parameters.cq_off.cqes);
+    return ring;
+}
+
+void LC_Linux_IoRing_Destroy(LC_Linux_IoRing *ring) {
+    if (ring == NULL) return;
+    LC_Linux_IoRing_Unmap(ring);
+    close(ring->fileDescriptor);
+    free(ring);
+}
+
+bool LC_Linux_IoRing_QueueRead(LC_Linux_IoRing *ring, const int32_t fileDescriptor, void *buffer,
+                               const uint32_t length, const uint64_t offset, const uint64_t userData) {
+    const uint32 tail = *ring->submissionTail;
+    const uint32 head = __atomic_load_n(ring->submissionHead, __ATOMIC_ACQUIRE);
+    if (tail - head >= ring->submissionEntryCount) return false;
+
+    const uint32 index = tail & ring->submissionMask;
+    struct io_uring_sqe *entry = &ring->submissionEntries[index];
+    memset(entry, 0, sizeof(*entry));
+    entry->opcode = IORING_OP_READ;
+    entry->fd = fileDescriptor;
+    entry->addr = (uint64) (uintptr_t) buffer;
+    entry->len = length;
+    entry->off = offset;
+    entry->user_data = userData;
+    ring->submissionArray[index] = index;
+
+    // The entry has to be complete before the kernel can see the new tail
+    __atomic_store_n(ring->submissionTail, tail + 1, __ATOMIC_RELEASE);
+    ring->queuedCount++;
+    return true;
+}
+
+bool LC_Linux_IoRing_Submit(LC_Linux_IoRing *ring, const uint32_t waitCount) {
+    if (ring->queuedCount == 0 && waitCount == 0) return true;
+    const uint32 flags = waitCount > 0 ? IORING_ENTER_GETEVENTS : 0;
+    for (;;) {
+        const int64 submitted = syscall(__NR_io_uring_enter, ring->fileDescriptor, ring->queuedCount, waitCount, flags,
+                                        NULL, 0);
+        if (submitted < 0 && errno == EINTR) continue;
+        if (submitted < 0) return false;
+        ring->queuedCount -= (uint32) submitted;
+        return true;
+    }
+}
+
+bool LC_Linux_IoRing_PopCompletion(LC_Linux_IoRing *ring, uint64_t *userData, int32_t *result) {
+    const uint32 head = *ring->completionHead;
+    if (head == __atomic_load_n(ring->completionTail, __ATOMIC_ACQUIRE)) return false;
+
+    const struct io_uring_cqe *entry = &ring->completionEntries[head & ring->completionMask];
+    *userData = entry->user_data;
+    *result = entry->res;
+    // Hands the slot back to the kernel, the entry must have been read before that
+    __atomic_store_n(ring->completionHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+#else
+LC_Linux_IoRing* LC_Linux_IoRing_Create(const uint32_t entryCount) {
+    (void)entryCount;
+    return NULL;
+}
+
+void LC_Linux_IoRing_Destroy(LC_Linux_IoRing *ring) {
+    (void)ring;
+}
+
+bool LC_Linux_IoRing_QueueRead(LC_Linux_IoRing *ring, const int32_t fileDescriptor, void *buffer,
+                               const uint32_t length, const uint64_t offset, const uint64_t userData) {
+    (void)ring; (void)fileDescriptor; (void)buffer; (void)length; (void)offset; (void)userData;
+    return false;
+}
+
+bool LC_Linux_IoRing_Submit(LC_Linux_IoRing *ring, const uint32_t waitCount) {
+    (void)ring; (void)waitCount;
+    return false;
+}
+
+bool LC_Linux_IoRing_PopCompletion(LC_Linux_IoRing *ring, uint64_t *userData, int32_t *result) {
+    (void)ring; (void)userData; (void)result;
+    return false;
+}
+#endif
+
 #endif
@@ -6,7 +6,30 @@
 #define LIBRAC_LINUX_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 void LC_Linux_GetCurrentWorkingDirectory(char* buffer, size_t size);
+void* LC_Linux_MapMemory(size_t size);
+void LC_Linux_UnmapMemory(void *memory, size_t size);
+void* LC_Linux_ReserveMemory(size_t size);
+bool LC_Linux_CommitMemory(void *memory, size_t size);
+void LC_Linux_DecommitMemory(void *memory, size_t size);
+bool LC_Linux_MapFile(const char *filePath, uint32_t hints, void **data, size_t *length, bool *isMapped);
+void LC_Linux_UnmapFile(void *data, size_t length, bool isMapped);
+bool LC_Linux_PinCurrentThread(uint32_t core);
+bool LC_Linux_OpenFileForReading(const char *filePath, int32_t *fileDescriptor, uint64_t *size);
+void LC_Linux_CloseFile(int32_t fileDescriptor);
+
+// Minimal io_uring over the raw system calls. Create returns NULL when the kernel has no io_uring, or one too old for
+// IORING_OP_READ (5.6), or when it is blocked by a seccomp filter.
+typedef struct linuxIoRing LC_Linux_IoRing;
+
+LC_Linux_IoRing* LC_Linux_IoRing_Create(uint32_t entryCount);
+void LC_Linux_IoRing_Destroy(LC_Linux_IoRing *ring);
+bool LC_Linux_IoRing_QueueRead(LC_Linux_IoRing *ring, int32_t fileDescriptor, void *buffer, uint32_t length,
+                               uint64_t offset, uint64_t userData);
+bool LC_Linux_IoRing_Submit(LC_Linux_IoRing *ring, uint32_t waitCount);
+bool LC_Linux_IoRing_PopCompletion(LC_Linux_IoRing *ring, uint64_t *userData, int32_t *result);
 
 #endif //LIBRAC_LINUX_H
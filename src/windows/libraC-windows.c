@@ -3,14 +3,135 @@
 //
 #ifdef __WIN32
 #include <direct.h>
+#include <stdlib.h>
+#include <windows.h>
 
 
 #include <windows/libraC-windows.h>
 
 #include <libraC.h>
+#include <libraCore.h>
 
 void LC_Win32_GetCurrentWorkingDirectory(char* buffer, const size_t size) {
      _getcwd(buffer, (int32)size);
 }
 
+void* LC_Win32_MapMemory(const size_t size) {
+    return VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+void LC_Win32_UnmapMemory(void *memory, const size_t size) {
+    (void)size;
+    VirtualFree(memory, 0, MEM_RELEASE);
+}
+
+void* LC_Win32_ReserveMemory(const size_t size) {
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool LC_Win32_CommitMemory(void *memory, const size_t size) {
+    return VirtualAlloc(memory, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+void LC_Win32_DecommitMemory(void *memory, const size_t size) {
+    VirtualFree(memory, size, MEM_DECOMMIT);
+}
+
+// Pipes and consoles can't be mapped, they are read in one pass into a buffer that doubles whenever it fills up.
+// Nothing is kept for an empty file.
+static bool LC_Win32_ReadWholeFile(HANDLE file, size_t capacity, void **data, size_t *length) {
+    if (capacity < 64 * 1024) capacity = 64 * 1024;
+    uchar *buffer = malloc(capacity);
+    if (buffer == NULL) return false;
+
+    size_t used = 0;
+    for (;;) {
+        if (used == capacity) {
+            uchar *grown = realloc(buffer, capacity * 2);
+            if (grown == NULL) {
+                free(buffer);
+                return false;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
+        const size_t request = capacity - used < 0x40000000 ? capacity - used : 0x40000000;
+        DWORD bytesRead = 0;
+        if (!ReadFile(file, buffer + used, (DWORD) request, &bytesRead, NULL)) {
+            if (GetLastError() == ERROR_BROKEN_PIPE) break;
+            free(buffer);
+            return false;
+        }
+        if (bytesRead == 0) break;
+        used += bytesRead;
+    }
+    if (used == 0) {
+        free(buffer);
+        buffer = NULL;
+    }
+
+    *data = buffer;
+    *length = used;
+    return true;
+}
+
+bool LC_Win32_MapFile(const char *filePath, const uint32_t hints, void **data, size_t *length, bool *isMapped) {
+    *data = NULL;
+    *length = 0;
+    *isMapped = false;
+
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (hints & LC_FILE_HINT_SEQUENTIAL) flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    if (hints & LC_FILE_HINT_RANDOM) flags |= FILE_FLAG_RANDOM_ACCESS;
+    HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &fileSize)) {
+        const bool success = LC_Win32_ReadWholeFile(file, 0, data, length);
+        CloseHandle(file);
+        return success;
+    }
+    if (fileSize.QuadPart == 0) {
+        // File mappings can't be empty, an empty view needs no memory at all
+        CloseHandle(file);
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void *memory = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    // The view keeps the mapping and the file alive on its own
+    if (mapping != NULL) CloseHandle(mapping);
+    if (memory == NULL) {
+        const bool success = LC_Win32_ReadWholeFile(file, (size_t) fileSize.QuadPart, data, length);
+        CloseHandle(file);
+        return success;
+    }
+    CloseHandle(file);
+
+    if (hints & LC_FILE_HINT_WILL_NEED) {
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = memory;
+        range.NumberOfBytes = (SIZE_T) fileSize.QuadPart;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
+    *data = memory;
+    *length = (size_t) fileSize.QuadPart;
+    *isMapped = true;
+    return true;
+}
+
+void LC_Win32_UnmapFile(void *data, const size_t length, const bool isMapped) {
+    (void)length;
+    if (isMapped) UnmapViewOfFile(data);
+    else free(data);
+}
+
+bool LC_Win32_PinCurrentThread(const uint32_t core) {
+    // Affinity masks only cover the first processor group of 64 cores
+    if (core >= sizeof(DWORD_PTR) * 8) return false;
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR) 1 << core) != 0;
+}
+
 #endif
@@ -6,7 +6,17 @@
 #define LIBRAC_WINDOWS_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 void LC_Win32_GetCurrentWorkingDirectory(char* buffer, size_t size);
+void* LC_Win32_MapMemory(size_t size);
+void LC_Win32_UnmapMemory(void *memory, size_t size);
+void* LC_Win32_ReserveMemory(size_t size);
+bool LC_Win32_CommitMemory(void *memory, size_t size);
+void LC_Win32_DecommitMemory(void *memory, size_t size);
+bool LC_Win32_MapFile(const char *filePath, uint32_t hints, void **data, size_t *length, bool *isMapped);
+void LC_Win32_UnmapFile(void *data, size_t length, bool isMapped);
+bool LC_Win32_PinCurrentThread(uint32_t core);
 
 #endif //LIBRAC_WINDOWS_H
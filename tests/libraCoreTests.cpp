@@ -3,9 +3,16 @@
 #endif
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
 
 extern "C" {
 #include "../src/libraCore.h"
+#include "../src/libraVideo.h"
 }
 
 // =====================================Strings and String Operations================================================
@@ -83,6 +90,184 @@ TEST(Strings, LC_IsEqualString) {
     ASSERT_FALSE(shouldBeAlsoFalse);
 }
 
+TEST(Strings, LC_Bytes_KernelsMatchScalarAtEveryOffset) {
+    // Arrange
+    char buffer[300];
+    for (int32 i = 0; i < 299; i++) buffer[i] = (char) ('a' + i % 7);
+    buffer[299] = '\0';
+
+    for (size_t offset = 0; offset < 40; offset++) {
+        for (size_t length = 0; length + offset < 299; length += length < 70 ? 1 : 13) {
+            const char *data = buffer + offset;
+            size_t expectedCount = 0;
+            size_t expectedIndex = LC_NOT_FOUND;
+            size_t expectedSubstring = LC_NOT_FOUND;
+            for (size_t i = 0; i + 4 <= length && expectedSubstring == LC_NOT_FOUND; i++) {
+                if (memcmp(data + i, "fgab", 4) == 0) expectedSubstring = i;
+            }
+            for (size_t i = 0; i < length; i++) {
+                if (data[i] == 'g') {
+                    expectedCount++;
+                    if (expectedIndex == LC_NOT_FOUND) expectedIndex = i;
+                }
+            }
+
+            // Act
+            const size_t count = LC_Bytes_CountByte(data, length, 'g');
+            const size_t index = LC_Bytes_FindByte(data, length, 'g');
+            const size_t bounded = LC_CString_GetLengthBounded(data, length);
+            const size_t substring = LC_Bytes_Find(data, length, "fgab", 4);
+
+            // Assert
+            ASSERT_EQ(count, expectedCount) << offset << " " << length;
+            ASSERT_EQ(index, expectedIndex) << offset << " " << length;
+            ASSERT_EQ(bounded, length);
+            ASSERT_EQ(substring, expectedSubstring) << offset << " " << length;
+            if (offset + length + 7 < 299) ASSERT_TRUE(LC_Bytes_IsEqual(data, data + 7, length));
+            if (length > 0) ASSERT_FALSE(LC_Bytes_IsEqual(data, data + 1, length));
+        }
+        ASSERT_EQ(LC_CString_GetLength(buffer + offset), 299 - offset);
+    }
+}
+
+TEST(Strings, LC_String_FindAndCount) {
+    // Arrange
+    char text[] = "position 1.0 2.0; color 0.5 0.5 0.5; texture assets/textures/brick_wall.png; scale 2";
+    LC_String string;
+    LC_String_Initialize(&string, text);
+    char needleText[] = "brick_wall";
+    LC_String needle;
+    LC_String_Initialize(&needle, needleText);
+    char missingText[] = "brick_walls";
+    LC_String missing;
+    LC_String_Initialize(&missing, missingText);
+
+    // Act
+    const uint32 found = LC_String_Find(&string, &needle);
+    const uint32 notFound = LC_String_Find(&string, &missing);
+    const uint32 semicolon = LC_String_FindByte(&string, ';');
+    const uint32 semicolons = LC_String_CountByte(&string, ';');
+
+    // Assert
+    EXPECT_EQ(found, (uint32) (strstr(text, "brick_wall") - text));
+    EXPECT_EQ(notFound, LC_STRING_NOT_FOUND);
+    EXPECT_EQ(semicolon, 16u);
+    EXPECT_EQ(semicolons, 3u);
+    EXPECT_EQ(LC_GetStringLengthSkipSpaces(text, string.length), string.length - 10);
+    EXPECT_FALSE(LC_String_IsEqualCString(&string, "position"));
+}
+
+TEST(Strings, LC_StringSplitter_TokenizesWithoutCopying) {
+    // Arrange
+    char text[] = "  width = 1280 ,height=720,,vsync= true  ";
+    LC_String line;
+    LC_String_Initialize(&line, text);
+    LC_StringSplitter splitter;
+    LC_StringSplitter_Initialize(&splitter, &line, ',');
+    LC_String tokens[5];
+    uint32 tokenCount = 0;
+
+    // Act
+    LC_String token;
+    while (LC_StringSplitter_Next(&splitter, &token) && tokenCount < 5) {
+        tokens[tokenCount++] = LC_String_Trim(&token);
+    }
+    LC_String key, value;
+    const bool hasValue = LC_String_SplitOnce(&tokens[0], '=', &key, &value);
+    key = LC_String_Trim(&key);
+    value = LC_String_Trim(&value);
+
+    // Assert
+    ASSERT_EQ(tokenCount, 4u);
+    EXPECT_TRUE(LC_String_IsEqualCString(&tokens[1], "height=720"));
+    EXPECT_EQ(tokens[2].length, 0u);
+    EXPECT_TRUE(LC_String_IsEqualCString(&tokens[3], "vsync= true"));
+    ASSERT_TRUE(hasValue);
+    EXPECT_TRUE(LC_String_IsEqualCString(&key, "width"));
+    EXPECT_TRUE(LC_String_IsEqualCString(&value, "1280"));
+    EXPECT_GE(key.data, text);
+    EXPECT_LT(value.data, text + sizeof(text));
+
+    LC_String prefix = LC_STRING_LITERAL("vsync");
+    LC_String suffix = LC_STRING_LITERAL("true");
+    EXPECT_TRUE(LC_String_StartsWith(&tokens[3], &prefix));
+    EXPECT_TRUE(LC_String_EndsWith(&tokens[3], &suffix));
+    EXPECT_FALSE(LC_String_EndsWith(&prefix, &tokens[3]));
+    LC_String slice = LC_String_Slice(&line, 10, 1000);
+    EXPECT_EQ(slice.length, line.length - 10);
+}
+
+TEST(Strings, LC_String_ParsesNumbersWithoutTerminator) {
+    // Arrange
+    char text[] = "-42|0x7fffffff|9223372036854775808|2.5e-3|0.1|1e400|12abc|3.";
+    LC_String all;
+    LC_String_Initialize(&all, text);
+    LC_StringSplitter splitter;
+    LC_StringSplitter_Initialize(&splitter, &all, '|');
+    LC_String fields[8];
+    for (uint32 i = 0; i < 8; i++) LC_StringSplitter_Next(&splitter, &fields[i]);
+
+    // Act
+    int64 negative = 0, overflow = 0;
+    int32 hex = 0;
+    double small = 0, tenth = 0, huge = 0, trailingDot = 0;
+    float garbage = 0;
+    const bool parsedNegative = LC_String_ParseInt64(&fields[0], &negative);
+    const bool parsedHex = LC_String_ParseInt32(&fields[1], &hex);
+    const bool parsedOverflow = LC_String_ParseInt64(&fields[2], &overflow);
+    const bool parsedSmall = LC_String_ParseDouble(&fields[3], &small);
+    const bool parsedTenth = LC_String_ParseDouble(&fields[4], &tenth);
+    const bool parsedHuge = LC_String_ParseDouble(&fields[5], &huge);
+    const bool parsedGarbage = LC_String_ParseFloat(&fields[6], &garbage);
+    const bool parsedTrailingDot = LC_String_ParseDouble(&fields[7], &trailingDot);
+
+    // Assert
+    EXPECT_TRUE(parsedNegative);
+    EXPECT_EQ(negative, -42);
+    EXPECT_TRUE(parsedHex);
+    EXPECT_EQ(hex, 0x7fffffff);
+    EXPECT_FALSE(parsedOverflow);
+    EXPECT_TRUE(parsedSmall);
+    EXPECT_EQ(small, 2.5e-3);
+    EXPECT_TRUE(parsedTenth);
+    EXPECT_EQ(tenth, 0.1);
+    EXPECT_TRUE(parsedHuge);
+    EXPECT_TRUE(std::isinf(huge));
+    EXPECT_FALSE(parsedGarbage);
+    EXPECT_TRUE(parsedTrailingDot);
+    EXPECT_EQ(trailingDot, 3.0);
+}
+
+TEST(Strings, LC_StringBuilder_AppendsAndFormats) {
+    // Arrange
+    uchar buffer[4096];
+    LC_Arena arena;
+    LC_Arena_Initialize(&arena, buffer, sizeof(buffer));
+    LC_StringBuilder builder;
+    LC_StringBuilder_Initialize(&builder, &arena, 4);
+    LC_String name = LC_STRING_LITERAL("shader");
+
+    // Act
+    LC_StringBuilder_Append(&builder, &name);
+    LC_StringBuilder_AppendChar(&builder, '_');
+    for (int32 i = 0; i < 20; i++) {
+        LC_StringBuilder_AppendFormat(&builder, "%d:%.1f;", i, i * 0.5);
+    }
+    LC_StringBuilder_AppendCString(&builder, "end");
+    const LC_String result = LC_StringBuilder_ToString(&builder);
+
+    // Assert
+    EXPECT_EQ(result.length, (uint32) strlen(result.data));
+    EXPECT_EQ(strncmp(result.data, "shader_0:0.0;1:0.5;2:1.0;", 25), 0);
+    EXPECT_NE(strstr(result.data, "19:9.5;end"), nullptr);
+    // Every growth resized the arena's latest allocation in place
+    EXPECT_EQ(arena.currentOffset, (size_t) builder.capacity + 1);
+
+    LC_StringBuilder_Clear(&builder);
+    EXPECT_EQ(builder.length, 0u);
+    EXPECT_STREQ(builder.data, "");
+}
+
 // =====================================Utility Operations===========================================================
 TEST(Utility, LC_SwapValues) {
     // Arrange
@@ -99,3 +284,1703 @@ TEST(Utility, LC_SwapValues) {
     ASSERT_TRUE(success);
 }
 
+// =====================================Memory Allocations===========================================================
+TEST(Memory, LC_Arena_GrowableChainsBlocks) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 256));
+
+    // Act
+    auto *first = (int32 *)LC_Arena_Allocate(&arena, 200);
+    first[0] = 42;
+    auto *second = (int32 *)LC_Arena_Allocate(&arena, 200);
+    auto *large = (uchar *)LC_Arena_Allocate(&arena, 4096);
+    LC_ArenaStats stats;
+    LC_Arena_GetStats(&arena, &stats);
+    LC_ArenaBlockStats blockStats[8];
+    const uint32 blockCount = LC_Arena_GetBlockStats(&arena, blockStats, 8);
+
+    // Assert
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(large, nullptr);
+    ASSERT_EQ(first[0], 42);
+    ASSERT_EQ(stats.blockCount, 3);
+    ASSERT_EQ(blockCount, 3);
+    ASSERT_GE(blockStats[0].capacity, 4096);
+    ASSERT_EQ(blockStats[0].used, 4096);
+    ASSERT_EQ(stats.usedBytes, 200 + 200 + 4096);
+
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(Memory, LC_Arena_TemporaryMemoryAcrossBlocks) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Pages(), 128));
+    auto *kept = (uchar *)LC_Arena_Allocate(&arena, 64);
+    const size_t offsetBefore = arena.currentOffset;
+
+    // Act
+    const TemporaryArenaMemory temporary = LC_Arena_BeginTemporaryMemory(&arena);
+    for (int32 i = 0; i < 16; i++) {
+        ASSERT_NE(LC_Arena_Allocate(&arena, 100), nullptr);
+    }
+    const uint32 blocksDuring = arena.blockCount;
+    LC_Arena_EndTemporary(temporary);
+
+    // Assert
+    ASSERT_GT(blocksDuring, 1);
+    ASSERT_EQ(arena.blockCount, 1);
+    ASSERT_EQ(arena.currentOffset, offsetBefore);
+    ASSERT_EQ(arena.buffer, kept);
+
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(Memory, LC_Arena_FreeAllKeepsFirstBlock) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64));
+    for (int32 i = 0; i < 8; i++) LC_Arena_Allocate(&arena, 64);
+
+    // Act
+    LC_Arena_FreeAll(&arena);
+    LC_ArenaStats stats;
+    LC_Arena_GetStats(&arena, &stats);
+
+    // Assert
+    ASSERT_EQ(stats.blockCount, 1);
+    ASSERT_EQ(stats.usedBytes, 0);
+    ASSERT_EQ(stats.totalBlocksAllocated, 8);
+    ASSERT_NE(LC_Arena_Allocate(&arena, 64), nullptr);
+
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(Memory, LC_Arena_FixedArenaReturnsNullWhenFull) {
+    // Arrange
+    LC_Arena arena;
+    uchar buffer[128];
+    LC_Arena_Initialize(&arena, buffer, 128);
+
+    // Act
+    void *fits = LC_Arena_Allocate(&arena, 96);
+    void *doesNotFit = LC_Arena_Allocate(&arena, 96);
+
+    // Assert
+    ASSERT_NE(fits, nullptr);
+    ASSERT_EQ(doesNotFit, nullptr);
+}
+
+TEST(Memory, LC_Arena_VirtualCommitsOnDemand) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeVirtual(&arena, 64 * 1024 * 1024, 128 * 1024));
+    uchar *base = arena.buffer;
+
+    // Act
+    auto *small = (uchar *)LC_Arena_Allocate(&arena, 100);
+    LC_ArenaStats afterSmall;
+    LC_Arena_GetStats(&arena, &afterSmall);
+    auto *large = (uchar *)LC_Arena_Allocate(&arena, 8 * 1024 * 1024);
+    large[8 * 1024 * 1024 - 1] = 7;
+    LC_ArenaStats afterLarge;
+    LC_Arena_GetStats(&arena, &afterLarge);
+    LC_Arena_FreeAll(&arena);
+    LC_ArenaStats afterFree;
+    LC_Arena_GetStats(&arena, &afterFree);
+
+    // Assert
+    ASSERT_EQ(small, base);
+    ASSERT_GT(large, small);
+    ASSERT_EQ(afterSmall.reservedBytes, 64 * 1024 * 1024);
+    ASSERT_LT(afterSmall.committedBytes, 1024 * 1024);
+    ASSERT_GE(afterLarge.committedBytes, 8 * 1024 * 1024);
+    ASSERT_EQ(afterFree.committedBytes, 128 * 1024);
+    ASSERT_EQ(arena.buffer, base);
+
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(Memory, LC_Arena_ZeroOnResetClearsInBulk) {
+    // Arrange
+    LC_Arena arena;
+    uchar buffer[1024];
+    memset(buffer, 0xAB, sizeof(buffer));
+    LC_Arena_Initialize(&arena, buffer, 1024);
+    LC_Arena_SetZeroPolicy(&arena, LC_ARENA_ZERO_ON_RESET);
+
+    // Act
+    auto *first = (uchar *)LC_Arena_Allocate(&arena, 512);
+    const bool firstIsZero = first[0] == 0 && first[511] == 0;
+    memset(first, 0xCD, 512);
+    LC_Arena_FreeAll(&arena);
+    auto *second = (uchar *)LC_Arena_Allocate(&arena, 1024);
+
+    // A growable arena switched over with a second block chained, the first one has freed bytes past its offset
+    LC_Arena growable;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&growable, LC_ArenaBacking_Malloc(), 4096));
+    LC_Arena_AllocateNoZero(&growable, 1000);
+    auto *freed = (uchar *)LC_Arena_AllocateNoZero(&growable, 3000);
+    memset(freed, 0xCD, 3000);
+    LC_Arena_Free(&growable, freed);
+    LC_Arena_AllocateNoZero(&growable, 8000);
+    LC_Arena_SetZeroPolicy(&growable, LC_ARENA_ZERO_ON_RESET);
+    LC_Arena_FreeAll(&growable);
+    auto *reused = (uchar *)LC_Arena_Allocate(&growable, 3500);
+
+    // Assert
+    ASSERT_TRUE(firstIsZero);
+    ASSERT_EQ(second, first);
+    for (int32 i = 0; i < 1024; i++) {
+        ASSERT_EQ(second[i], 0);
+    }
+    for (int32 i = 0; i < 3500; i++) {
+        ASSERT_EQ(reused[i], 0);
+    }
+
+    LC_Arena_Destroy(&growable);
+}
+
+TEST(Memory, LC_Arena_ZeroOnResetClearsFreedAllocation) {
+    // Arrange
+    LC_Arena arena;
+    uchar buffer[256];
+    memset(buffer, 0xAB, sizeof(buffer));
+    LC_Arena_Initialize(&arena, buffer, 256);
+    LC_Arena_SetZeroPolicy(&arena, LC_ARENA_ZERO_ON_RESET);
+
+    // Act
+    auto *first = (uchar *)LC_Arena_Allocate(&arena, 128);
+    memset(first, 0xCD, 128);
+    LC_Arena_Free(&arena, first);
+    auto *second = (uchar *)LC_Arena_Allocate(&arena, 128);
+
+    // Assert
+    ASSERT_EQ(second, first);
+    for (int32 i = 0; i < 128; i++) {
+        ASSERT_EQ(second[i], 0);
+    }
+}
+
+TEST(Memory, LC_Arena_NoZeroLeavesContents) {
+    // Arrange
+    LC_Arena arena;
+    uchar buffer[256];
+    LC_Arena_Initialize(&arena, buffer, 256);
+    auto *memory = (uchar *)LC_Arena_Allocate(&arena, 64);
+    memset(memory, 0x5A, 64);
+    LC_Arena_FreeAll(&arena);
+
+    // Act
+    auto *reused = (uchar *)LC_Arena_AllocateNoZero(&arena, 32);
+    auto *grown = (uchar *)LC_Arena_Resize(&arena, reused, 32, 48);
+
+    // Assert
+    ASSERT_EQ(reused[0], 0x5A);
+    ASSERT_EQ(reused[31], 0x5A);
+    ASSERT_EQ(grown, reused);
+    ASSERT_EQ(grown[32], 0);
+    ASSERT_EQ(grown[47], 0);
+}
+
+TEST(Memory, LC_Pool_ReusesFreedSlots) {
+    // Arrange
+    LC_Pool pool;
+    alignas(16) uchar buffer[1024];
+    ASSERT_TRUE(LC_Pool_Initialize(&pool, buffer, 1024, 24, 8));
+
+    // Act
+    void *first = LC_Pool_Allocate(&pool);
+    void *second = LC_Pool_Allocate(&pool);
+    LC_Pool_Free(&pool, first);
+    void *third = LC_Pool_Allocate(&pool);
+
+    // Assert
+    ASSERT_NE(first, second);
+    ASSERT_EQ(third, first);
+    ASSERT_EQ(pool.allocatedSlots, 2);
+    ASSERT_EQ((uintptr_t)second % 8, 0);
+}
+
+TEST(Memory, LC_Pool_GrowsFromArenaAndResets) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 4096));
+    LC_Pool pool;
+    LC_Pool_InitializeFromArena(&pool, &arena, 48, 16, 8);
+
+    // Act
+    void *slots[20];
+    for (auto &slot : slots) slot = LC_Pool_Allocate(&pool);
+    const uint32 chunksBeforeReset = pool.chunkCount;
+    LC_Pool_FreeAll(&pool);
+    void *afterReset = LC_Pool_Allocate(&pool);
+
+    // Assert
+    for (auto *slot : slots) {
+        ASSERT_NE(slot, nullptr);
+        ASSERT_EQ((uintptr_t)slot % 16, 0);
+    }
+    ASSERT_EQ(chunksBeforeReset, 3);
+    ASSERT_EQ(pool.chunkCount, 3);
+    ASSERT_EQ(afterReset, slots[0]);
+
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(Memory, LC_Pool_DetectsDoubleFree) {
+    // Arrange
+    LC_Pool pool;
+    alignas(16) uchar buffer[512];
+    ASSERT_TRUE(LC_Pool_Initialize(&pool, buffer, 512, 32, 16));
+    LC_Pool_SetDebugChecks(&pool, true);
+    void *slot = LC_Pool_Allocate(&pool);
+
+    // Act
+    const bool firstFree = LC_Pool_Free(&pool, slot);
+    const bool secondFree = LC_Pool_Free(&pool, slot);
+
+    // Assert
+    ASSERT_TRUE(firstFree);
+    ASSERT_FALSE(secondFree);
+    ASSERT_EQ(pool.allocatedSlots, 0);
+}
+
+TEST(Memory, LC_Heap_AllocateFreeCoalesces) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024));
+    LC_Heap heap;
+    ASSERT_TRUE(LC_Heap_Initialize(&heap, &arena, 64 * 1024));
+
+    // Act
+    auto *a = (uchar *)LC_Heap_Allocate(&heap, 100);
+    auto *b = (uchar *)LC_Heap_Allocate(&heap, 2000);
+    auto *c = (uchar *)LC_Heap_AllocateAndAlign(&heap, 300, 256);
+    LC_HeapStats inUse;
+    LC_Heap_GetStats(&heap, &inUse);
+    LC_Heap_Free(&heap, b);
+    LC_Heap_Free(&heap, a);
+    LC_Heap_Free(&heap, c);
+    LC_HeapStats released;
+    LC_Heap_GetStats(&heap, &released);
+
+    // Assert
+    ASSERT_EQ((uintptr_t)a % DEFAULT_ALIGNMENT, 0);
+    ASSERT_EQ((uintptr_t)c % 256, 0);
+    ASSERT_GE(LC_Heap_GetAllocationSize(b), 2000);
+    ASSERT_EQ(inUse.usedBlockCount, 3);
+    ASSERT_EQ(released.usedBytes, 0);
+    ASSERT_EQ(released.freeBlockCount, 1);
+    ASSERT_EQ(released.freeBytes, released.totalBytes);
+    ASSERT_EQ(released.largestFreeBlock, released.totalBytes);
+    ASSERT_FLOAT_EQ(released.fragmentation, 0.0f);
+
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(Memory, LC_Heap_ResizeKeepsContents) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024));
+    LC_Heap heap;
+    ASSERT_TRUE(LC_Heap_Initialize(&heap, &arena, 32 * 1024));
+    auto *numbers = (int32 *)LC_Heap_Allocate(&heap, 16 * sizeof(int32));
+    for (int32 i = 0; i < 16; i++) numbers[i] = i;
+    auto *blocker = LC_Heap_Allocate(&heap, 64);
+
+    // Act
+    auto *grown = (int32 *)LC_Heap_Resize(&heap, numbers, 1024 * sizeof(int32));
+    auto *shrunk = (int32 *)LC_Heap_Resize(&heap, grown, 8 * sizeof(int32));
+
+    // Assert
+    ASSERT_NE(grown, numbers);
+    ASSERT_EQ(shrunk, grown);
+    for (int32 i = 0; i < 8; i++) ASSERT_EQ(shrunk[i], i);
+    ASSERT_EQ(grown[1023], 0);
+
+    LC_Heap_Free(&heap, blocker);
+    LC_Heap_Free(&heap, shrunk);
+    LC_HeapStats stats;
+    LC_Heap_GetStats(&heap, &stats);
+    ASSERT_EQ(stats.usedBlockCount, 0);
+    ASSERT_EQ(stats.freeBlockCount, stats.regionCount);
+
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(Memory, LC_Heap_ResizeZeroesSlackOfReusedBlock) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024));
+    LC_Heap heap;
+    ASSERT_TRUE(LC_Heap_Initialize(&heap, &arena, 32 * 1024));
+    auto *dirty = (uchar *)LC_Heap_AllocateNoZero(&heap, 32);
+    memset(dirty, 0xAB, 32);
+    auto *guard = LC_Heap_Allocate(&heap, 64);
+    LC_Heap_Free(&heap, dirty);
+
+    // Act
+    auto *reused = (uchar *)LC_Heap_Allocate(&heap, 10);
+    auto *grown = (uchar *)LC_Heap_Resize(&heap, reused, 40);
+    bool isGrownZero = true;
+    for (int32 i = 10; i < 40; i++) isGrownZero &= grown[i] == 0;
+    memset(grown, 0xCD, 40);
+    auto *shrunk = (uchar *)LC_Heap_Resize(&heap, grown, 4);
+    auto *regrown = (uchar *)LC_Heap_Resize(&heap, shrunk, 40);
+
+    // Assert
+    ASSERT_EQ(reused, dirty);
+    ASSERT_TRUE(isGrownZero);
+    for (int32 i = 4; i < 40; i++) ASSERT_EQ(regrown[i], 0);
+
+    LC_Heap_Free(&heap, guard);
+    LC_Heap_Free(&heap, regrown);
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(Memory, LC_Heap_RandomizedAllocationsReturnAllMemory) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 1024 * 1024));
+    LC_Heap heap;
+    ASSERT_TRUE(LC_Heap_Initialize(&heap, &arena, 256 * 1024));
+    constexpr int32 slotCount = 256;
+    void *slots[slotCount] = {};
+    size_t sizes[slotCount] = {};
+    uint32 state = 12345;
+
+    // Act
+    for (int32 iteration = 0; iteration < 20000; iteration++) {
+        state = state * 1664525u + 1013904223u;
+        const int32 index = (int32)((state >> 8) % slotCount);
+        if (slots[index] == nullptr) {
+            sizes[index] = 1 + (state >> 16) % 5000;
+            slots[index] = LC_Heap_AllocateNoZero(&heap, sizes[index]);
+            ASSERT_NE(slots[index], nullptr);
+            memset(slots[index], index & 0xFF, sizes[index]);
+        } else {
+            ASSERT_EQ(((uchar *)slots[index])[sizes[index] - 1], index & 0xFF);
+            LC_Heap_Free(&heap, slots[index]);
+            slots[index] = nullptr;
+        }
+    }
+    for (auto *slot : slots) LC_Heap_Free(&heap, slot);
+    LC_HeapStats stats;
+    LC_Heap_GetStats(&heap, &stats);
+
+    // Assert
+    ASSERT_EQ(stats.usedBytes, 0);
+    ASSERT_EQ(stats.freeBlockCount, stats.regionCount);
+    ASSERT_EQ(stats.freeBytes, stats.totalBytes);
+
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(Memory, LC_Scratch_AvoidsConflictingArenas) {
+    // Arrange
+    const TemporaryArenaMemory outer = LC_Scratch_Begin(nullptr, 0);
+    auto *outerMemory = (int32 *)LC_Arena_Allocate(outer.arena, sizeof(int32) * 4);
+    outerMemory[0] = 99;
+
+    // Act
+    const TemporaryArenaMemory inner = LC_Scratch_Begin((LC_Arena **)&outer.arena, 1);
+    auto *innerMemory = (int32 *)LC_Arena_Allocate(inner.arena, sizeof(int32) * 4);
+    innerMemory[0] = 7;
+    LC_Scratch_End(inner);
+    const size_t offsetBeforeEnd = outer.arena->currentOffset;
+    LC_Scratch_End(outer);
+
+    // Assert
+    ASSERT_NE(inner.arena, outer.arena);
+    ASSERT_EQ(outerMemory[0], 99);
+    ASSERT_GT(offsetBeforeEnd, outer.currentOffset);
+    ASSERT_EQ(outer.arena->currentOffset, outer.currentOffset);
+}
+
+TEST(Memory, LC_Scratch_IsPerThread) {
+    // Arrange
+    const TemporaryArenaMemory mainScratch = LC_Scratch_Begin(nullptr, 0);
+    LC_Arena *workerArena = nullptr;
+
+    // Act
+    std::thread worker([&workerArena]() {
+        const TemporaryArenaMemory scratch = LC_Scratch_Begin(nullptr, 0);
+        workerArena = scratch.arena;
+        ASSERT_NE(LC_Arena_Allocate(scratch.arena, 1024), nullptr);
+        LC_Scratch_End(scratch);
+        LC_Scratch_ReleaseThreadArenas();
+    });
+    worker.join();
+    LC_Scratch_End(mainScratch);
+
+    // Assert
+    ASSERT_NE(workerArena, nullptr);
+    ASSERT_NE(workerArena, mainScratch.arena);
+}
+
+TEST(Memory, LC_Allocator_TrackingCountsThroughParent) {
+    // Arrange
+    LC_TrackingAllocator tracking;
+    const LC_Allocator allocator = LC_Allocator_Tracking(&tracking, LC_Allocator_Malloc(), "test");
+
+    // Act
+    auto *memory = (uchar *)LC_Allocator_Allocate(&allocator, 64, DEFAULT_ALIGNMENT);
+    memory = (uchar *)LC_Allocator_Resize(&allocator, memory, 64, 256, DEFAULT_ALIGNMENT);
+    const uchar grownTail = memory[255];
+    const size_t peak = tracking.peakBytes;
+    LC_Allocator_Free(&allocator, memory, 256);
+
+    // Assert
+    ASSERT_EQ(grownTail, 0);
+    ASSERT_EQ(peak, 256);
+    ASSERT_EQ(tracking.currentBytes, 0);
+    ASSERT_EQ(tracking.allocationCount, 1);
+    ASSERT_EQ(tracking.freeCount, 1);
+}
+
+// =====================================File Operations==============================================================
+TEST(Files, LC_File_MapReturnsContentsAndLoadersCopyThem) {
+    // Arrange
+    const char *path = "libraCoreTests_map.tmp";
+    std::string contents;
+    for (int32 i = 0; i < 10000; i++) contents += "line " + std::to_string(i) + "\n";
+    FILE *file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+    uchar buffer[256 * 1024];
+    LC_Arena arena;
+    LC_Arena_Initialize(&arena, buffer, sizeof(buffer));
+    char errorLog[1024];
+
+    // Act
+    LC_FileView view;
+    const bool mapped = LC_File_Map(&view, path, LC_FILE_HINT_SEQUENTIAL | LC_FILE_HINT_WILL_NEED, errorLog);
+    char *text = nullptr;
+    LC_GetFileContentString(&arena, path, &text);
+    uchar *bytes = nullptr;
+    size_t byteCount = 0;
+    const bool loaded = LC_GetFileContentBinary(&arena, path, &bytes, &byteCount, errorLog);
+    LC_FileView missing;
+    const bool mappedMissing = LC_File_Map(&missing, "does/not/exist.txt", LC_FILE_HINT_NONE, errorLog);
+
+    // Assert
+    ASSERT_TRUE(mapped);
+    ASSERT_EQ(view.length, contents.size());
+    EXPECT_EQ(memcmp(view.data, contents.data(), view.length), 0);
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(std::string(text), contents);
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(byteCount, contents.size());
+    EXPECT_EQ(memcmp(bytes, contents.data(), byteCount), 0);
+    EXPECT_FALSE(mappedMissing);
+    EXPECT_EQ(missing.data, nullptr);
+
+    LC_File_Unmap(&view);
+    EXPECT_EQ(view.data, nullptr);
+    remove(path);
+}
+
+TEST(Files, LC_File_MapHandlesEmptyAndUnmappableFiles) {
+    // Arrange
+    const char *path = "libraCoreTests_empty.tmp";
+    FILE *file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    fclose(file);
+    char errorLog[1024];
+
+    // Act
+    LC_FileView empty;
+    const bool mappedEmpty = LC_File_Map(&empty, path, LC_FILE_HINT_NONE, errorLog);
+
+    // Assert
+    EXPECT_TRUE(mappedEmpty);
+    EXPECT_EQ(empty.length, 0u);
+    LC_File_Unmap(&empty);
+    remove(path);
+
+#ifdef __linux__
+    // /proc files claim a size of zero and can't be mapped, they take the read() fallback
+    LC_FileView status;
+    ASSERT_TRUE(LC_File_Map(&status, "/proc/self/status", LC_FILE_HINT_SEQUENTIAL, errorLog));
+    EXPECT_GT(status.length, 0u);
+    EXPECT_EQ(memcmp(status.data, "Name:", 5), 0);
+    LC_File_Unmap(&status);
+#endif
+}
+
+TEST(Files, LC_FileLoader_LoadsBatchesWithEitherBackend) {
+    for (const LC_FileLoaderBackend backend : {LC_FILE_LOADER_BACKEND_DEFAULT, LC_FILE_LOADER_BACKEND_THREADS}) {
+        // Arrange
+        constexpr uint32 fileCount = 200;
+        std::vector<std::string> paths;
+        std::vector<std::string> contents;
+        for (uint32 i = 0; i < fileCount; i++) {
+            paths.push_back("libraCoreTests_async_" + std::to_string(i) + ".tmp");
+            // Every tenth file is empty
+            contents.push_back(std::string(i % 10 == 0 ? 0 : 100 + i * 37, (char) ('a' + i % 26)));
+            FILE *file = fopen(paths[i].c_str(), "wb");
+            ASSERT_NE(file, nullptr);
+            fwrite(contents[i].data(), 1, contents[i].size(), file);
+            fclose(file);
+        }
+        paths.push_back("does/not/exist.txt");
+        std::vector<const char *> pathPointers;
+        for (const std::string &path : paths) pathPointers.push_back(path.c_str());
+        LC_Arena arena;
+        ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024));
+        LC_FileLoader loader;
+        ASSERT_TRUE(LC_FileLoader_Initialize(&loader, backend, 4));
+        uint32 callbackCount = 0;
+        const LC_FileLoadedFunction onLoaded = [](LC_FileRequest *request, void *userData) {
+            (void)request;
+            (*(uint32 *) userData)++;
+        };
+
+        // Act
+        LC_FileBatch batch;
+        const bool submitted = LC_FileLoader_Submit(&loader, &batch, &arena, pathPointers.data(),
+                                                    (uint32) pathPointers.size(), onLoaded, &callbackCount);
+        LC_FileLoader_Wait(&loader, &batch);
+
+        // Assert
+        ASSERT_TRUE(submitted);
+        EXPECT_TRUE(LC_FileBatch_IsDone(&batch));
+        EXPECT_EQ(callbackCount, fileCount + 1);
+        EXPECT_EQ(batch.failedCount, 1u);
+        for (uint32 i = 0; i < fileCount; i++) {
+            ASSERT_EQ(batch.requests[i].status, LC_FILE_REQUEST_LOADED);
+            ASSERT_EQ(batch.requests[i].length, contents[i].size());
+            EXPECT_EQ(std::string((const char *) batch.requests[i].data), contents[i]);
+        }
+        EXPECT_EQ(batch.requests[fileCount].status, LC_FILE_REQUEST_FAILED);
+
+        LC_FileLoader_Destroy(&loader);
+        LC_Arena_Destroy(&arena);
+        for (uint32 i = 0; i < fileCount; i++) remove(paths[i].c_str());
+    }
+}
+
+TEST(Files, LC_FileLoader_CanBePolledAndLoadAllWaits) {
+    // Arrange
+    const char *paths[2] = {"libraCoreTests_poll_a.tmp", "libraCoreTests_poll_b.tmp"};
+    std::string large(3 * 1024 * 1024 + 5, 'x');
+    large[large.size() - 1] = 'y';
+    FILE *file = fopen(paths[0], "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite(large.data(), 1, large.size(), file);
+    fclose(file);
+    file = fopen(paths[1], "wb");
+    ASSERT_NE(file, nullptr);
+    fputs("#version 330 core", file);
+    fclose(file);
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024));
+    LC_FileLoader loader;
+    ASSERT_TRUE(LC_FileLoader_Initialize(&loader, LC_FILE_LOADER_BACKEND_DEFAULT, 0));
+
+    // Act
+    LC_FileBatch polled;
+    ASSERT_TRUE(LC_FileLoader_Submit(&loader, &polled, &arena, paths, 2, nullptr, nullptr));
+    uint32 finishedCount = 0;
+    while (!LC_FileBatch_IsDone(&polled)) {
+        finishedCount += LC_FileLoader_Poll(&loader);
+        std::this_thread::yield();
+    }
+    LC_FileLoader_Destroy(&loader);
+    LC_FileBatch waited;
+    const bool loadedAll = LC_File_LoadAll(&arena, paths, 2, &waited);
+    LC_FileBatch empty;
+    const bool loadedNothing = LC_File_LoadAll(&arena, paths, 0, &empty);
+
+    // Assert
+    EXPECT_EQ(finishedCount, 2u);
+    ASSERT_EQ(polled.requests[0].length, large.size());
+    EXPECT_EQ(memcmp(polled.requests[0].data, large.data(), large.size()), 0);
+    EXPECT_STREQ((const char *) polled.requests[1].data, "#version 330 core");
+    ASSERT_TRUE(loadedAll);
+    EXPECT_EQ(waited.failedCount, 0u);
+    EXPECT_EQ(waited.requests[0].length, large.size());
+    EXPECT_STREQ((const char *) waited.requests[1].data, "#version 330 core");
+    EXPECT_TRUE(loadedNothing);
+    EXPECT_EQ(empty.count, 0u);
+    EXPECT_TRUE(LC_FileBatch_IsDone(&empty));
+
+    LC_Arena_Destroy(&arena);
+    remove(paths[0]);
+    remove(paths[1]);
+}
+
+TEST(Files, LC_FileStream_ReadsFileInChunks) {
+    // Arrange
+    const char *path = "libraCoreTests_stream.tmp";
+    std::string contents;
+    for (int32 i = 0; contents.size() < 1000003; i++) contents += "log line " + std::to_string(i) + "\n";
+    contents.resize(1000003);
+    FILE *file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024));
+    char errorLog[1024];
+
+    // Act
+    LC_FileStream stream;
+    const bool opened = LC_FileStream_Open(&stream, &arena, path, 64 * 1024, errorLog);
+    std::string streamed;
+    uint32 chunkCount = 0;
+    bool offsetsMatch = true;
+    const uchar *chunk;
+    size_t length;
+    while (LC_FileStream_Next(&stream, &chunk, &length)) {
+        offsetsMatch &= stream.offset == streamed.size();
+        streamed.append((const char *) chunk, length);
+        chunkCount++;
+    }
+
+    // Assert
+    ASSERT_TRUE(opened);
+    EXPECT_EQ(stream.fileSize, contents.size());
+    EXPECT_FALSE(stream.hasFailed);
+    EXPECT_EQ(chunkCount, 16u);
+    EXPECT_TRUE(offsetsMatch);
+    EXPECT_EQ(streamed, contents);
+
+    LC_FileStream_Close(&stream);
+    LC_Arena_Destroy(&arena);
+    remove(path);
+}
+
+TEST(Files, LC_FileStream_HandlesEmptyAndMissingFiles) {
+    // Arrange
+    const char *path = "libraCoreTests_stream_empty.tmp";
+    const char *partialPath = "libraCoreTests_stream_partial.tmp";
+    FILE *file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    fclose(file);
+    file = fopen(partialPath, "wb");
+    ASSERT_NE(file, nullptr);
+    for (int32 i = 0; i < 1000; i++) fputc('a' + i % 26, file);
+    fclose(file);
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024));
+    char errorLog[1024];
+    const uchar *chunk;
+    size_t length;
+
+    // Act
+    LC_FileStream empty;
+    const bool openedEmpty = LC_FileStream_Open(&empty, &arena, path, 0, errorLog);
+    const bool hasChunk = LC_FileStream_Next(&empty, &chunk, &length);
+    // Closing in the middle of a file stops the read-ahead thread
+    LC_FileStream partial;
+    const bool openedPartial = LC_FileStream_Open(&partial, &arena, partialPath, 16, errorLog);
+    const bool hasPartialChunk = LC_FileStream_Next(&partial, &chunk, &length);
+    LC_FileStream_Close(&partial);
+    LC_FileStream missing;
+    const bool openedMissing = LC_FileStream_Open(&missing, &arena, "does/not/exist.txt", 0, errorLog);
+
+    // Assert
+    ASSERT_TRUE(openedEmpty);
+    EXPECT_EQ(empty.chunkSize, (size_t) LC_FILE_STREAM_DEFAULT_CHUNK_SIZE);
+    EXPECT_FALSE(hasChunk);
+    EXPECT_FALSE(empty.hasFailed);
+    ASSERT_TRUE(openedPartial);
+    EXPECT_TRUE(hasPartialChunk);
+    EXPECT_EQ(length, 16u);
+    EXPECT_FALSE(openedMissing);
+
+    LC_FileStream_Close(&empty);
+    LC_Arena_Destroy(&arena);
+    remove(path);
+    remove(partialPath);
+}
+
+// =====================================Hashing======================================================================
+TEST(Hashing, LC_Hash_IsDeterministicAndSeeded) {
+    // Arrange
+    const char *text = "the quick brown fox jumps over the lazy dog";
+    LC_String string;
+    LC_String_Initialize(&string, (char *) text);
+
+    // Act
+    const uint64 hash = LC_Hash_Bytes64(text, strlen(text), 0);
+    const LC_Hash128 wideHash = LC_Hash_String128(&string, 0);
+
+    // Assert
+    EXPECT_EQ(hash, LC_Hash_String64(&string, 0));
+    EXPECT_NE(hash, LC_Hash_Bytes64(text, strlen(text), 1));
+    EXPECT_NE(hash, LC_Hash_Bytes64(text, strlen(text) - 1, 0));
+    EXPECT_EQ(wideHash.low, hash);
+    EXPECT_NE(wideHash.low, wideHash.high);
+    EXPECT_TRUE(LC_Hash_IsEqual128(wideHash, LC_Hash_Bytes128(text, strlen(text), 0)));
+}
+
+TEST(Hashing, LC_HashStream_MatchesOneShot) {
+    // Arrange
+    uchar data[1000];
+    for (int32 i = 0; i < 1000; i++) data[i] = (uchar) (i * 131 + 7);
+    const size_t lengths[] = {0, 3, 16, 17, 47, 48, 49, 96, 97, 1000};
+    const size_t pieceSizes[] = {1, 5, 16, 48, 61, 1000};
+
+    for (const size_t length : lengths) {
+        for (const size_t pieceSize : pieceSizes) {
+            // Act
+            LC_HashStream stream;
+            LC_HashStream_Initialize(&stream, 42, true);
+            for (size_t offset = 0; offset < length; offset += pieceSize) {
+                LC_HashStream_Update(&stream, data + offset, length - offset < pieceSize ? length - offset : pieceSize);
+            }
+
+            // Assert
+            EXPECT_EQ(LC_HashStream_Finish64(&stream), LC_Hash_Bytes64(data, length, 42))
+                << "length " << length << " piece " << pieceSize;
+            EXPECT_TRUE(LC_Hash_IsEqual128(LC_HashStream_Finish128(&stream), LC_Hash_Bytes128(data, length, 42)));
+        }
+    }
+}
+
+TEST(Hashing, LC_Hash_BatchMatchesScalar) {
+    // Arrange
+    uint64 keys64[37];
+    uint32 keys32[37];
+    uint64 hashes64[37];
+    uint64 hashes32[37];
+    for (uint32 i = 0; i < 37; i++) {
+        keys64[i] = 0x9E3779B97F4A7C15ull * (i + 1);
+        keys32[i] = i * 2654435761u;
+    }
+    char text[] = "alpha\0beta\0gamma\0delta\0epsilon";
+    LC_String strings[5];
+    for (uint32 i = 0, offset = 0; i < 5; i++) {
+        LC_String_Initialize(&strings[i], text + offset);
+        offset += strings[i].length + 1;
+    }
+    uint64 stringHashes[5];
+
+    // Act
+    LC_Hash_BatchU64(keys64, hashes64, 37, 99);
+    LC_Hash_BatchU32(keys32, hashes32, 37, 99);
+    LC_Hash_BatchStrings(strings, stringHashes, 5, 99);
+
+    // Assert
+    for (uint32 i = 0; i < 37; i++) {
+        EXPECT_EQ(hashes64[i], LC_Hash_U64(keys64[i], 99));
+        EXPECT_EQ(hashes32[i], LC_Hash_U64(keys32[i], 99));
+    }
+    for (uint32 i = 0; i < 5; i++) {
+        EXPECT_EQ(stringHashes[i], LC_Hash_String64(&strings[i], 99));
+    }
+}
+
+// =====================================Data Structures==============================================================
+TEST(DataStructures, LC_List_GrowsInArena) {
+    // Arrange
+    LC_Arena arena;
+    uchar buffer[64 * 1024];
+    LC_Arena_Initialize(&arena, buffer, sizeof(buffer));
+    LC_List list;
+    LC_List_InitializeWithAllocator(&list, sizeof(int32), LC_Allocator_FromArena(&arena));
+
+    // Act
+    for (int32 i = 0; i < 1000; i++) {
+        LC_List_AddElement(&list, &i);
+    }
+
+    // Assert
+    ASSERT_EQ(LC_List_GetLength(&list), 1000);
+    ASSERT_EQ(*(int32 *)LC_List_GetElement(&list, 999), 999);
+    ASSERT_EQ(LC_List_GetElement(&list, 1000), nullptr);
+    ASSERT_GE((uchar *)LC_List_GetData(&list), buffer);
+    ASSERT_LT((uchar *)LC_List_GetData(&list), buffer + sizeof(buffer));
+
+    LC_List_Destroy(&list);
+}
+
+TEST(DataStructures, LC_List_DefaultsToMalloc) {
+    // Arrange
+    LC_List list;
+    LC_List_Initialize(&list, sizeof(double));
+
+    // Act
+    for (int32 i = 0; i < 100; i++) {
+        const double value = i * 0.5;
+        LC_List_AddElement(&list, &value);
+    }
+
+    // Assert
+    ASSERT_EQ(LC_List_GetLength(&list), 100);
+    ASSERT_DOUBLE_EQ(*(double *)LC_List_GetElement(&list, 99), 49.5);
+
+    LC_List_Destroy(&list);
+}
+
+LC_DEFINE_LIST(int32)
+
+TEST(DataStructures, LC_DefineList_InsertRemoveAndShrink) {
+    // Arrange
+    LC_List_int32 list;
+    LC_List_int32_Initialize(&list, LC_Allocator_Malloc());
+    const int32 values[] = {1, 2, 3, 4, 5};
+
+    // Act
+    LC_List_int32_AppendN(&list, values, 5);
+    LC_List_int32_Insert(&list, 0, 0);
+    LC_List_int32_Remove(&list, 3);
+    LC_List_int32_SwapRemove(&list, 1);
+    LC_List_int32_Append(&list, 9);
+    LC_List_int32_ShrinkToFit(&list);
+
+    // Assert
+    ASSERT_EQ(list.length, 5);
+    ASSERT_EQ(list.capacity, 5);
+    const int32 expected[] = {0, 5, 2, 4, 9};
+    for (uint32 i = 0; i < 5; i++) ASSERT_EQ(list.data[i], expected[i]);
+    ASSERT_EQ(LC_List_int32_Get(&list, 5), nullptr);
+
+    LC_List_int32_Clear(&list);
+    ASSERT_EQ(list.length, 0);
+    ASSERT_NE(list.data, nullptr);
+    LC_List_int32_Destroy(&list);
+}
+
+TEST(DataStructures, LC_DefineList_ReserveAvoidsGrowth) {
+    // Arrange
+    LC_TrackingAllocator tracking;
+    LC_List_int32 list;
+    LC_List_int32_Initialize(&list, LC_Allocator_Tracking(&tracking, LC_Allocator_Malloc(), "list"));
+
+    // Act
+    LC_List_int32_Reserve(&list, 1000);
+    int32 *data = list.data;
+    for (int32 i = 0; i < 1000; i++) LC_List_int32_Append(&list, i);
+
+    // Assert
+    ASSERT_EQ(list.data, data);
+    ASSERT_EQ(tracking.peakBytes, 1000 * sizeof(int32));
+    ASSERT_EQ(list.data[999], 999);
+
+    LC_List_int32_Destroy(&list);
+    ASSERT_EQ(tracking.currentBytes, 0);
+}
+
+TEST(DataStructures, LC_HashMap_IntegerKeys) {
+    // Arrange
+    LC_HashMap map;
+    LC_HashMap_Initialize(&map, LC_HashMapKey_Int32(), sizeof(int32), LC_Allocator_Malloc());
+
+    // Act
+    for (int32 i = 0; i < 10000; i++) {
+        const int32 value = i * 3;
+        ASSERT_NE(LC_HashMap_Insert(&map, &i, &value), nullptr);
+    }
+    for (int32 i = 0; i < 10000; i += 2) {
+        ASSERT_TRUE(LC_HashMap_Remove(&map, &i));
+    }
+
+    // Assert
+    ASSERT_EQ(LC_HashMap_GetLength(&map), 5000);
+    for (int32 i = 0; i < 10000; i++) {
+        auto *value = (int32 *)LC_HashMap_Get(&map, &i);
+        if (i % 2 == 0) {
+            ASSERT_EQ(value, nullptr);
+        } else {
+            ASSERT_NE(value, nullptr);
+            ASSERT_EQ(*value, i * 3);
+        }
+    }
+    uint32 iterator = 0;
+    uint32 visited = 0;
+    void *key;
+    void *value;
+    while (LC_HashMap_Next(&map, &iterator, &key, &value)) {
+        ASSERT_EQ(*(int32 *)value, *(int32 *)key * 3);
+        visited++;
+    }
+    ASSERT_EQ(visited, 5000);
+
+    LC_HashMap_Destroy(&map);
+}
+
+TEST(DataStructures, LC_HashMap_StringKeysInArena) {
+    // Arrange
+    LC_Arena arena;
+    ASSERT_TRUE(LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024));
+    LC_HashMap map;
+    LC_HashMap_Initialize(&map, LC_HashMapKey_String(), sizeof(uint32), LC_Allocator_FromArena(&arena));
+    char names[][16] = {"projection", "view", "model", "color", "fontAtlas"};
+    LC_String keys[5];
+
+    // Act
+    for (uint32 i = 0; i < 5; i++) {
+        LC_String_Initialize(&keys[i], names[i]);
+        LC_HashMap_Insert(&map, &keys[i], &i);
+    }
+    char lookupName[] = "model";
+    LC_String lookup;
+    LC_String_Initialize(&lookup, lookupName);
+    const uint32 replaced = 42;
+    LC_HashMap_Insert(&map, &keys[0], &replaced);
+
+    // Assert
+    ASSERT_EQ(LC_HashMap_GetLength(&map), 5);
+    ASSERT_EQ(*(uint32 *)LC_HashMap_Get(&map, &lookup), 2);
+    ASSERT_EQ(*(uint32 *)LC_HashMap_Get(&map, &keys[0]), 42);
+    const char *cStringKey = "view";
+    LC_HashMap cStringMap;
+    LC_HashMap_Initialize(&cStringMap, LC_HashMapKey_CString(), sizeof(int64), LC_Allocator_FromArena(&arena));
+    const char *insertedKey = names[1];
+    LC_HashMap_Insert(&cStringMap, &insertedKey, nullptr);
+    ASSERT_TRUE(LC_HashMap_Contains(&cStringMap, &cStringKey));
+    ASSERT_EQ(*(int64 *)LC_HashMap_Get(&cStringMap, &cStringKey), 0);
+
+    LC_Arena_Destroy(&arena);
+}
+
+// Three home slots next to each other, so the keys pile up into one cluster that no table size spreads out
+static uint64 ClusteredHash(const void *key) {
+    return (uint64) (*(const int32 *) key % 3);
+}
+
+static bool IsEqualInt32(const void *a, const void *b) {
+    return *(const int32 *) a == *(const int32 *) b;
+}
+
+TEST(DataStructures, LC_HashMap_FailedInsertKeepsEntries) {
+    // Arrange
+    LC_HashMapKeyType keyType;
+    keyType.hash = ClusteredHash;
+    keyType.isEqual = IsEqualInt32;
+    keyType.keySize = sizeof(int32);
+    LC_HashMap map;
+    LC_HashMap_Initialize(&map, keyType, sizeof(int32), LC_Allocator_Malloc());
+
+    // Act
+    // Inserts keep failing once the cluster is full, the ones that move residents out of their slots first included
+    std::vector<bool> isInserted(1000);
+    uint32 insertedCount = 0;
+    for (int32 i = 0; i < 1000; i++) {
+        const int32 value = i * 7;
+        isInserted[i] = LC_HashMap_Insert(&map, &i, &value) != nullptr;
+        insertedCount += isInserted[i];
+    }
+    const bool isHugeReserved = LC_HashMap_Reserve(&map, 4000000000u);
+
+    // Assert
+    ASSERT_LT(insertedCount, 1000u);
+    EXPECT_EQ(LC_HashMap_GetLength(&map), insertedCount);
+    EXPECT_FALSE(isHugeReserved);
+    for (int32 i = 0; i < 1000; i++) {
+        auto *value = (int32 *)LC_HashMap_Get(&map, &i);
+        if (!isInserted[i]) {
+            ASSERT_EQ(value, nullptr);
+            continue;
+        }
+        ASSERT_NE(value, nullptr);
+        ASSERT_EQ(*value, i * 7);
+    }
+
+    LC_HashMap_Destroy(&map);
+}
+
+TEST(DataStructures, LC_StringInterner_ReturnsStableDenseIds) {
+    // Arrange
+    LC_Arena arena;
+    LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 4096);
+    LC_StringInterner interner;
+    LC_StringInterner_Initialize(&interner, &arena, false);
+    char first[] = "viewProjectionMatrix";
+    char second[] = "viewProjectionMatrix";
+    LC_String view = LC_STRING_LITERAL("model|aColor");
+    const LC_String model = LC_String_Slice(&view, 0, 5);
+
+    // Act
+    const uint32 firstId = LC_StringInterner_InternCString(&interner, first);
+    const uint32 modelId = LC_StringInterner_Intern(&interner, &model);
+    const uint32 secondId = LC_StringInterner_InternCString(&interner, second);
+    LC_String missing = LC_STRING_LITERAL("aColor");
+    const uint32 missingId = LC_StringInterner_Find(&interner, &missing);
+    uint32 lastId = 0;
+    for (int32 i = 0; i < 3000; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "asset_%d", i);
+        lastId = LC_StringInterner_InternCString(&interner, name);
+    }
+    first[0] = 'X';
+
+    // Assert
+    EXPECT_EQ(firstId, 1u);
+    EXPECT_EQ(modelId, 2u);
+    EXPECT_EQ(secondId, firstId);
+    EXPECT_EQ(missingId, (uint32) LC_STRING_ID_NONE);
+    EXPECT_EQ(lastId, 3002u);
+    EXPECT_EQ(LC_StringInterner_GetCount(&interner), 3002u);
+    EXPECT_STREQ(LC_StringInterner_GetString(&interner, firstId).data, "viewProjectionMatrix");
+    EXPECT_STREQ(LC_StringInterner_GetString(&interner, modelId).data, "model");
+    EXPECT_STREQ(LC_StringInterner_GetString(&interner, 1500).data, "asset_1497");
+
+    LC_StringInterner_Destroy(&interner);
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(DataStructures, LC_StringInterner_ThreadSafeModeAgreesAcrossThreads) {
+    // Arrange
+    LC_Arena arena;
+    LC_Arena_InitializeGrowable(&arena, LC_ArenaBacking_Malloc(), 64 * 1024);
+    LC_StringInterner interner;
+    ASSERT_TRUE(LC_StringInterner_Initialize(&interner, &arena, true));
+    constexpr int32 threadCount = 4;
+    constexpr int32 nameCount = 500;
+    uint32 ids[threadCount][nameCount];
+
+    // Act
+    std::vector<std::thread> threads;
+    for (int32 t = 0; t < threadCount; t++) {
+        threads.emplace_back([&interner, &ids, t]() {
+            // every thread walks the names in a different order, the strides are coprime to the name count
+            constexpr int32 strides[threadCount] = {1, 3, 7, 9};
+            for (int32 i = 0; i < nameCount; i++) {
+                const int32 n = (i * strides[t]) % nameCount;
+                char name[32];
+                snprintf(name, sizeof(name), "texture_%d", n);
+                ids[t][n] = LC_StringInterner_InternCString(&interner, name);
+            }
+        });
+    }
+    for (std::thread &thread : threads) thread.join();
+
+    // Assert
+    EXPECT_EQ(LC_StringInterner_GetCount(&interner), (uint32) nameCount);
+    for (int32 n = 0; n < nameCount; n++) {
+        char name[32];
+        snprintf(name, sizeof(name), "texture_%d", n);
+        EXPECT_STREQ(LC_StringInterner_GetString(&interner, ids[0][n]).data, name);
+        for (int32 t = 1; t < threadCount; t++) EXPECT_EQ(ids[t][n], ids[0][n]);
+    }
+
+    LC_StringInterner_Destroy(&interner);
+    LC_Arena_Destroy(&arena);
+}
+
+TEST(DataStructures, LC_SpscRing_WrapsAroundAndKeepsOrder) {
+    // Arrange
+    uchar buffer[64 * 1024];
+    LC_Arena arena;
+    LC_Arena_Initialize(&arena, buffer, sizeof(buffer));
+    LC_SpscRing ring;
+    ASSERT_TRUE(LC_SpscRing_Initialize(&ring, &arena, 5, sizeof(uint64)));
+    const uint64 values[6] = {1, 2, 3, 4, 5, 6};
+    uint64 popped[11] = {};
+
+    // Act
+    const uint32 pushedFirst = LC_SpscRing_PushBatch(&ring, values, 6);
+    const uint32 poppedFirst = LC_SpscRing_PopBatch(&ring, popped, 3);
+    // The next batch wraps around the end of the buffer
+    const uint32 pushedSecond = LC_SpscRing_PushBatch(&ring, values, 6);
+    const uint32 countAfterSecond = LC_SpscRing_GetCount(&ring);
+    const uint32 poppedSecond = LC_SpscRing_PopBatch(&ring, popped + 3, 8);
+    uint64 single;
+    const bool poppedFromEmpty = LC_SpscRing_Pop(&ring, &single);
+
+    // Assert
+    EXPECT_EQ(pushedFirst, 6u);
+    EXPECT_EQ(poppedFirst, 3u);
+    EXPECT_EQ(pushedSecond, 5u);
+    EXPECT_EQ(countAfterSecond, 8u);
+    EXPECT_EQ(poppedSecond, 8u);
+    const uint64 expected[11] = {1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5};
+    for (uint32 i = 0; i < 11; i++) EXPECT_EQ(popped[i], expected[i]);
+    EXPECT_FALSE(poppedFromEmpty);
+
+    // Arrange
+    constexpr uint64 transferCount = 1000000;
+    LC_SpscRing transfer;
+    ASSERT_TRUE(LC_SpscRing_Initialize(&transfer, &arena, 1024, sizeof(uint64)));
+
+    // Act
+    std::thread producer([&transfer] {
+        uint64 batch[64];
+        for (uint64 next = 0; next < transferCount;) {
+            uint32 batchCount = 0;
+            while (batchCount < 64 && next + batchCount < transferCount) {
+                batch[batchCount] = next + batchCount;
+                batchCount++;
+            }
+            const uint32 pushedCount = LC_SpscRing_PushBatch(&transfer, batch, batchCount);
+            if (pushedCount == 0) std::this_thread::yield();
+            next += pushedCount;
+        }
+    });
+    bool isInOrder = true;
+    uint64 expectedNext = 0;
+    while (expectedNext < transferCount) {
+        uint64 value;
+        if (!LC_SpscRing_Pop(&transfer, &value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        isInOrder &= value == expectedNext;
+        expectedNext++;
+    }
+    producer.join();
+
+    // Assert
+    EXPECT_TRUE(isInOrder);
+}
+
+TEST(DataStructures, LC_MpmcQueue_DeliversEveryElementOnce) {
+    // Arrange
+    uchar buffer[64 * 1024];
+    LC_Arena arena;
+    LC_Arena_Initialize(&arena, buffer, sizeof(buffer));
+    LC_MpmcQueue queue;
+    ASSERT_TRUE(LC_MpmcQueue_Initialize(&queue, &arena, 4, sizeof(uint32)));
+    const uint32 values[5] = {10, 20, 30, 40, 50};
+    uint32 popped[5] = {};
+
+    // Act
+    const uint32 pushedCount = LC_MpmcQueue_PushBatch(&queue, values, 5);
+    const bool pushedWhenFull = LC_MpmcQueue_Push(&queue, &values[4]);
+    const uint32 poppedCount = LC_MpmcQueue_PopBatch(&queue, popped, 5);
+    const bool poppedWhenEmpty = LC_MpmcQueue_Pop(&queue, &popped[4]);
+
+    // Assert
+    EXPECT_EQ(pushedCount, 4u);
+    EXPECT_FALSE(pushedWhenFull);
+    EXPECT_EQ(poppedCount, 4u);
+    EXPECT_FALSE(poppedWhenEmpty);
+    for (uint32 i = 0; i < 4; i++) EXPECT_EQ(popped[i], values[i]);
+
+    // Arrange
+    constexpr uint32 threadCount = 4;
+    constexpr uint32 perProducer = 100000;
+    LC_MpmcQueue shared;
+    ASSERT_TRUE(LC_MpmcQueue_Initialize(&shared, &arena, 256, sizeof(uint32)));
+    std::vector<std::atomic<uint32>> receivedCounts(threadCount * perProducer);
+    std::atomic<uint32> receivedTotal{0};
+
+    // Act
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < threadCount; t++) {
+        threads.emplace_back([&shared, t] {
+            // Half of the producers push in batches
+            uint32 batch[16];
+            for (uint32 next = 0; next < perProducer;) {
+                uint32 batchCount = t % 2 == 0 ? 1 : 16;
+                if (batchCount > perProducer - next) batchCount = perProducer - next;
+                for (uint32 i = 0; i < batchCount; i++) batch[i] = t * perProducer + next + i;
+                const uint32 pushedCount = LC_MpmcQueue_PushBatch(&shared, batch, batchCount);
+                if (pushedCount == 0) std::this_thread::yield();
+                next += pushedCount;
+            }
+        });
+        threads.emplace_back([&shared, &receivedCounts, &receivedTotal, t] {
+            uint32 batch[16];
+            while (receivedTotal.load() < threadCount * perProducer) {
+                const uint32 count = LC_MpmcQueue_PopBatch(&shared, batch, t % 2 == 0 ? 1 : 16);
+                if (count == 0) std::this_thread::yield();
+                for (uint32 i = 0; i < count; i++) receivedCounts[batch[i]]++;
+                receivedTotal += count;
+            }
+        });
+    }
+    for (std::thread &thread : threads) thread.join();
+
+    // Assert
+    EXPECT_EQ(receivedTotal.load(), threadCount * perProducer);
+    bool everyElementOnce = true;
+    for (const std::atomic<uint32> &count : receivedCounts) everyElementOnce &= count.load() == 1;
+    EXPECT_TRUE(everyElementOnce);
+}
+
+// =====================================Job System===================================================================
+TEST(JobSystem, LC_JobSystem_RunsJobsAndWaitsOnCounters) {
+    // Arrange
+    uchar buffer[512 * 1024];
+    LC_Arena arena;
+    LC_Arena_Initialize(&arena, buffer, sizeof(buffer));
+    LC_JobSystem system;
+    ASSERT_TRUE(LC_JobSystem_Initialize(&system, &arena, 3, false));
+    constexpr uint32 jobCount = 10000;
+    std::vector<LC_Job> jobs(jobCount);
+    std::atomic<uint32> runCount{0};
+    for (LC_Job &job : jobs) {
+        job.function = [](void *data) { ((std::atomic<uint32> *) data)->fetch_add(1); };
+        job.data = &runCount;
+    }
+    LC_JobCounter counter = {};
+
+    // Act
+    LC_JobSystem_Run(&system, jobs.data(), jobCount, &counter);
+    LC_JobSystem_Wait(&system, &counter);
+
+    // Assert
+    EXPECT_EQ(LC_JobSystem_GetThreadCount(&system), 4u);
+    EXPECT_EQ(LC_JobSystem_GetThreadIndex(), 0u);
+    EXPECT_TRUE(LC_JobCounter_IsDone(&counter));
+    EXPECT_EQ(runCount.load(), jobCount);
+
+    LC_JobSystem_Destroy(&system);
+    EXPECT_EQ(LC_JobSystem_GetThreadIndex(), (uint32) LC_JOB_THREAD_NONE);
+}
+
+struct JobTreeNode {
+    LC_JobSystem *system;
+    uint32 depth;
+    std::atomic<uint32> *leafCount;
+};
+
+// Every node below the leaves spawns two children and waits for them, which makes the waits nest across threads
+static void RunJobTreeNode(void *data) {
+    const JobTreeNode *node = (const JobTreeNode *) data;
+    if (node->depth == 0) {
+        node->leafCount->fetch_add(1);
+        return;
+    }
+    JobTreeNode children[2] = {{node->system, node->depth - 1, node->leafCount},
+                               {node->system, node->depth - 1, node->leafCount}};
+    LC_Job jobs[2] = {{RunJobTreeNode, &children[0], nullptr}, {RunJobTreeNode, &children[1], nullptr}};
+    LC_JobCounter counter = {};
+    LC_JobSystem_Run(node->system, jobs, 2, &counter);
+    LC_JobSystem_Wait(node->system, &counter);
+}
+
+TEST(JobSystem, LC_JobSystem_JobsCanWaitOnJobsTheySpawn) {
+    // Arrange
+    uchar buffer[512 * 1024];
+    LC_Arena arena;
+    LC_Arena_Initialize(&arena, buffer, sizeof(buffer));
+    LC_JobSystem system;
+    ASSERT_TRUE(LC_JobSystem_Initialize(&system, &arena, 0, true));
+    std::atomic<uint32> leafCount{0};
+    JobTreeNode root = {&system, 12, &leafCount};
+
+    // Act
+    RunJobTreeNode(&root);
+
+    // Assert
+    EXPECT_EQ(leafCount.load(), 1u << 12);
+
+    LC_JobSystem_Destroy(&system);
+}
+
+struct ParallelForSums {
+    std::vector<uint32> visits;
+    uint64 partialSums[64];
+};
+
+TEST(JobSystem, LC_JobSystem_ParallelForCoversEveryIndexOnce) {
+    // Arrange
+    uchar buffer[512 * 1024];
+    LC_Arena arena;
+    LC_Arena_Initialize(&arena, buffer, sizeof(buffer));
+    LC_JobSystem system;
+    ASSERT_TRUE(LC_JobSystem_Initialize(&system, &arena, 3, false));
+    constexpr uint32 count = 100003;
+    ParallelForSums sums = {std::vector<uint32>(count, 0), {}};
+    const LC_ParallelForFunction visit = [](void *userData, const uint32 begin, const uint32 end) {
+        ParallelForSums *result = (ParallelForSums *) userData;
+        // Every thread has its own scratch arenas
+        const TemporaryArenaMemory scratch = LC_Scratch_Begin(nullptr, 0);
+        uint32 *squares = (uint32 *) LC_Arena_Allocate(scratch.arena, (end - begin) * sizeof(uint32));
+        for (uint32 i = begin; i < end; i++) squares[i - begin] = i % 1000 * (i % 1000);
+        for (uint32 i = begin; i < end; i++) {
+            result->visits[i]++;
+            result->partialSums[LC_JobSystem_GetThreadIndex()] += squares[i - begin];
+        }
+        LC_Scratch_End(scratch);
+    };
+
+    // Act
+    LC_JobSystem_ParallelFor(&system, count, 0, visit, &sums);
+    LC_JobSystem_ParallelFor(&system, 0, 0, visit, &sums);
+
+    // Assert
+    uint64 expected = 0;
+    for (uint32 i = 0; i < count; i++) expected += i % 1000 * (i % 1000);
+    uint64 total = 0;
+    for (const uint64 partialSum : sums.partialSums) total += partialSum;
+    EXPECT_EQ(total, expected);
+    bool everyIndexOnce = true;
+    for (const uint32 visitCount : sums.visits) everyIndexOnce &= visitCount == 1;
+    EXPECT_TRUE(everyIndexOnce);
+
+    LC_JobSystem_Destroy(&system);
+}
+
+// =====================================Sorting Algorithms===========================================================
+
+TEST(Sorting, LC_QuickSortIntegers_MatchesStdSort) {
+    // Arrange
+    constexpr int32 length = 5000;
+    std::vector<std::vector<int32>> inputs(6, std::vector<int32>(length));
+    uint32 state = 12345;
+    for (int32 i = 0; i < length; i++) {
+        state = state * 1664525u + 1013904223u;
+        inputs[0][i] = (int32) state;               // random
+        inputs[1][i] = i;                           // sorted
+        inputs[2][i] = length - i;                  // reversed
+        inputs[3][i] = (int32) (state >> 28);       // few unique
+        inputs[4][i] = i % 2 == 0 ? i : length - i; // organ pipe
+        inputs[5][i] = i == length / 2 ? -1 : 7;    // one outlier
+    }
+
+    for (std::vector<int32> &input : inputs) {
+        std::vector<int32> expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        // Act
+        LC_QuickSortIntegers(input.data(), length);
+
+        // Assert
+        EXPECT_EQ(input, expected);
+    }
+}
+
+TEST(Sorting, LC_QuickSortIntegers_SmallAndDegenerateLengths) {
+    // Arrange
+    int32 single[] = {42};
+    int32 small[] = {3, -1, 2, 2, INT32_MIN, INT32_MAX, 0};
+    const int32 sortedSmall[] = {INT32_MIN, -1, 0, 2, 2, 3, INT32_MAX};
+
+    // Act
+    LC_QuickSortIntegers(nullptr, 0);
+    LC_QuickSortIntegers(single, 1);
+    LC_QuickSortIntegers(small, 7);
+
+    // Assert
+    EXPECT_EQ(single[0], 42);
+    for (int32 i = 0; i < 7; i++) EXPECT_EQ(small[i], sortedSmall[i]);
+}
+
+TEST(Sorting, LC_MergeSortIntegers_SortsLargeArraysWithoutOverflowingTheStack) {
+    // Arrange
+    constexpr uint32 length = 4 * 1024 * 1024 + 17;
+    std::vector<int32> array(length);
+    uint32 state = 777;
+    for (uint32 i = 0; i < length; i++) {
+        state = state * 1664525u + 1013904223u;
+        array[i] = (int32) state;
+    }
+    std::vector<int32> expected = array;
+    std::sort(expected.begin(), expected.end());
+
+    // Act
+    LC_MergeSortIntegers(array.data(), length);
+
+    // Assert
+    EXPECT_EQ(array, expected);
+}
+
+TEST(Sorting, LC_MergeSortIntegersWithBuffer_MatchesStdSort) {
+    // Arrange
+    constexpr uint32 length = 1000;
+    std::vector<std::vector<int32>> inputs(4, std::vector<int32>(length));
+    for (uint32 i = 0; i < length; i++) {
+        inputs[0][i] = (int32) (i * 7919 % 1009);          // shuffled
+        inputs[1][i] = (int32) i;                          // sorted
+        inputs[2][i] = (int32) (length - i);               // reversed
+        inputs[3][i] = (int32) (i / 100 % 2 == 0 ? i : 0); // sorted runs and duplicates
+    }
+    std::vector<int32> buffer(length);
+
+    for (std::vector<int32> &input : inputs) {
+        std::vector<int32> expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        // Act
+        LC_MergeSortIntegersWithBuffer(input.data(), length, buffer.data());
+
+        // Assert
+        EXPECT_EQ(input, expected);
+    }
+    int32 single = 5;
+    LC_MergeSortIntegersWithBuffer(&single, 1, buffer.data());
+    LC_MergeSortIntegers(nullptr, 0);
+    EXPECT_EQ(single, 5);
+}
+
+TEST(Sorting, LC_RadixSort_SortsEveryKeyTypeAndKeepsPayloadsStable) {
+    // Arrange
+    constexpr uint32 length = 20000;
+    std::vector<uint32> unsignedKeys(length);
+    std::vector<int32> signedKeys(length);
+    std::vector<float> floatKeys(length);
+    std::vector<uint64> wideKeys(length);
+    std::vector<uint32> values(length);
+    uint32 state = 99;
+    for (uint32 i = 0; i < length; i++) {
+        state = state * 1664525u + 1013904223u;
+        unsignedKeys[i] = state >> 22; // duplicates to check stability
+        signedKeys[i] = (int32) state;
+        floatKeys[i] = ((float) (int32) state) / 1000.0f;
+        wideKeys[i] = (uint64) state << 32 | (state >> 8);
+        values[i] = i;
+    }
+    std::vector<std::pair<uint32, uint32>> expectedPairs(length);
+    for (uint32 i = 0; i < length; i++) expectedPairs[i] = {unsignedKeys[i], i};
+    std::stable_sort(expectedPairs.begin(), expectedPairs.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    std::vector<int32> expectedSigned = signedKeys;
+    std::sort(expectedSigned.begin(), expectedSigned.end());
+    std::vector<float> expectedFloats = floatKeys;
+    std::sort(expectedFloats.begin(), expectedFloats.end());
+    std::vector<uint64> expectedWide = wideKeys;
+    std::sort(expectedWide.begin(), expectedWide.end());
+
+    // Act
+    LC_RadixSortU32(unsignedKeys.data(), values.data(), length);
+    LC_RadixSortI32(signedKeys.data(), nullptr, length);
+    LC_RadixSortF32(floatKeys.data(), nullptr, length);
+    LC_RadixSortU64(wideKeys.data(), nullptr, length);
+
+    // Assert
+    bool pairsMatch = true;
+    for (uint32 i = 0; i < length; i++) {
+        pairsMatch &= unsignedKeys[i] == expectedPairs[i].first && values[i] == expectedPairs[i].second;
+    }
+    EXPECT_TRUE(pairsMatch);
+    EXPECT_EQ(signedKeys, expectedSigned);
+    EXPECT_EQ(floatKeys, expectedFloats);
+    EXPECT_EQ(wideKeys, expectedWide);
+}
+
+TEST(Sorting, LC_RadixSortParallel_MatchesSerialSort) {
+    // Arrange
+    uchar buffer[512 * 1024];
+    LC_Arena arena;
+    LC_Arena_Initialize(&arena, buffer, sizeof(buffer));
+    LC_JobSystem system;
+    ASSERT_TRUE(LC_JobSystem_Initialize(&system, &arena, 3, false));
+    constexpr uint32 length = 100003;
+    std::vector<uint64> keys(length);
+    std::vector<float> floatKeys(length);
+    std::vector<uint32> values(length);
+    uint64 state = 5;
+    for (uint32 i = 0; i < length; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        keys[i] = state >> (i % 3 * 20); // some passes see mostly zero digits
+        floatKeys[i] = (float) (int64_t) state;
+        values[i] = i;
+    }
+    std::vector<uint64> serialKeys = keys;
+    std::vector<uint32> serialValues = values;
+    std::vector<float> expectedFloats = floatKeys;
+    std::sort(expectedFloats.begin(), expectedFloats.end());
+
+    // Act
+    LC_RadixSortU64(serialKeys.data(), serialValues.data(), length);
+    LC_RadixSortU64Parallel(&system, keys.data(), values.data(), length);
+    LC_RadixSortF32Parallel(&system, floatKeys.data(), nullptr, length);
+
+    // Assert
+    EXPECT_EQ(keys, serialKeys);
+    EXPECT_EQ(values, serialValues);
+    EXPECT_EQ(floatKeys, expectedFloats);
+
+    LC_JobSystem_Destroy(&system);
+}
+
+struct SortRecord {
+    float depth;
+    uint32 id;
+};
+
+LC_DEFINE_SORT(SortRecord, SortRecords, a->depth < b->depth || (a->depth == b->depth && a->id < b->id))
+LC_DEFINE_SORT(float, Floats, *a < *b)
+
+static bool operator<(const SortRecord &a, const SortRecord &b) {
+    return a.depth < b.depth || (a.depth == b.depth && a.id < b.id);
+}
+
+static bool operator==(const SortRecord &a, const SortRecord &b) {
+    return a.depth == b.depth && a.id == b.id;
+}
+
+TEST(Sorting, LC_DEFINE_SORT_SortsAndSearchesStructs) {
+    // Arrange
+    constexpr size_t length = 3000;
+    std::vector<SortRecord> records(length);
+    uint32 state = 31;
+    for (size_t i = 0; i < length; i++) {
+        state = state * 1664525u + 1013904223u;
+        records[i] = {(float) (state >> 24), (uint32) (length - i)};
+    }
+    std::vector<SortRecord> expected = records;
+    std::sort(expected.begin(), expected.end());
+    const SortRecord present = expected[1234];
+    const SortRecord absent = {1000.0f, 0};
+
+    // Act
+    SortRecords_Sort(records.data(), length);
+
+    // Assert
+    EXPECT_EQ(records, expected);
+    EXPECT_EQ(SortRecords_BinarySearch(records.data(), length, &present), 1234u);
+    EXPECT_EQ(SortRecords_BinarySearch(records.data(), length, &absent), LC_NOT_FOUND);
+    EXPECT_EQ(SortRecords_LowerBound(records.data(), length, &absent), length);
+    EXPECT_EQ(SortRecords_UpperBound(records.data(), length, &present), 1235u);
+    EXPECT_EQ(SortRecords_LowerBound(records.data(), length, &expected[0]), 0u);
+}
+
+TEST(Sorting, LC_DEFINE_SORT_PartialSortAndNthElement) {
+    // Arrange
+    constexpr size_t length = 5000;
+    std::vector<float> values(length);
+    uint32 state = 8;
+    for (size_t i = 0; i < length; i++) {
+        state = state * 1664525u + 1013904223u;
+        values[i] = (float) (state >> 20) - 2000.0f;
+    }
+    std::vector<float> expected = values;
+    std::sort(expected.begin(), expected.end());
+    std::vector<float> partial = values;
+    std::vector<float> nth = values;
+    std::vector<float> duplicates(length, 1.0f);
+    std::vector<float> few = {3.0f, 1.0f, 2.0f};
+
+    // Act
+    Floats_PartialSort(partial.data(), length, 100);
+    Floats_NthElement(nth.data(), length, 2500);
+    Floats_NthElement(duplicates.data(), length, 4000);
+    Floats_NthElement(few.data(), 3, 1);
+    Floats_Sort(values.data(), length);
+
+    // Assert
+    EXPECT_TRUE(std::equal(partial.begin(), partial.begin() + 100, expected.begin()));
+    EXPECT_EQ(nth[2500], expected[2500]);
+    bool isPartitioned = true;
+    for (size_t i = 0; i < 2500; i++) isPartitioned &= nth[i] <= nth[2500];
+    for (size_t i = 2501; i < length; i++) isPartitioned &= nth[i] >= nth[2500];
+    EXPECT_TRUE(isPartitioned);
+    EXPECT_EQ(duplicates[4000], 1.0f);
+    EXPECT_EQ(few[1], 2.0f);
+    EXPECT_EQ(values, expected);
+}
+
+// =====================================Video========================================================================
+
+// Stand ins for the GL calls of a stream buffer, so it runs without a context
+static std::vector<uchar> streamBufferStorage;
+static int32 streamBufferFenceCount;
+static int32 streamBufferOrphanCount;
+static GLsizeiptr streamBufferSmallestMap;
+
+static GLenum StreamBufferStub_GetError() { return GL_NO_ERROR; }
+static void StreamBufferStub_GenBuffers(GLsizei n, GLuint *buffers) { for (GLsizei i = 0; i < n; i++) buffers[i] = 1; }
+static void StreamBufferStub_BindBuffer(GLenum, GLuint) {}
+static void StreamBufferStub_DeleteBuffers(GLsizei, const GLuint *) {}
+static void StreamBufferStub_BufferStorage(GLenum, GLsizeiptr size, const void *, GLbitfield) {
+    streamBufferStorage.assign(size, 0);
+}
+static void StreamBufferStub_BufferData(GLenum, GLsizeiptr size, const void *, GLenum) {
+    streamBufferStorage.assign(size, 0);
+    streamBufferOrphanCount++;
+}
+static void *StreamBufferStub_MapBufferRange(GLenum, GLintptr offset, GLsizeiptr length, GLbitfield) {
+    if (length < streamBufferSmallestMap) streamBufferSmallestMap = length;
+    return streamBufferStorage.data() + offset;
+}
+static void StreamBufferStub_FlushMappedBufferRange(GLenum, GLintptr, GLsizeiptr) {}
+static GLboolean StreamBufferStub_UnmapBuffer(GLenum) { return GL_TRUE; }
+static GLsync StreamBufferStub_FenceSync(GLenum, GLbitfield) {
+    streamBufferFenceCount++;
+    return (GLsync) &streamBufferFenceCount;
+}
+static GLenum StreamBufferStub_ClientWaitSync(GLsync, GLbitfield, GLuint64) { return GL_ALREADY_SIGNALED; }
+static void StreamBufferStub_DeleteSync(GLsync) { streamBufferFenceCount--; }
+
+static void StreamBufferStub_Install() {
+    glad_glGetError = StreamBufferStub_GetError;
+    glad_glGenBuffers = StreamBufferStub_GenBuffers;
+    glad_glBindBuffer = StreamBufferStub_BindBuffer;
+    glad_glDeleteBuffers = StreamBufferStub_DeleteBuffers;
+    glad_glBufferStorage = StreamBufferStub_BufferStorage;
+    glad_glBufferData = StreamBufferStub_BufferData;
+    glad_glMapBufferRange = StreamBufferStub_MapBufferRange;
+    glad_glFlushMappedBufferRange = StreamBufferStub_FlushMappedBufferRange;
+    glad_glUnmapBuffer = StreamBufferStub_UnmapBuffer;
+    glad_glFenceSync = StreamBufferStub_FenceSync;
+    glad_glClientWaitSync = StreamBufferStub_ClientWaitSync;
+    glad_glDeleteSync = StreamBufferStub_DeleteSync;
+    streamBufferFenceCount = 0;
+    streamBufferOrphanCount = 0;
+    streamBufferSmallestMap = PTRDIFF_MAX;
+}
+
+TEST(Video, LC_GL_StreamBuffer_MapKeepsOffsetsOnTheVertexStride) {
+    // Arrange
+    StreamBufferStub_Install();
+
+    // Text vertices are 9 floats, which doesn't divide the 64 KB segments of the text stream
+    constexpr GLsizeiptr segmentSize = 64 * 1024;
+    constexpr GLsizeiptr vertexStride = 9 * sizeof(float);
+    constexpr GLsizeiptr textSize = 80 * vertexStride;
+    LC_GL_StreamBuffer stream;
+    LC_GL_StreamBuffer_Initialize(&stream, segmentSize, true);
+
+    // Act
+    bool isOnStride = true;
+    bool isInOneSegment = true;
+    bool isWhereItWasWritten = true;
+    uint32 segmentsCrossed = 0;
+    uint32 previousSegment = 0;
+    for (uint32 text = 0; text < 200; text++) {
+        GLintptr offset;
+        GLsizeiptr size;
+        auto *vertices = (float *) LC_GL_StreamBuffer_Map(&stream, textSize, textSize, vertexStride, &offset, &size);
+        vertices[0] = (float) text;
+        LC_GL_StreamBuffer_Unmap(&stream, size);
+
+        // Drawing starts at the vertex the offset is divided into
+        const GLintptr firstVertex = offset / vertexStride;
+        isOnStride &= offset % vertexStride == 0;
+        isInOneSegment &= offset / segmentSize == (offset + size - 1) / segmentSize;
+        float firstValue;
+        memcpy(&firstValue, streamBufferStorage.data() + firstVertex * vertexStride, sizeof(float));
+        isWhereItWasWritten &= firstValue == (float) text;
+        if (stream.segment != previousSegment) segmentsCrossed++;
+        previousSegment = stream.segment;
+    }
+    LC_GL_StreamBuffer_Destroy(&stream);
+
+    // Assert
+    EXPECT_GE(segmentsCrossed, 3u);
+    EXPECT_TRUE(isOnStride);
+    EXPECT_TRUE(isInOneSegment);
+    EXPECT_TRUE(isWhereItWasWritten);
+    EXPECT_EQ(streamBufferFenceCount, 0);
+}
+
+TEST(Video, LC_GL_StreamBuffer_OrphansWhenTheBufferIsFull) {
+    // Arrange
+    StreamBufferStub_Install();
+    constexpr GLsizeiptr segmentSize = 1024;
+    constexpr GLsizeiptr vertexStride = 32;
+    LC_GL_StreamBuffer stream;
+    LC_GL_StreamBuffer_Initialize(&stream, segmentSize, false);
+    const int32 orphanCountAfterInitialize = streamBufferOrphanCount;
+
+    // Act
+    // Half segments fill the buffer exactly, so a map starts right at its end
+    constexpr GLsizeiptr rangeSize = segmentSize / 2;
+    constexpr uint32 rangesPerBuffer = 2 * LC_GL_STREAM_BUFFER_SEGMENTS;
+    std::vector<GLintptr> offsets;
+    for (uint32 range = 0; range < 2 * rangesPerBuffer; range++) {
+        GLintptr offset;
+        GLsizeiptr size;
+        LC_GL_StreamBuffer_Map(&stream, rangeSize, rangeSize, vertexStride, &offset, &size);
+        LC_GL_StreamBuffer_Unmap(&stream, size);
+        offsets.push_back(offset);
+    }
+    LC_GL_StreamBuffer_Destroy(&stream);
+
+    // Assert
+    EXPECT_EQ(streamBufferOrphanCount - orphanCountAfterInitialize, 1);
+    EXPECT_EQ(streamBufferSmallestMap, rangeSize);
+    EXPECT_EQ(offsets[rangesPerBuffer - 1], (GLintptr) ((rangesPerBuffer - 1) * rangeSize));
+    EXPECT_EQ(offsets[rangesPerBuffer], 0);
+}